@@ -29,6 +29,7 @@
 # lin_transpose -- the transpose of this map, T^*, compared to the formula <Td,r> = <d,T^*r>
 # j_design -- the derivative of the SSA residual with respect to the design variable, compared to finite difference approx
 # J_design_transpose -- the transpose of this map, J^*, compared to the formula <Jd,r> = <d,J^*r>
+# lin_block -- the block (multiple right-hand side) linearization and its transpose, compared to single solves
 
 import sys
 import petsc4py
@@ -415,6 +416,81 @@ def test_linearization_transpose(ssarun):
             PISM.logging.pause()
 
 
+def test_lin_block(ssarun):
+    """Compares the block (multiple right-hand side) versions of
+    apply_linearization() and apply_linearization_transpose() to
+    single solves. Exits with a non-zero status if they differ."""
+    grid = ssarun.grid
+    ssa = ssarun.ssa
+
+    PISM.verbPrintf(1, grid.com, "\nTest block linearization (comparison with single solves):\n")
+
+    ssa.linearize_at(zeta1)
+
+    N = 3
+    tolerance = 1e-12
+    norm = PETSc.NormType.NORM_INFINITY
+
+    def relative_difference(a, b):
+        if isinstance(a, PISM.IceModelVec2S):
+            diff = PISM.IceModelVec2S()
+        else:
+            diff = PISM.IceModelVec2V()
+        diff.create(grid, "", PISM.WITHOUT_GHOSTS)
+        diff.copy_from(a)
+        diff.add(-1, b)
+        return diff.norm(norm) / max(b.norm(norm), 1e-300)
+
+    def new_vec(kind):
+        v = kind()
+        v.create(grid, "", PISM.WITH_GHOSTS)
+        return v
+
+    failed = False
+
+    # linearization
+    dzeta = [PISM.vec.randVectorS(grid, 1.0, WIDE_STENCIL) for k in range(N)]
+    du_block = [new_vec(PISM.IceModelVec2V) for k in range(N)]
+
+    dzeta_ptrs = PISM.IceModelVec2SPtrVector()
+    du_ptrs = PISM.IceModelVec2VPtrVector()
+    for k in range(N):
+        dzeta_ptrs.push_back(dzeta[k])
+        du_ptrs.push_back(du_block[k])
+
+    ssa.apply_linearization(dzeta_ptrs, du_ptrs)
+
+    du = new_vec(PISM.IceModelVec2V)
+    for k in range(N):
+        ssa.apply_linearization(dzeta[k], du)
+        delta = relative_difference(du_block[k], du)
+        PISM.verbPrintf(1, grid.com, "  T d[%d]: relative difference %g\n" % (k, delta))
+        failed = failed or not (delta <= tolerance)
+
+    # transpose of the linearization
+    r = [PISM.vec.randVectorV(grid, 1.0, WIDE_STENCIL) for k in range(N)]
+    dzeta_block = [new_vec(PISM.IceModelVec2S) for k in range(N)]
+
+    r_ptrs = PISM.IceModelVec2VPtrVector()
+    dzeta_block_ptrs = PISM.IceModelVec2SPtrVector()
+    for k in range(N):
+        r_ptrs.push_back(r[k])
+        dzeta_block_ptrs.push_back(dzeta_block[k])
+
+    ssa.apply_linearization_transpose(r_ptrs, dzeta_block_ptrs)
+
+    TStarR = new_vec(PISM.IceModelVec2S)
+    for k in range(N):
+        ssa.apply_linearization_transpose(r[k], TStarR)
+        delta = relative_difference(dzeta_block[k], TStarR)
+        PISM.verbPrintf(1, grid.com, "  T^* r[%d]: relative difference %g\n" % (k, delta))
+        failed = failed or not (delta <= tolerance)
+
+    if failed:
+        PISM.verbPrintf(1, grid.com, "Block and single solves differ.\n")
+        exit(1)
+
+
 # Main code starts here
 if __name__ == "__main__":
     context = PISM.Context()
@@ -489,7 +565,7 @@ if __name__ == "__main__":
 
     ssarun.ssa.linearize_at(zeta1)
 
-    test_type = PISM.optionsList("-inv_test", "", ["j_design", "j_design_transpose", "lin", "lin_transpose"], "")
+    test_type = PISM.optionsList("-inv_test", "", ["j_design", "j_design_transpose", "lin", "lin_transpose", "lin_block"], "")
 
     if test_type == "":
         PISM.verbPrintf(1, com, "Must specify a test type via -inv_test\n")
@@ -503,3 +579,5 @@ if __name__ == "__main__":
         test_lin(ssarun)
     elif test_type == "lin_transpose":
         test_linearization_transpose(ssarun)
+    elif test_type == "lin_block":
+        test_lin_block(ssarun)
@@ -155,6 +155,87 @@ class ToProcZero(object):
         return rv
 
 
+    def distribute(self, array, u):
+        """Distributes an array from processor zero to an :cpp:class:`IceModelVec`.
+
+        This is the inverse of :meth:`communicate`.
+
+        :param array: On processor 0, a numpy array with the same shape as the one
+                      returned by :meth:`communicate`. Ignored on other processors.
+        :param u: the :cpp:class:`IceModelVec` to set"""
+        comm = self.da.get().getComm()
+        rank = comm.getRank()
+
+        if rank == 0:
+            self.U0[...] = array.reshape(-1, order='f')
+
+        self.scatter.scatter(self.U0, self.tmp_U_natural, False, PISM.PETSc.Scatter.Mode.REVERSE)
+        self.da.get().naturalToGlobal(self.tmp_U_natural, self.tmp_U)
+        u.copy_from_vec(self.tmp_U)
+
+
+def local_array(vec, ghosts=False):
+    """Returns a numpy array *sharing storage* with the local part of an :cpp:class:`IceModelVec`.
+
+    The array has the shape ``(xm, ym)`` for scalar 2D fields and ``(xm, ym, N)``
+    for fields with ``N`` components (e.g. :cpp:class:`IceModelVec2V`) or ``N``
+    levels (:cpp:class:`IceModelVec3`), so ``array[i - xs, j - ys]`` corresponds to
+    the grid point ``(i, j)``. No data is copied, so operations on the array run at
+    native speed.
+
+    :param vec:    the :cpp:class:`IceModelVec` to view
+    :param ghosts: include ghost points; if ``True``, the first index of the array
+                   corresponds to ``xs - stencil_width`` (and similarly for ``y``)
+
+    The view stays valid as long as `vec` exists. After modifying `vec` through it,
+    call :cpp:member:`IceModelVec::inc_state_counter` and (for ghosted vectors)
+    :cpp:member:`IceModelVec::update_ghosts` (see :class:`LocalArray`).
+    """
+    grid = vec.get_grid()
+    width = vec.get_stencil_width()
+    block = max(vec.get_ndof(), len(vec.get_levels()))
+
+    # Local storage of ghosted vectors includes ghosts; PISM's DMDAs are
+    # "transposed", so the y index varies faster than the x index.
+    shape = (grid.xm() + 2 * width, grid.ym() + 2 * width)
+    if block > 1:
+        shape += (block,)
+
+    array = vec.get_vec().getArray().reshape(shape)
+
+    if ghosts or width == 0:
+        return array
+
+    return array[width:-width, width:-width, ...]
+
+
+class LocalArray(object):
+
+    """Context manager providing a numpy view of an :cpp:class:`IceModelVec`
+    (see :func:`local_array`) and marking the vector as modified on exit::
+
+      with PISM.vec.LocalArray(thickness) as H:
+        H[H < 1.0] = 0.0
+
+    Unless `readonly` is ``True``, ghosts are updated and
+    :cpp:member:`IceModelVec::inc_state_counter` is called on exit."""
+
+    def __init__(self, vec, ghosts=False, readonly=False):
+        self.vec = vec
+        self.ghosts = ghosts
+        self.readonly = readonly
+
+    def __enter__(self):
+        return local_array(self.vec, self.ghosts)
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        if self.readonly or exc_type is not None:
+            return
+
+        self.vec.update_ghosts()
+        self.vec.inc_state_counter()
+
+
 def randVectorS(grid, scale, stencil_width=None):
     """Create an :cpp:class:`IceModelVec2S` of normally distributed random entries.
 
@@ -163,7 +244,6 @@ def randVectorS(grid, scale, stencil_width=None):
       :param stencil_width: Ghost stencil width for the vector. Use ``None`` to indicate
                             an unghosted vector.
 
-    This function is not efficiently implemented.
     """
     rv = PISM.IceModelVec2S()
     if stencil_width is None:
@@ -174,11 +254,8 @@ def randVectorS(grid, scale, stencil_width=None):
     import numpy as np
 
     r = np.random.normal(scale=scale, size=shape)
-    with Access(nocomm=rv):
-        for (i, j) in grid.points():
-            rv[i, j] = r[i - grid.xs(), j - grid.ys()]
-    if stencil_width is not None:
-        rv.update_ghosts()
+    with LocalArray(rv) as a:
+        a[...] = r
     return rv
 
 
@@ -190,7 +267,6 @@ def randVectorV(grid, scale, stencil_width=None):
       :param stencil_width: Ghost stencil width for the vector. Use ``None`` to indicate
                             an unghosted vector.
 
-    This function is not efficiently implemented.
     """
 
     rv = PISM.IceModelVec2V()
@@ -203,10 +279,7 @@ def randVectorV(grid, scale, stencil_width=None):
     import numpy as np
     r_u = np.random.normal(scale=scale, size=shape)
     r_v = np.random.normal(scale=scale, size=shape)
-    with Access(nocomm=rv):
-        for (i, j) in grid.points():
-            rv[i, j].u = r_u[i - grid.xs(), j - grid.ys()]
-            rv[i, j].v = r_v[i - grid.xs(), j - grid.ys()]
-        if stencil_width is not None:
-            rv.update_ghosts()
+    with LocalArray(rv) as a:
+        a[..., 0] = r_u
+        a[..., 1] = r_v
     return rv
@@ -55,6 +55,7 @@ TridiagonalSystem::TridiagonalSystem(unsigned int max_size,
   m_U.resize(m_max_system_size);
   m_rhs.resize(m_max_system_size);
   m_work.resize(m_max_system_size);
+  m_pivot.resize(m_max_system_size);
 }
 
 //! Zero all entries.
@@ -65,6 +66,7 @@ void TridiagonalSystem::reset() {
   memset(&m_D[0],    0, (m_max_system_size)*sizeof(double));
   memset(&m_rhs[0],  0, (m_max_system_size)*sizeof(double));
   memset(&m_work[0], 0, (m_max_system_size)*sizeof(double));
+  memset(&m_pivot[0], 0, (m_max_system_size)*sizeof(double));
 #endif
 }
 
@@ -276,6 +278,50 @@ void TridiagonalSystem::solve(unsigned int system_size, std::vector<double> &res
   }
 }
 
+//! Factor the system, saving the result for solve_factored().
+/*!
+Performs the elimination part of solve(). Useful when the same matrix
+is used with many right-hand sides, e.g. in every column of a grid.
+ */
+void TridiagonalSystem::factor(unsigned int system_size) {
+  assert(system_size >= 1);
+  assert(system_size <= m_max_system_size);
+
+  if (m_D[0] == 0.0) {
+    throw RuntimeError("zero pivot at row 1");
+  }
+
+  double b = m_D[0];
+
+  m_pivot[0] = 1.0 / b;
+  for (unsigned int k = 1; k < system_size; ++k) {
+    m_work[k] = m_U[k - 1] / b;
+
+    b = m_D[k] - m_L[k] * m_work[k];
+
+    if (b == 0.0) {
+      throw RuntimeError::formatted("zero pivot at row %d", k + 1);
+    }
+
+    m_pivot[k] = 1.0 / b;
+  }
+}
+
+//! Solve the system factored by factor(), overwriting the right-hand side `x` with the solution.
+void TridiagonalSystem::solve_factored(unsigned int system_size, double *x) const {
+  assert(system_size >= 1);
+  assert(system_size <= m_max_system_size);
+
+  x[0] *= m_pivot[0];
+  for (unsigned int k = 1; k < system_size; ++k) {
+    x[k] = (x[k] - m_L[k] * x[k-1]) * m_pivot[k];
+  }
+
+  for (int k = system_size - 2; k >= 0; --k) {
+    x[k] -= m_work[k + 1] * x[k + 1];
+  }
+}
+
 std::string TridiagonalSystem::prefix() const {
   return m_prefix;
 }
@@ -90,6 +90,11 @@ public:
   // copying
   void solve(unsigned int system_size, std::vector<double> &result);
 
+  // factor once, then solve for several right-hand sides (the RHS is
+  // not used; the matrix is not modified)
+  void factor(unsigned int system_size);
+  void solve_factored(unsigned int system_size, double *x) const;
+
   void save_system_with_solution(const std::string &filename,
                                  unsigned int system_size,
                                  const std::vector<double> &solution);
@@ -125,6 +130,7 @@ public:
 private:
   unsigned int m_max_system_size;         // maximum system size
   std::vector<double> m_L, m_D, m_U, m_rhs, m_work; // vectors for tridiagonal system
+  std::vector<double> m_pivot;                      // inverse pivots computed by factor()
 
   std::string m_prefix;
 };
@@ -26,7 +26,9 @@
 #include <cassert>
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/error_handling.hh"
+#include "base/util/pism_threads.hh"
 #include "base/util/MaxTimestep.hh"
+#include "base/columnSystem.hh"
 
 namespace pism {
 namespace energy {
@@ -225,38 +227,19 @@ void BedThermalUnit::write_variables_impl(const std::set<std::string> &vars, con
 }
 
 
-/*! Because the grid for the bedrock thermal layer is equally-spaced, and because
-the heat equation being solved in the bedrock is time-invariant (%e.g. no advection
-at evolving velocity and no time-dependence to physical constants), the explicit
-time-stepping can compute the maximum stable time step easily.  The basic scheme
-is
-        \f[T_k^{n+1} = T_k^n + R (T_{k-1}^n - 2 T_k^n + T_{k+1}^n)\f]
-where
-        \f[R = \frac{k \Delta t}{\rho c \Delta z^2} = \frac{D \Delta t}{\Delta z^2}.\f]
-The stability condition is that the coefficients of temperatures on the right are
-all nonnegative, equivalently \f$1-2R\ge 0\f$ or \f$R\le 1/2\f$ or
-        \f[\Delta t \le \frac{\Delta z^2}{2 D}.\f]
-This is a formula for the maximum stable timestep.  For more, see [\ref MortonMayers].
-
-The above describes the general case where Mbz > 1.
+/*! The bedrock heat equation is solved using an implicit scheme (see
+update_impl()), which is unconditionally stable, so the bedrock thermal
+layer does not restrict the time step.
  */
 MaxTimestep BedThermalUnit::max_timestep_impl(double t) {
   (void) t;
 
-  if (m_temp.was_created()) {
-    double dzb = this->vertical_spacing();
-    // max dt from stability; in seconds
-    return MaxTimestep(dzb * dzb / (2.0 * m_bed_D));
-  } else {
-    return MaxTimestep();
-  }
+  return MaxTimestep();
 }
 
 
 /** Perform a step of the bedrock thermal model.
 
-@todo The old scheme had better stability properties, as follows:
-
 Because there is no advection, the simplest centered implicit (backward Euler) scheme is easily "bombproof" without choosing \f$\lambda\f$, or other complications.  It has this scaled form,
 \anchor bedrockeqn
 \f[ -R_b T_{k-1}^{n+1} + \left(1 + 2 R_b\right) T_k^{n+1} - R_b T_{k+1}^{n+1}
@@ -265,6 +248,15 @@ where
   \f[ R_b = \frac{k_b \Delta t}{\rho_b c_b \Delta z^2}. \f]
 This is unconditionally stable for a pure bedrock problem, and has a maximum principle, without any further qualification [\ref MortonMayers].
 
+The temperature at the top of the column is set to `bedtoptemp` (a
+Dirichlet boundary condition). At the base of the column the
+geothermal flux is imposed using a "ghost" level below the base,
+  \f[ T_{-1} = T_1 + 2 \frac{G \Delta z}{k_b}. \f]
+
+The matrix of this system depends on \f$R_b\f$ only, so it is the same in all
+columns. It is factored once per time step and each column requires
+only a forward and a backward substitution.
+
 @todo Now a trapezoid rule could be used
 */
 void BedThermalUnit::update_impl(double my_t, double my_dt) {
@@ -324,28 +316,57 @@ void BedThermalUnit::update_impl(double my_t, double my_dt) {
 
   const double bed_R  = m_bed_D * my_dt / (dzb * dzb);
 
-  std::vector<double> Tbnew(m_Mbz);
+  // Unknowns are temperatures at levels 0, ..., k0 - 1; Tb[k0] is set
+  // by the Dirichlet boundary condition.
+  const unsigned int N = k0;
+
+  TridiagonalSystem system(N, "bedrock");
+  for (unsigned int k = 0; k < N; ++k) {
+    system.L(k) = - bed_R;
+    system.D(k) = 1.0 + 2.0 * bed_R;
+    system.U(k) = - bed_R;
+  }
+  // the "ghost" level below the base contributes to the first equation
+  system.U(0) = - 2.0 * bed_R;
+
+  system.factor(N);
 
   IceModelVec::AccessList list;
   list.add(m_temp);
   list.add(*ghf);
   list.add(*bedtoptemp);
 
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  const double U_last = system.U(N - 1);
+
+  // columns are independent and the factored system is not modified,
+  // so they can be processed by several threads
+  ParallelSection loop(m_grid->com);
+  PISM_OMP_PARALLEL
+  {
+    try {
+      for (ThreadPoints p(*m_grid); p; p.next()) {
+        const int i = p.i(), j = p.j();
 
-    double *Tbold = m_temp.get_column(i,j); // Tbold actually points into temp memory
-    Tbold[k0] = (*bedtoptemp)(i,j);  // sets Dirichlet explicit-in-time b.c. at top of bedrock column
+        // Tb points into temp memory; the solution overwrites the
+        // temperature at the beginning of the step
+        double *Tb = m_temp.get_column(i,j);
 
-    const double Tbold_negone = Tbold[1] + 2 * (*ghf)(i,j) * dzb / m_bed_k;
-    Tbnew[0] = Tbold[0] + bed_R * (Tbold_negone - 2 * Tbold[0] + Tbold[1]);
-    for (int k = 1; k < k0; k++) { // working upward from base
-      Tbnew[k] = Tbold[k] + bed_R * (Tbold[k-1] - 2 * Tbold[k] + Tbold[k+1]);
-    }
-    Tbnew[k0] = (*bedtoptemp)(i,j);
+        const double T_top = (*bedtoptemp)(i,j);
+
+        Tb[0]     += 2.0 * bed_R * (*ghf)(i,j) * dzb / m_bed_k;
+        Tb[N - 1] -= U_last * T_top;
 
-    m_temp.set_column(i,j,&Tbnew[0]); // copy from Tbnew into temp memory
+        system.solve_factored(N, Tb);
+
+        Tb[k0] = T_top;
+      }
+    } catch (...) {
+      loop.failed();
+    }
   }
+  loop.check();
+
+  m_temp.inc_state_counter();     // mark as modified
 }
 
 
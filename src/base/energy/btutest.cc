@@ -216,9 +216,14 @@ int main(int argc, char *argv[]) {
                "  reset to %.4f years to get integer number of steps ... \n",
                dt_years.value(), units::convert(ctx->unit_system(), dt_seconds, "seconds", "years"));
     MaxTimestep max_dt = btu.max_timestep(0.0);
-    verbPrintf(2,com,
-               "  BedThermalUnit reports max timestep of %.4f years ...\n",
-               units::convert(ctx->unit_system(), max_dt.value(), "seconds", "years"));
+    if (max_dt.is_finite()) {
+      verbPrintf(2,com,
+                 "  BedThermalUnit reports max timestep of %.4f years ...\n",
+                 units::convert(ctx->unit_system(), max_dt.value(), "seconds", "years"));
+    } else {
+      verbPrintf(2,com,
+                 "  BedThermalUnit does not restrict the time step ...\n");
+    }
 
     // actually do the time-stepping
     verbPrintf(2,com,"  running ...\n");
@@ -62,6 +62,8 @@ enthSystemCtx::enthSystemCtx(const std::vector<double>& storage_grid,
   size_t Mz = m_z.size();
   m_Enth.resize(Mz);
   m_Enth_s.resize(Mz);
+  m_depth.resize(Mz);
+  m_pressure.resize(Mz);
   m_strain_heating.resize(Mz);
   m_R.resize(Mz);
 
@@ -142,11 +144,10 @@ void enthSystemCtx::initThisColumn(int my_i, int my_j, bool my_ismarginal,
 void enthSystemCtx::compute_enthalpy_CTS() {
 
   for (unsigned int k = 0; k <= m_ks; k++) {
-    const double
-      depth = m_ice_thickness - k * m_dz,
-      p = m_EC->pressure(depth); // FIXME issue #15
-    m_Enth_s[k] = m_EC->enthalpy_cts(p);
+    m_depth[k] = m_ice_thickness - k * m_dz; // FIXME issue #15
   }
+  m_EC->pressure_n(&m_depth[0], &m_pressure[0], m_ks + 1);
+  m_EC->enthalpy_cts_n(&m_pressure[0], &m_Enth_s[0], m_ks + 1);
 
   const double Es_air = m_EC->enthalpy_cts(m_p_air);
   for (unsigned int k = m_ks+1; k < m_Enth_s.size(); k++) {
@@ -311,9 +312,7 @@ void enthSystemCtx::assemble_R() {
     for (unsigned int k = 1; k <= m_ks; k++) {
       if (m_Enth[k] < m_Enth_s[k]) {
         // cold case
-        const double depth = m_ice_thickness - k * m_dz;
-        double T = m_EC->temperature(m_Enth[k],
-                                   m_EC->pressure(depth)); // FIXME: issue #15
+        double T = m_EC->temperature(m_Enth[k], m_pressure[k]); // FIXME: issue #15
 
         m_R[k] = ((m_k_depends_on_T ? k_from_T(T) : m_ice_k) / m_EC->c(T)) * m_R_factor;
       } else {
@@ -323,8 +322,7 @@ void enthSystemCtx::assemble_R() {
     }
     // still the cold ice value, if no temperate layer above
     if (m_Enth[1] < m_Enth_s[1]) {
-      double T = m_EC->temperature(m_Enth[0],
-                                   m_EC->pressure(m_ice_thickness)); // FIXME: issue #15
+      double T = m_EC->temperature(m_Enth[0], m_pressure[0]); // FIXME: issue #15
       m_R[0] = ((m_k_depends_on_T ? k_from_T(T) : m_ice_k) / m_EC->c(T)) * m_R_factor;
     } else {
       // temperate layer case
@@ -80,6 +80,9 @@ protected:
   std::vector<double> m_Enth;
   // enthalpy level for CTS; function only of pressure
   std::vector<double> m_Enth_s;
+  // depth below the ice surface and the corresponding pressure at
+  // levels of the fine grid
+  std::vector<double> m_depth, m_pressure;
 
   // temporary storage for ice enthalpy at (i,j), as well as north,
   // east, south, and west from (i,j)
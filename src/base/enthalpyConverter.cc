@@ -82,21 +82,6 @@ double EnthalpyConverter::temperature(double E, double P) const {
 }
 
 
-//! Get pressure in ice from depth below surface using the hydrostatic assumption.
-/*! If \f$d\f$ is the depth then
-     \f[ p = p_{\text{air}}  + \rho_i g d. \f]
-Frequently \f$d\f$ is computed from the thickess minus a level in the ice,
-something like `ice_thickness(i, j) - z[k]`.  The input depth to this routine is allowed to
-be negative, representing a position above the surface of the ice.
- */
-double EnthalpyConverter::pressure(double depth) const {
-  if (depth > 0.0) {
-    return m_p_air + m_rho_i * m_g * depth;
-  } else {
-    return m_p_air; // at or above surface of ice
-  }
-}
-
 //! Specific heat capacity of ice as a function of temperature `T`.
 double EnthalpyConverter::c(double T) const {
   return this->c_impl(T);
@@ -319,6 +304,108 @@ double EnthalpyConverter::enthalpy_permissive_impl(double T, double omega, doubl
   }
 }
 
+//! Compute pressure at `n` depths using the hydrostatic assumption.
+/*! See pressure(). */
+void EnthalpyConverter::pressure_n(const double *depth, double *P, unsigned int n) const {
+  const double rho_g = m_rho_i * m_g;
+  for (unsigned int k = 0; k < n; ++k) {
+    P[k] = m_p_air + rho_g * std::max(depth[k], 0.0);
+  }
+}
+
+//! Compute temperatures of ice at `(E[k], P[k])`, `k = 0, ..., n-1`.
+/*! Equivalent to calling temperature() `n` times.
+ */
+void EnthalpyConverter::temperature_n(const double *E, const double *P, double *T,
+                                      unsigned int n) const {
+  this->temperature_n_impl(E, P, T, n);
+}
+
+//! Compute liquid water fractions at `(E[k], P[k])`, `k = 0, ..., n-1`.
+void EnthalpyConverter::water_fraction_n(const double *E, const double *P, double *omega,
+                                         unsigned int n) const {
+  this->water_fraction_n_impl(E, P, omega, n);
+}
+
+//! Compute CTS enthalpy values at pressures `P[k]`, `k = 0, ..., n-1`.
+void EnthalpyConverter::enthalpy_cts_n(const double *P, double *E_s, unsigned int n) const {
+  this->enthalpy_cts_n_impl(P, E_s, n);
+}
+
+//! Compute enthalpy (permissively, see enthalpy_permissive()) at `n` points.
+void EnthalpyConverter::enthalpy_permissive_n(const double *T, const double *omega,
+                                              const double *P, double *E,
+                                              unsigned int n) const {
+  this->enthalpy_permissive_n_impl(T, omega, P, E, n);
+}
+
+//! Throw RuntimeError if any of `(E[k], P[k])` corresponds to liquid water.
+void EnthalpyConverter::check_not_liquid_n(const double *E, const double *P,
+                                           unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    if (E[k] >= enthalpy_liquid(P[k])) {
+      throw RuntimeError::formatted("E=%f at P=%f equals or exceeds that of liquid water",
+                                    E[k], P[k]);
+    }
+  }
+}
+
+/*!
+  Note that @f$ E < E_s(p) @f$ is equivalent to @f$ c_i^{-1} E + T_0 <
+  T_m(p) @f$, so the temperature is the smaller of the two. This
+  avoids branching in the loop below.
+ */
+void EnthalpyConverter::temperature_n_impl(const double *E, const double *P, double *T,
+                                           unsigned int n) const {
+#if (PISM_DEBUG==1)
+  check_not_liquid_n(E, P, n);
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double T_m = m_T_melting - m_beta * P[k];
+    T[k] = std::min(E[k] / m_c_i + m_T_0, T_m);
+  }
+}
+
+void EnthalpyConverter::water_fraction_n_impl(const double *E, const double *P, double *omega,
+                                              unsigned int n) const {
+#if (PISM_DEBUG==1)
+  check_not_liquid_n(E, P, n);
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double E_s = m_c_i * (m_T_melting - m_beta * P[k] - m_T_0);
+    omega[k] = std::max(E[k] - E_s, 0.0) / m_L;
+  }
+}
+
+void EnthalpyConverter::enthalpy_cts_n_impl(const double *P, double *E_s,
+                                            unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    E_s[k] = m_c_i * (m_T_melting - m_beta * P[k] - m_T_0);
+  }
+}
+
+void EnthalpyConverter::enthalpy_permissive_n_impl(const double *T, const double *omega,
+                                                   const double *P, double *E,
+                                                   unsigned int n) const {
+#if (PISM_DEBUG==1)
+  for (unsigned int k = 0; k < n; ++k) {
+    if (T[k] <= 0.0) {
+      throw RuntimeError::formatted("T = %f <= 0 is not a valid absolute temperature", T[k]);
+    }
+  }
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double
+      T_m    = m_T_melting - m_beta * P[k],
+      E_cold = m_c_i * (T[k] - m_T_0),
+      E_temp = m_c_i * (T_m - m_T_0) + std::max(0.0, std::min(omega[k], 1.0)) * m_L;
+    E[k] = T[k] < T_m ? E_cold : E_temp;
+  }
+}
+
 ColdEnthalpyConverter::ColdEnthalpyConverter(const Config &config)
   : EnthalpyConverter(config) {
   m_do_cold_ice_methods = true;
@@ -356,6 +443,37 @@ double ColdEnthalpyConverter::temperature_impl(double E, double /*pressure*/) co
   return (E / m_c_i) + m_T_0;
 }
 
+void ColdEnthalpyConverter::temperature_n_impl(const double *E, const double */*P*/,
+                                               double *T, unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    T[k] = E[k] / m_c_i + m_T_0;
+  }
+}
+
+void ColdEnthalpyConverter::water_fraction_n_impl(const double */*E*/, const double */*P*/,
+                                                  double *omega, unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    omega[k] = 0.0;
+  }
+}
+
+void ColdEnthalpyConverter::enthalpy_cts_n_impl(const double */*P*/, double *E_s,
+                                                unsigned int n) const {
+  const double E_cts = m_c_i * (m_T_melting - m_T_0);
+  for (unsigned int k = 0; k < n; ++k) {
+    E_s[k] = E_cts;
+  }
+}
+
+void ColdEnthalpyConverter::enthalpy_permissive_n_impl(const double *T,
+                                                       const double */*omega*/,
+                                                       const double */*P*/,
+                                                       double *E, unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    E[k] = m_c_i * (T[k] - m_T_0);
+  }
+}
+
 /*! @class KirchhoffEnthalpyConverter
 
   Following a re-interpretation of [@ref
@@ -434,6 +552,42 @@ double KirchhoffEnthalpyConverter::L_impl(double T_pm) const {
   return m_L + (m_c_w - m_c_i) * (T_pm - 273.15);
 }
 
+void KirchhoffEnthalpyConverter::water_fraction_n_impl(const double *E, const double *P,
+                                                       double *omega, unsigned int n) const {
+#if (PISM_DEBUG==1)
+  check_not_liquid_n(E, P, n);
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double
+      T_m = m_T_melting - m_beta * P[k],
+      E_s = m_c_i * (T_m - m_T_0),
+      L   = m_L + (m_c_w - m_c_i) * (T_m - 273.15);
+    omega[k] = std::max(E[k] - E_s, 0.0) / L;
+  }
+}
+
+void KirchhoffEnthalpyConverter::enthalpy_permissive_n_impl(const double *T, const double *omega,
+                                                            const double *P, double *E,
+                                                            unsigned int n) const {
+#if (PISM_DEBUG==1)
+  for (unsigned int k = 0; k < n; ++k) {
+    if (T[k] <= 0.0) {
+      throw RuntimeError::formatted("T = %f <= 0 is not a valid absolute temperature", T[k]);
+    }
+  }
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double
+      T_m    = m_T_melting - m_beta * P[k],
+      L      = m_L + (m_c_w - m_c_i) * (T_m - 273.15),
+      E_cold = m_c_i * (T[k] - m_T_0),
+      E_temp = m_c_i * (T_m - m_T_0) + std::max(0.0, std::min(omega[k], 1.0)) * L;
+    E[k] = T[k] < T_m ? E_cold : E_temp;
+  }
+}
+
 EnthalpyConverter::Ptr enthalpy_converter_from_options(const Config &config) {
   EnthalpyConverter *EC = NULL;
 
@@ -19,6 +19,8 @@
 #ifndef __enthalpyConverter_hh
 #define __enthalpyConverter_hh
 
+#include <algorithm>            // std::max
+
 #include "base/util/pism_memory.hh"
 
 namespace pism {
@@ -73,7 +75,28 @@ public:
   //! pressure-melting temperature.
   double L(double T_m) const;
 
-  double pressure(double depth) const;
+  //! Get pressure in ice from depth below surface using the hydrostatic assumption.
+  /*! If \f$d\f$ is the depth then
+    \f[ p = p_{\text{air}}  + \rho_i g \max(d, 0). \f]
+    Frequently \f$d\f$ is computed from the thickess minus a level in the ice,
+    something like `ice_thickness(i, j) - z[k]`.  The input depth to this routine is allowed to
+    be negative, representing a position above the surface of the ice.
+
+    Defined here so that it can be inlined in loops over grid levels.
+  */
+  inline double pressure(double depth) const {
+    return m_p_air + m_rho_i * m_g * std::max(depth, 0.0);
+  }
+
+  // Column-batched versions of the methods above. Each one makes one
+  // virtual call per column (instead of one per vertical level) and
+  // processes n values at once.
+  void pressure_n(const double *depth, double *P, unsigned int n) const;
+  void temperature_n(const double *E, const double *P, double *T, unsigned int n) const;
+  void water_fraction_n(const double *E, const double *P, double *omega, unsigned int n) const;
+  void enthalpy_cts_n(const double *P, double *E_s, unsigned int n) const;
+  void enthalpy_permissive_n(const double *T, const double *omega, const double *P,
+                             double *E, unsigned int n) const;
 
 protected:
   virtual double enthalpy_permissive_impl(double T, double omega, double P) const;
@@ -88,6 +111,18 @@ protected:
 
   virtual bool is_temperate_impl(double E, double P) const;
 
+  // Derived classes overriding scalar *_impl methods have to override
+  // corresponding *_n_impl methods, too.
+  virtual void temperature_n_impl(const double *E, const double *P, double *T,
+                                  unsigned int n) const;
+  virtual void water_fraction_n_impl(const double *E, const double *P, double *omega,
+                                     unsigned int n) const;
+  virtual void enthalpy_cts_n_impl(const double *P, double *E_s, unsigned int n) const;
+  virtual void enthalpy_permissive_n_impl(const double *T, const double *omega, const double *P,
+                                          double *E, unsigned int n) const;
+
+  void check_not_liquid_n(const double *E, const double *P, unsigned int n) const;
+
   //! melting temperature of pure water at atmospheric pressure
   double m_T_melting;
   //! latent heat of fusion of water at atmospheric pressure
@@ -134,6 +169,13 @@ protected:
   double melting_temperature_impl(double P) const;
   bool is_temperate_impl(double E, double P) const;
   double temperature_impl(double E, double P) const;
+
+  void temperature_n_impl(const double *E, const double *P, double *T, unsigned int n) const;
+  void water_fraction_n_impl(const double *E, const double *P, double *omega,
+                             unsigned int n) const;
+  void enthalpy_cts_n_impl(const double *P, double *E_s, unsigned int n) const;
+  void enthalpy_permissive_n_impl(const double *T, const double *omega, const double *P,
+                                  double *E, unsigned int n) const;
 };
 
 //! @brief An enthalpy converter including pressure-dependence of the latent heat of fusion of
@@ -144,6 +186,11 @@ public:
   virtual ~KirchhoffEnthalpyConverter();
 protected:
   double L_impl(double T_m) const;
+
+  void water_fraction_n_impl(const double *E, const double *P, double *omega,
+                             unsigned int n) const;
+  void enthalpy_permissive_n_impl(const double *T, const double *omega, const double *P,
+                                  double *E, unsigned int n) const;
 private:
   //! specific heat capacity of pure water
   double m_c_w;
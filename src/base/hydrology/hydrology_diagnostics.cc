@@ -28,7 +28,7 @@ Hydrology_bwat::Hydrology_bwat(Hydrology *m)
   set_attrs("thickness of transportable water in subglacial layer", "", "m", "m", 0);
 }
 
-IceModelVec::Ptr Hydrology_bwat::compute() {
+IceModelVec::Ptr Hydrology_bwat::compute_impl() {
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "bwat", WITHOUT_GHOSTS);
   result->metadata() = m_vars[0];
@@ -44,7 +44,7 @@ Hydrology_bwp::Hydrology_bwp(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_bwp::compute() {
+IceModelVec::Ptr Hydrology_bwp::compute_impl() {
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "bwp", WITHOUT_GHOSTS);
   result->metadata() = m_vars[0];
@@ -63,7 +63,7 @@ Hydrology_bwprel::Hydrology_bwprel(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_bwprel::compute() {
+IceModelVec::Ptr Hydrology_bwprel::compute_impl() {
   double fill_value = m_grid->ctx()->config()->get_double("fill_value");
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
@@ -101,7 +101,7 @@ Hydrology_effbwp::Hydrology_effbwp(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_effbwp::compute() {
+IceModelVec::Ptr Hydrology_effbwp::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "effbwp", WITHOUT_GHOSTS);
@@ -126,7 +126,7 @@ Hydrology_hydrobmelt::Hydrology_hydrobmelt(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_hydrobmelt::compute() {
+IceModelVec::Ptr Hydrology_hydrobmelt::compute_impl() {
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "hydrobmelt", WITHOUT_GHOSTS);
   result->metadata(0) = m_vars[0];
@@ -147,7 +147,7 @@ Hydrology_hydroinput::Hydrology_hydroinput(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_hydroinput::compute() {
+IceModelVec::Ptr Hydrology_hydroinput::compute_impl() {
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "hydroinput", WITHOUT_GHOSTS);
   result->metadata() = m_vars[0];
@@ -168,7 +168,7 @@ Hydrology_wallmelt::Hydrology_wallmelt(Hydrology *m)
 }
 
 
-IceModelVec::Ptr Hydrology_wallmelt::compute() {
+IceModelVec::Ptr Hydrology_wallmelt::compute_impl() {
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "wallmelt", WITHOUT_GHOSTS);
   result->metadata() = m_vars[0];
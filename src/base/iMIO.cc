@@ -38,6 +38,7 @@
 #include "base/util/PISMTime.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/io/PIO.hh"
+#include "base/util/io/checkpoint.hh"
 #include "base/util/pism_options.hh"
 #include "coupler/PISMOcean.hh"
 #include "coupler/PISMSurface.hh"
@@ -132,6 +133,20 @@ void IceModel::dumpToFile(const std::string &filename) {
   profiling.end("model state dump");
 }
 
+//! Write `v` using glaciological units, leaving its `write_in_glaciological_units` flag unchanged.
+static void write_diagnostic(IceModelVec &v, const PIO &nc) {
+  const bool glaciological_units = v.write_in_glaciological_units;
+
+  v.write_in_glaciological_units = true;
+  try {
+    v.write(nc);
+  } catch (...) {
+    v.write_in_glaciological_units = glaciological_units;
+    throw;
+  }
+  v.write_in_glaciological_units = glaciological_units;
+}
+
 //! \brief Writes variables listed in vars to filename, using nctype to write
 //! fields stored in dedicated IceModelVecs.
 void IceModel::write_variables(const PIO &nc, const std::set<std::string> &vars_input,
@@ -139,6 +154,10 @@ void IceModel::write_variables(const PIO &nc, const std::set<std::string> &vars_
   std::set<std::string> vars = vars_input;
   const IceModelVec *v;
 
+  // The model state does not change while writing, so diagnostic
+  // quantities that depend on each other can share results.
+  DiagnosticCache::Scope diagnostic_cache(m_ctx->diagnostic_cache());
+
   // Define all the variables:
   {
     std::set<std::string>::iterator i;
@@ -291,8 +310,9 @@ void IceModel::write_variables(const PIO &nc, const std::set<std::string> &vars_
     } else {
       IceModelVec::Ptr v_diagnostic = diag->compute();
 
-      v_diagnostic->write_in_glaciological_units = true;
-      v_diagnostic->write(nc);
+      // v_diagnostic may be shared with other code (see DiagnosticCache),
+      // so its units flag is restored after writing
+      write_diagnostic(*v_diagnostic, nc);
 
       vars.erase(i++);
     }
@@ -494,6 +514,10 @@ void IceModel::regrid(int dimensions) {
 
 void IceModel::regrid_variables(const std::string &filename, const std::set<std::string> &vars, unsigned int ndims) {
 
+  // Use one file for all variables so that they can share the interpolation context.
+  PIO nc(m_grid->com, "guess_mode");
+  nc.open(filename, PISM_READONLY);
+
   std::set<std::string>::iterator i;
   for (i = vars.begin(); i != vars.end(); ++i) {
 
@@ -521,7 +545,13 @@ void IceModel::regrid_variables(const std::string &filename, const std::set<std:
       continue;
     }
 
-    v->regrid(filename, CRITICAL);
+    try {
+      v->regrid(nc, CRITICAL);
+    } catch (RuntimeError &e) {
+      e.add_context("regridding '%s' from '%s'",
+                    v->get_name().c_str(), filename.c_str());
+      throw;
+    }
 
     // Check if the current variable is the same as
     // IceModel::ice_thickess, then check the range of the ice
@@ -537,6 +567,8 @@ void IceModel::regrid_variables(const std::string &filename, const std::set<std:
     }
 
   }
+
+  nc.close();
 }
 
 /**
@@ -782,6 +814,82 @@ void IceModel::init_backups() {
   last_backup_time = 0.0;
 }
 
+//! Returns the prefix of a binary checkpoint corresponding to a NetCDF file name.
+std::string IceModel::checkpoint_prefix(const std::string &filename) {
+  std::string result = filename;
+  const std::string suffix = ".nc";
+  if (result.size() > suffix.size() and
+      result.compare(result.size() - suffix.size(), suffix.size(), suffix) == 0) {
+    result.resize(result.size() - suffix.size());
+  }
+  return result;
+}
+
+//! Returns model state fields saved in (and read from) binary checkpoints.
+/*!
+ * These are model state fields owned by IceModel, i.e. the ones
+ * initFromFile() reads. Sub-models (including the bed deformation
+ * model, which owns bed elevation and uplift) save their state in the
+ * NetCDF state file of a checkpoint and read it during initialization.
+ */
+std::vector<IceModelVec*> IceModel::checkpoint_fields() {
+  std::vector<IceModelVec*> result;
+
+  std::set<std::string> vars = m_grid->variables().keys();
+  std::set<std::string>::iterator i;
+  for (i = vars.begin(); i != vars.end(); ++i) {
+    IceModelVec *var = const_cast<IceModelVec*>(m_grid->variables().get(*i));
+
+    if (beddef != NULL and
+        (var == &beddef->bed_elevation() or var == &beddef->uplift())) {
+      continue;
+    }
+
+    if (var->metadata().get_string("pism_intent") == "model_state") {
+      result.push_back(var);
+    }
+  }
+
+  return result;
+}
+
+//! Initialize IceModel's model state from a binary checkpoint.
+/*!
+ * Replaces initFromFile() when restarting using `-checkpoint`. Fields
+ * that are not stored in binary files (mapping and climate_steady
+ * variables) are read from the state file of the checkpoint, which is
+ * used as the input file.
+ */
+void IceModel::init_from_checkpoint(const std::string &prefix) {
+  const std::string filename = io::checkpoint_state_file(prefix);
+
+  m_log->message(2, "initializing from the binary checkpoint '%s'...\n",
+                 prefix.c_str());
+
+  PIO nc(m_grid->com, "netcdf3");
+  nc.open(filename, PISM_READONLY);
+  unsigned int last_record = nc.inq_nrecords() - 1;
+  std::string history = nc.get_att_text("PISM_GLOBAL", "history");
+  nc.close();
+
+  std::set<std::string> vars = m_grid->variables().keys();
+  std::set<std::string>::iterator i;
+  for (i = vars.begin(); i != vars.end(); ++i) {
+    IceModelVec *var = const_cast<IceModelVec*>(m_grid->variables().get(*i));
+    std::string intent = var->metadata().get_string("pism_intent");
+
+    if (intent == "mapping" or intent == "climate_steady") {
+      var->read(filename, last_record);
+    }
+  }
+
+  // the model time is initialized using the state file (as with -i)
+  io::read_checkpoint(prefix, *m_grid, checkpoint_fields());
+
+  global_attributes.set_string("history",
+                               history + global_attributes.get_string("history"));
+}
+
   //! Write a backup (i.e. an intermediate result of a run).
 void IceModel::write_backup() {
   double wall_clock_hours = pism::wall_clock_hours(m_grid->com, start_time);
@@ -805,6 +913,35 @@ void IceModel::write_backup() {
 
   stampHistory(tmp);
 
+  if (m_config->get_string("backup_format") == "binary") {
+    const std::string prefix = checkpoint_prefix(backup_filename);
+    std::vector<IceModelVec*> fields = checkpoint_fields();
+    std::vector<const IceModelVec*> output(fields.begin(), fields.end());
+
+    // everything else goes to the NetCDF state file, which is used as
+    // the input file when restarting
+    std::set<std::string> vars = backup_vars;
+    for (unsigned int k = 0; k < fields.size(); ++k) {
+      vars.erase(fields[k]->get_name());
+    }
+
+    PIO nc(m_grid->com, "netcdf3");
+    nc.open(io::checkpoint_state_file(prefix), PISM_READWRITE_MOVE);
+    io::define_time(nc, m_config->get_string("time_dimension_name"),
+                    m_time->calendar(),
+                    m_time->CF_units_string(),
+                    m_sys);
+    io::append_time(nc, m_config->get_string("time_dimension_name"), m_time->current());
+    write_metadata(nc, true, true);
+    write_variables(nc, vars, PISM_DOUBLE);
+    nc.close();
+
+    io::write_checkpoint(prefix, *m_grid, m_time->current(), output);
+
+    flush_timeseries();
+    return;
+  }
+
   PIO nc(m_grid->com, m_config->get_string("output_format"));
 
   // write metadata:
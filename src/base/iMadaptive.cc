@@ -30,6 +30,7 @@
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/PISMTime.hh"
 #include "base/util/error_handling.hh"
+#include "base/util/pism_threads.hh"
 #include "coupler/PISMOcean.hh"
 #include "coupler/PISMSurface.hh"
 #include "base/util/MaxTimestep.hh"
@@ -60,35 +61,30 @@ double IceModel::max_timestep_cfl_3d() {
   list.add(u3);
   list.add(v3);
   list.add(w3);
-  list.add(vMask);
-
-  MaskQuery mask(vMask);
 
   // update global max of abs of velocities for CFL; only velocities under surface
   double max_u = 0.0, max_v = 0.0, max_w = 0.0;
   ParallelSection loop(m_grid->com);
   try {
-    for (Points p(*m_grid); p; p.next()) {
+    for (IcyPoints p(m_icy_columns); p; p.next()) {
       const int i = p.i(), j = p.j();
 
-      if (mask.icy(i, j)) {
-        const int ks = m_grid->kBelowHeight(ice_thickness(i, j));
+      const int ks = m_grid->kBelowHeight(ice_thickness(i, j));
+      const double
+        *u = u3.get_column(i, j),
+        *v = v3.get_column(i, j),
+        *w = w3.get_column(i, j);
+
+      for (int k = 0; k <= ks; ++k) {
         const double
-          *u = u3.get_column(i, j),
-          *v = v3.get_column(i, j),
-          *w = w3.get_column(i, j);
-
-        for (int k = 0; k <= ks; ++k) {
-          const double
-            absu = fabs(u[k]),
-            absv = fabs(v[k]);
-          max_u = std::max(max_u, absu);
-          max_v = std::max(max_v, absv);
-          max_w = std::max(max_w, fabs(w[k]));
-          const double denom = fabs(absu / m_grid->dx()) + fabs(absv / m_grid->dy());
-          if (denom > 0.0) {
-            max_dt = std::min(max_dt, 1.0 / denom);
-          }
+          absu = fabs(u[k]),
+          absv = fabs(v[k]);
+        max_u = std::max(max_u, absu);
+        max_v = std::max(max_v, absv);
+        max_w = std::max(max_w, fabs(w[k]));
+        const double denom = fabs(absu / m_grid->dx()) + fabs(absv / m_grid->dy());
+        if (denom > 0.0) {
+          max_dt = std::min(max_dt, 1.0 / denom);
         }
       }
     }
@@ -118,8 +114,6 @@ double IceModel::max_timestep_cfl_3d() {
 double IceModel::max_timestep_cfl_2d() {
   double max_dt = m_config->get_double("maximum_time_step_years", "seconds");
 
-  MaskQuery mask(vMask);
-
   const IceModelVec2V &vel = stress_balance->advective_velocity();
 
   const double
@@ -128,17 +122,31 @@ double IceModel::max_timestep_cfl_2d() {
 
   IceModelVec::AccessList list;
   list.add(vel);
-  list.add(vMask);
-  for (Points p(*m_grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
-
-    if (mask.icy(i, j)) {
-      const double denom = fabs(vel(i, j).u) / dx + fabs(vel(i, j).v) / dy;
-      if (denom > 0.0) {
-        max_dt = std::min(max_dt, 1.0 / denom);
+  RawArray2<Vector2> V(vel);
+  ParallelSection loop(m_grid->com);
+  PISM_OMP_PARALLEL
+  {
+    double my_max_dt = max_dt;
+    try {
+      for (ThreadIcyPoints p(m_icy_columns); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        const Vector2 &v = V(i, j);
+        const double denom = fabs(v.u) / dx + fabs(v.v) / dy;
+        if (denom > 0.0) {
+          my_max_dt = std::min(my_max_dt, 1.0 / denom);
+        }
       }
+    } catch (...) {
+      loop.failed();
+    }
+
+    PISM_OMP_CRITICAL
+    {
+      max_dt = std::min(max_dt, my_max_dt);
     }
   }
+  loop.check();
 
   return GlobalMin(m_grid->com, max_dt);
 }
@@ -170,6 +178,70 @@ double IceModel::max_timestep_diffusivity() {
   }
 }
 
+//! @brief Assign each grid cell to a rate class of the subcycled mass continuity step.
+/*!
+  A cell is in the class `k` if `2^k` sub-steps are needed to satisfy the
+  2D CFL condition (see max_timestep_cfl_2d()) in this cell during a time
+  step of length `time_step`. Ice-free cells and cells with zero velocity
+  are in the class 0. The class is capped at
+  `mass_continuity_subcycling_levels`.
+
+  Stores classes in m_rate_class (ghosts are updated), the largest class
+  in use in m_rate_class_max and the number of icy cells in each class in
+  m_rate_class_counts.
+ */
+void IceModel::mass_continuity_rate_classes(double time_step) {
+  const unsigned int max_level = m_subcycling_levels;
+
+  std::vector<double> local_counts(max_level + 1, 0.0);
+  m_rate_class_counts.resize(max_level + 1);
+
+  MaskQuery mask(vMask);
+
+  const IceModelVec2V &vel = stress_balance->advective_velocity();
+
+  const double
+    dx = m_grid->dx(),
+    dy = m_grid->dy();
+
+  IceModelVec::AccessList list;
+  list.add(vel);
+  list.add(vMask);
+  list.add(m_rate_class);
+
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    unsigned int rate_class = 0;
+
+    if (mask.icy(i, j)) {
+      // number of sub-steps needed in this cell, i.e. dt / dt_cfl
+      const double ratio = time_step * (fabs(vel(i, j).u) / dx + fabs(vel(i, j).v) / dy);
+
+      while (rate_class < max_level and ratio > (1 << rate_class)) {
+        rate_class += 1;
+      }
+
+      local_counts[rate_class] += 1.0;
+    }
+
+    m_rate_class(i, j) = rate_class;
+  }
+
+  m_rate_class.update_ghosts();
+
+  GlobalSum(m_grid->com, &local_counts[0], &m_rate_class_counts[0], max_level + 1);
+
+  m_rate_class_max = 0;
+  for (unsigned int k = 0; k <= max_level; ++k) {
+    if (m_rate_class_counts[k] > 0.0) {
+      m_rate_class_max = k;
+    }
+  }
+
+  m_rate_class_dt = time_step;
+}
+
 /** @brief Compute the skip counter using "long" (usually determined
  * using the CFL stability criterion) and "short" (typically
  * determined using the diffusivity-based stability criterion) time
@@ -301,7 +373,8 @@ void IceModel::max_timestep(double &dt_result, unsigned int &skip_counter_result
     if (m_config->get_boolean("do_mass_conserve")) {
       CFLmaxdt2D = max_timestep_cfl_2d();
 
-      dt_restrictions["2D CFL"] = CFLmaxdt2D;
+      // the subcycled advective step allows 2^N times longer steps
+      dt_restrictions["2D CFL"] = CFLmaxdt2D * (1 << m_subcycling_levels);
 
       double max_dt_diffusivity = max_timestep_diffusivity();
       dt_restrictions["diffusivity"] = max_dt_diffusivity;
@@ -326,6 +399,19 @@ void IceModel::max_timestep(double &dt_result, unsigned int &skip_counter_result
     }
   }
 
+  // Subcycling relaxes the 2D CFL condition only: the horizontal advection
+  // in the energy and age steps is not subcycled.
+  if (m_subcycling_levels > 0 and
+      m_adaptive_timestep_reason == "3D CFL" and
+      not m_subcycling_cfl_3d_warned) {
+    m_log->message(2,
+                   "PISM WARNING: the time step is limited by the 3D CFL condition (energy and age),\n"
+                   "  so mass continuity subcycling (mass_continuity_subcycling_levels = %d)\n"
+                   "  does not allow longer time steps.\n",
+                   m_subcycling_levels);
+    m_subcycling_cfl_3d_warned = true;
+  }
+
   // Hit multiples of X years, if requested (this has to go last):
   {
     const int timestep_hit_multiples = static_cast<int>(m_config->get_double("timestep_hit_multiples"));
@@ -385,6 +471,23 @@ void IceModel::max_timestep(double &dt_result, unsigned int &skip_counter_result
       skip_counter_result > 1) {
     skip_counter_result = 1;
   }
+
+  // Compute (and report) rate classes used by the subcycled mass continuity
+  // step (if any). massContExplicitStep() re-uses them.
+  if (m_subcycling_levels > 0 and
+      m_config->get_boolean("do_mass_conserve")) {
+    mass_continuity_rate_classes(dt_result);
+
+    if (m_rate_class_max > 0) {
+      std::stringstream str;
+      str << " [rate classes:";
+      for (unsigned int k = 0; k <= m_rate_class_max; ++k) {
+        str << " " << (1 << k) << "x:" << static_cast<int>(m_rate_class_counts[k]);
+      }
+      str << "]";
+      m_adaptive_timestep_reason += str.str();
+    }
+  }
 }
 
 
@@ -20,9 +20,11 @@
 
 #include "base/stressbalance/PISMStressBalance.hh"
 #include "base/util/IceGrid.hh"
+#include "base/util/Mask.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/iceModelVec.hh"
 #include "base/util/pism_options.hh"
+#include "base/util/pism_threads.hh"
 #include "columnSystem.hh"
 #include "iceModel.hh"
 
@@ -244,22 +246,16 @@ the storage grid.  The storage grid may or may not be equally-spaced.  See
 ageSystemCtx::solveThisColumn() for the actual method.
  */
 void IceModel::ageStep() {
-  PetscErrorCode  ierr;
-
-  bool viewOneColumn = options::Bool("-view_sys",
-                                     "save column system information to file");
+  const bool viewOneColumn = m_config->get_boolean("save_column_system");
 
   const IceModelVec3
     &u3 = stress_balance->velocity_u(),
     &v3 = stress_balance->velocity_v(),
     &w3 = stress_balance->velocity_w();
 
-  ageSystemCtx system(m_grid->z(), "age",
-                      m_grid->dx(), m_grid->dy(), dt_TempAge,
-                      age3, u3, v3, w3); // linear system to solve in each column
-
-  size_t Mz_fine = system.z().size();
-  std::vector<double> x(Mz_fine);   // space for solution
+  // Ice-free columns (thinner than mask_icefree_thickness_standard) have no
+  // grid levels in the ice and get zero age; only icy columns are visited below.
+  vWork3d.set(0.0);
 
   IceModelVec::AccessList list;
   list.add(ice_thickness);
@@ -269,49 +265,61 @@ void IceModel::ageStep() {
   list.add(w3);
   list.add(vWork3d);
 
+  // columns are independent, so they can be processed by several
+  // threads; each thread needs its own column system
   ParallelSection loop(m_grid->com);
-  try {
-    for (Points p(*m_grid); p; p.next()) {
-      const int i = p.i(), j = p.j();
-
-      system.initThisColumn(i, j, ice_thickness(i, j));
-
-      if (system.ks() == 0) {
-        // if no ice, set the entire column to zero age
-        vWork3d.set_column(i, j, 0.0);
-      } else {
-        // general case: solve advection PDE
-
-        // solve the system for this column; call checks that params set
-        system.solveThisColumn(x);
-
-        if (viewOneColumn && (i == id && j == jd)) {
-          ierr = PetscPrintf(PETSC_COMM_SELF,
-                             "\n"
-                             "in ageStep(): saving ageSystemCtx at (i,j)=(%d,%d) to m-file... \n",
-                             i, j);
-          PISM_CHK(ierr, "PetscPrintf");
-
-          system.viewColumnInfoMFile(x);
-        }
+  PISM_OMP_PARALLEL
+  {
+    try {
+      ageSystemCtx system(m_grid->z(), "age",
+                          m_grid->dx(), m_grid->dy(), dt_TempAge,
+                          age3, u3, v3, w3); // linear system to solve in each column
+
+      size_t Mz_fine = system.z().size();
+      std::vector<double> x(Mz_fine);   // space for solution
+
+      for (ThreadIcyPoints p(m_icy_columns); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        system.initThisColumn(i, j, ice_thickness(i, j));
+
+        if (system.ks() == 0) {
+          // if no ice, set the entire column to zero age
+          vWork3d.set_column(i, j, 0.0);
+        } else {
+          // general case: solve advection PDE
+
+          // solve the system for this column; call checks that params set
+          system.solveThisColumn(x);
+
+          if (viewOneColumn && (i == id && j == jd)) {
+            PetscErrorCode ierr = PetscPrintf(PETSC_COMM_SELF,
+                                              "\n"
+                                              "in ageStep(): saving ageSystemCtx at (i,j)=(%d,%d) to m-file... \n",
+                                              i, j);
+            PISM_CHK(ierr, "PetscPrintf");
+
+            system.viewColumnInfoMFile(x);
+          }
 
-        // put solution in IceModelVec3
-        system.fine_to_coarse(x, i, j, vWork3d);
-
-        // Ensure that the age of the ice is non-negative.
-        //
-        // FIXME: this is a kludge. We need to ensure that our numerical method has the maximum
-        // principle instead. (We may still need this for correctness, though.)
-        double *column = vWork3d.get_column(i, j);
-        for (unsigned int k = 0; k < m_grid->Mz(); ++k) {
-          if (column[k] < 0.0) {
-            column[k] = 0.0;
+          // put solution in IceModelVec3
+          system.fine_to_coarse(x, i, j, vWork3d);
+
+          // Ensure that the age of the ice is non-negative.
+          //
+          // FIXME: this is a kludge. We need to ensure that our numerical method has the maximum
+          // principle instead. (We may still need this for correctness, though.)
+          double *column = vWork3d.get_column(i, j);
+          for (unsigned int k = 0; k < m_grid->Mz(); ++k) {
+            if (column[k] < 0.0) {
+              column[k] = 0.0;
+            }
           }
         }
       }
+    } catch (...) {
+      loop.failed();
     }
-  } catch (...) {
-    loop.failed();
   }
   loop.check();
 
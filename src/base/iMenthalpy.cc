@@ -27,6 +27,7 @@
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/pism_options.hh"
+#include "base/util/pism_threads.hh"
 #include "coupler/PISMOcean.hh"
 #include "coupler/PISMSurface.hh"
 #include "enthalpyConverter.hh"
@@ -58,16 +59,21 @@ void IceModel::compute_enthalpy_cold(const IceModelVec3 &temperature, IceModelVe
   list.add(result);
   list.add(ice_thickness);
 
+  const unsigned int Mz = m_grid->Mz();
+  const std::vector<double> &z = m_grid->z();
+  std::vector<double> depth(Mz), pressure(Mz), omega(Mz, 0.0);
+
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     const double *Tij = temperature.get_column(i,j);
     double *Enthij = result.get_column(i,j);
 
-    for (unsigned int k = 0; k < m_grid->Mz(); ++k) {
-      const double depth = ice_thickness(i, j) - m_grid->z(k); // FIXME issue #15
-      Enthij[k] = EC->enthalpy_permissive(Tij[k], 0.0, EC->pressure(depth));
+    for (unsigned int k = 0; k < Mz; ++k) {
+      depth[k] = ice_thickness(i, j) - z[k]; // FIXME issue #15
     }
+    EC->pressure_n(&depth[0], &pressure[0], Mz);
+    EC->enthalpy_permissive_n(Tij, &omega[0], &pressure[0], Enthij, Mz);
   }
 
   result.inc_state_counter();
@@ -92,6 +98,10 @@ void IceModel::compute_enthalpy(const IceModelVec3 &temperature,
   list.add(result);
   list.add(ice_thickness);
 
+  const unsigned int Mz = m_grid->Mz();
+  const std::vector<double> &z = m_grid->z();
+  std::vector<double> depth(Mz), pressure(Mz);
+
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
@@ -99,11 +109,11 @@ void IceModel::compute_enthalpy(const IceModelVec3 &temperature,
     const double *Liqfracij = liquid_water_fraction.get_column(i,j);
     double *Enthij = result.get_column(i,j);
 
-    for (unsigned int k=0; k<m_grid->Mz(); ++k) {
-      const double depth = ice_thickness(i,j) - m_grid->z(k); // FIXME issue #15
-      Enthij[k] = EC->enthalpy_permissive(Tij[k], Liqfracij[k],
-                                        EC->pressure(depth));
+    for (unsigned int k=0; k<Mz; ++k) {
+      depth[k] = ice_thickness(i,j) - z[k]; // FIXME issue #15
     }
+    EC->pressure_n(&depth[0], &pressure[0], Mz);
+    EC->enthalpy_permissive_n(Tij, Liqfracij, &pressure[0], Enthij, Mz);
   }
 
   result.update_ghosts();
@@ -131,6 +141,10 @@ void IceModel::compute_liquid_water_fraction(const IceModelVec3 &enthalpy,
   list.add(enthalpy);
   list.add(ice_thickness);
 
+  const unsigned int Mz = m_grid->Mz();
+  const std::vector<double> &z = m_grid->z();
+  std::vector<double> depth(Mz), pressure(Mz);
+
   ParallelSection loop(m_grid->com);
   try {
     for (Points p(*m_grid); p; p.next()) {
@@ -139,10 +153,11 @@ void IceModel::compute_liquid_water_fraction(const IceModelVec3 &enthalpy,
       const double *Enthij = enthalpy.get_column(i,j);
       double *omegaij = result.get_column(i,j);
 
-      for (unsigned int k=0; k<m_grid->Mz(); ++k) {
-        const double depth = ice_thickness(i,j) - m_grid->z(k); // FIXME issue #15
-        omegaij[k] = EC->water_fraction(Enthij[k],EC->pressure(depth));
+      for (unsigned int k=0; k<Mz; ++k) {
+        depth[k] = ice_thickness(i,j) - z[k]; // FIXME issue #15
       }
+      EC->pressure_n(&depth[0], &pressure[0], Mz);
+      EC->water_fraction_n(Enthij, &pressure[0], omegaij, Mz);
     }
   } catch (...) {
     loop.failed();
@@ -174,15 +189,24 @@ void IceModel::setCTSFromEnthalpy(IceModelVec3 &result) {
   list.add(Enth3);
   list.add(ice_thickness);
 
+  const unsigned int Mz = m_grid->Mz();
+  const std::vector<double> &z = m_grid->z();
+  std::vector<double> depth(Mz), pressure(Mz);
+
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
     double *CTS  = result.get_column(i,j);
     const double *enthalpy = Enth3.get_column(i,j);
 
-    for (unsigned int k=0; k<m_grid->Mz(); ++k) {
-      const double depth = ice_thickness(i,j) - m_grid->z(k); // FIXME issue #15
-      CTS[k] = enthalpy[k] / EC->enthalpy_cts(EC->pressure(depth));
+    for (unsigned int k=0; k<Mz; ++k) {
+      depth[k] = ice_thickness(i,j) - z[k]; // FIXME issue #15
+    }
+    EC->pressure_n(&depth[0], &pressure[0], Mz);
+    // store E_s(p) in CTS, then divide
+    EC->enthalpy_cts_n(&pressure[0], CTS, Mz);
+    for (unsigned int k=0; k<Mz; ++k) {
+      CTS[k] = enthalpy[k] / CTS[k];
     }
   }
 }
@@ -215,8 +239,7 @@ void IceModel::enthalpyAndDrainageStep(unsigned int *vertSacrCount,
     // constants controlling the numerical method:
     bulgeEnthMax = m_config->get_double("enthalpy_cold_bulge_max"); // J kg-1
 
-  bool viewOneColumn = options::Bool("-view_sys",
-                                     "save column system information to a file");
+  const bool viewOneColumn = m_config->get_boolean("save_column_system");
 
   energy::DrainageCalculator dc(*m_config);
 
@@ -228,12 +251,7 @@ void IceModel::enthalpyAndDrainageStep(unsigned int *vertSacrCount,
 
   const IceModelVec3 &strain_heating3 = stress_balance->volumetric_strain_heating();
 
-  energy::enthSystemCtx system(m_grid->z(), "enth", m_grid->dx(), m_grid->dy(), dt_TempAge,
-                               *m_config, Enth3, u3, v3, w3, strain_heating3, EC);
-
-  size_t Mz_fine = system.z().size();
-  double dz = system.dz();
-  std::vector<double> Enthnew(Mz_fine); // new enthalpy in column
+  const double thickness_threshold = m_config->get_double("energy_advection_ice_thickness_threshold");
 
   // Now get map-plane coupler fields: Dirichlet upper surface
   // boundary and mass balance lower boundary under shelves
@@ -275,231 +293,264 @@ void IceModel::enthalpyAndDrainageStep(unsigned int *vertSacrCount,
   list.add(Enth3);
   list.add(vWork3d);
 
+  // Columns are independent, so they can be processed by several
+  // threads. Each thread needs its own column system. These are created
+  // here because the enthSystemCtx constructor reads configuration
+  // parameters and Config is not thread-safe.
+  std::vector<PISM_SHARED_PTR(energy::enthSystemCtx) > systems(threads::max_count());
+  for (unsigned int k = 0; k < systems.size(); ++k) {
+    systems[k].reset(new energy::enthSystemCtx(m_grid->z(), "enth",
+                                               m_grid->dx(), m_grid->dy(), dt_TempAge,
+                                               *m_config, Enth3, u3, v3, w3,
+                                               strain_heating3, EC));
+  }
+
+  const double dz = systems[0]->dz();
+
   unsigned int liquifiedCount = 0;
 
   MaskQuery mask(vMask);
 
   ParallelSection loop(m_grid->com);
-  try {
-    for (Points pt(*m_grid); pt; pt.next()) {
-      const int i = pt.i(), j = pt.j();
+  PISM_OMP_PARALLEL
+  {
+    unsigned int
+      my_vertSacrCount = 0,
+      my_liquifiedCount = 0,
+      my_bulgeCount = 0;
 
-      // ignore advection and strain heating in ice if isMarginal
-      const double thickness_threshold = m_config->get_double("energy_advection_ice_thickness_threshold");
-      const bool isMarginal = checkThinNeigh(ice_thickness, i, j, thickness_threshold);
+    try {
+      energy::enthSystemCtx &system = *systems[threads::index()];
 
-      system.initThisColumn(i, j, isMarginal, ice_thickness(i, j));
+      size_t Mz_fine = system.z().size();
+      std::vector<double> Enthnew(Mz_fine); // new enthalpy in column
 
-      // enthalpy and pressures at top of ice
-      const double
-        depth_ks = ice_thickness(i, j) - system.ks() * dz,
-        p_ks     = EC->pressure(depth_ks); // FIXME issue #15
+      for (ThreadPoints pt(*m_grid); pt; pt.next()) {
+        const int i = pt.i(), j = pt.j();
 
-      double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j), liqfrac_surface(i, j),
-                                             p_ks);
+        // ignore advection and strain heating in ice if isMarginal
+        const bool isMarginal = checkThinNeigh(ice_thickness, i, j, thickness_threshold);
 
-      const bool ice_free_column = (system.ks() == 0);
+        system.initThisColumn(i, j, isMarginal, ice_thickness(i, j));
 
-      // deal completely with columns with no ice; enthalpy and basal_melt_rate need setting
-      if (ice_free_column) {
-        vWork3d.set_column(i, j, Enth_ks);
-        // The floating basal melt rate will be set later; cover this
-        // case and set to zero for now. Also, there is no basal melt
-        // rate on ice free land and ice free ocean
-        basal_melt_rate(i, j) = 0.0;
-        continue;
-      } // end of if (ice_free_column)
+        // enthalpy and pressures at top of ice
+        const double
+          depth_ks = ice_thickness(i, j) - system.ks() * dz,
+          p_ks     = EC->pressure(depth_ks); // FIXME issue #15
 
-      if (system.lambda() < 1.0) {
-        *vertSacrCount += 1; // count columns with lambda < 1
-      }
+        double Enth_ks = EC->enthalpy_permissive(ice_surface_temp(i, j), liqfrac_surface(i, j),
+                                               p_ks);
 
-      const bool is_floating = mask.ocean(i, j);
-      bool base_is_warm = system.Enth(0) >= system.Enth_s(0);
-      bool above_base_is_warm = system.Enth(1) >= system.Enth_s(1);
-
-      // set boundary conditions and update enthalpy
-      {
-        system.setDirichletSurface(Enth_ks);
-
-        // determine lowest-level equation at bottom of ice; see
-        // decision chart in the source code browser and page
-        // documenting BOMBPROOF
-        if (is_floating) {
-          // floating base: Dirichlet application of known temperature from ocean
-          //   coupler; assumes base of ice shelf has zero liquid fraction
-          double Enth0 = EC->enthalpy_permissive(shelfbtemp(i, j), 0.0,
-                                               EC->pressure(ice_thickness(i, j)));
-
-          system.setDirichletBasal(Enth0);
-        } else {
-          // grounded ice warm and wet 
-          if (base_is_warm && (till_water_thickness(i, j) > 0.0)) {
-            if (above_base_is_warm) {
-              // temperate layer at base (Neumann) case:  q . n = 0  (K0 grad E . n = 0)
-              system.setBasalHeatFlux(0.0);
-            } else {
-              // only the base is warm: E = E_s(p) (Dirichlet)
-              // ( Assumes ice has zero liquid fraction. Is this a valid assumption here?
-              system.setDirichletBasal(system.Enth_s(0));
-            }
-          } else {
-            // (Neumann) case:  q . n = q_lith . n + F_b
-            // a) cold and dry base, or
-            // b) base that is still warm from the last time step, but without basal water
-            system.setBasalHeatFlux(basal_heat_flux(i, j) + Rb(i, j));
-          }
-        }
+        const bool ice_free_column = (system.ks() == 0);
 
-        // solve the system
-        system.solveThisColumn(Enthnew);
+        // deal completely with columns with no ice; enthalpy and basal_melt_rate need setting
+        if (ice_free_column) {
+          vWork3d.set_column(i, j, Enth_ks);
+          // The floating basal melt rate will be set later; cover this
+          // case and set to zero for now. Also, there is no basal melt
+          // rate on ice free land and ice free ocean
+          basal_melt_rate(i, j) = 0.0;
+          continue;
+        } // end of if (ice_free_column)
 
-        if (viewOneColumn && (i == id && j == jd)) {
-          system.viewColumnInfoMFile(Enthnew);
+        if (system.lambda() < 1.0) {
+          my_vertSacrCount += 1; // count columns with lambda < 1
         }
-      }
 
-      // post-process (drainage and bulge-limiting)
-      double Hdrainedtotal = 0.0;
-      double Hfrozen = 0.0;
-      {
-        // drain ice segments by mechanism in [\ref AschwandenBuelerKhroulevBlatter],
-        //   using DrainageCalculator dc
-        for (unsigned int k=0; k < system.ks(); k++) {
-          if (Enthnew[k] > system.Enth_s(k)) { // avoid doing any more work if cold
-
-            const double
-              depth = ice_thickness(i, j) - k * dz,
-              p     = EC->pressure(depth), // FIXME issue #15
-              T_m   = EC->melting_temperature(p),
-              L     = EC->L(T_m),
-              omega = EC->water_fraction(Enthnew[k], p);
-
-            if (Enthnew[k] >= system.Enth_s(k) + 0.5 * L) {
-              liquifiedCount++; // count these rare events...
-              Enthnew[k] = system.Enth_s(k) + 0.5 * L; //  but lose the energy
-            }
-
-            if (omega > 0.01) {                          // FIXME: make "0.01" configurable here
-              double fractiondrained = dc.get_drainage_rate(omega) * dt_TempAge; // pure number
+        const bool is_floating = mask.ocean(i, j);
+        bool base_is_warm = system.Enth(0) >= system.Enth_s(0);
+        bool above_base_is_warm = system.Enth(1) >= system.Enth_s(1);
 
-              fractiondrained  = std::min(fractiondrained, omega - 0.01); // only drain down to 0.01
-              Hdrainedtotal   += fractiondrained * dz; // always a positive contribution
-              Enthnew[k]      -= fractiondrained * L;
+        // set boundary conditions and update enthalpy
+        {
+          system.setDirichletSurface(Enth_ks);
+
+          // determine lowest-level equation at bottom of ice; see
+          // decision chart in the source code browser and page
+          // documenting BOMBPROOF
+          if (is_floating) {
+            // floating base: Dirichlet application of known temperature from ocean
+            //   coupler; assumes base of ice shelf has zero liquid fraction
+            double Enth0 = EC->enthalpy_permissive(shelfbtemp(i, j), 0.0,
+                                                 EC->pressure(ice_thickness(i, j)));
+
+            system.setDirichletBasal(Enth0);
+          } else {
+            // grounded ice warm and wet 
+            if (base_is_warm && (till_water_thickness(i, j) > 0.0)) {
+              if (above_base_is_warm) {
+                // temperate layer at base (Neumann) case:  q . n = 0  (K0 grad E . n = 0)
+                system.setBasalHeatFlux(0.0);
+              } else {
+                // only the base is warm: E = E_s(p) (Dirichlet)
+                // ( Assumes ice has zero liquid fraction. Is this a valid assumption here?
+                system.setDirichletBasal(system.Enth_s(0));
+              }
+            } else {
+              // (Neumann) case:  q . n = q_lith . n + F_b
+              // a) cold and dry base, or
+              // b) base that is still warm from the last time step, but without basal water
+              system.setBasalHeatFlux(basal_heat_flux(i, j) + Rb(i, j));
             }
           }
-        }
 
-        // apply bulge limiter
-        const double lowerEnthLimit = Enth_ks - bulgeEnthMax;
-        for (unsigned int k=0; k < system.ks(); k++) {
-          if (Enthnew[k] < lowerEnthLimit) {
-            *bulgeCount += 1;      // count the columns which have very large cold
-            Enthnew[k] = lowerEnthLimit;  // limit advection bulge ... enthalpy not too low
+          // solve the system
+          system.solveThisColumn(Enthnew);
+
+          if (viewOneColumn && (i == id && j == jd)) {
+            system.viewColumnInfoMFile(Enthnew);
           }
         }
 
-        // if there is subglacial water, don't allow ice base enthalpy to be below
-        // pressure-melting; that is, assume subglacial water is at the pressure-
-        // melting temperature and enforce continuity of temperature
+        // post-process (drainage and bulge-limiting)
+        double Hdrainedtotal = 0.0;
+        double Hfrozen = 0.0;
         {
-          if (Enthnew[0] < system.Enth_s(0) && till_water_thickness(i,j) > 0.0) {
-            const double E_difference = system.Enth_s(0) - Enthnew[0];
-
-            const double depth = ice_thickness(i, j),
-              pressure         = EC->pressure(depth),
-              T_m              = EC->melting_temperature(pressure);
-
-            Enthnew[0] = system.Enth_s(0);
-            // This adjustment creates energy out of nothing. We will
-            // freeze some basal water, subtracting an equal amount of
-            // energy, to make up for it.
-            //
-            // Note that [E_difference] = J/kg, so
-            //
-            // U_difference = E_difference * ice_density * dx * dy * (0.5*dz)
-            //
-            // is the amount of energy created (we changed enthalpy of
-            // a block of ice with the volume equal to
-            // dx*dy*(0.5*dz); note that the control volume
-            // corresponding to the grid point at the base of the
-            // column has thickness 0.5*dz, not dz).
-            //
-            // Also, [L] = J/kg, so
-            //
-            // U_freeze_on = L * ice_density * dx * dy * Hfrozen,
-            //
-            // is the amount of energy created by freezing a water
-            // layer of thickness Hfrozen (using units of ice
-            // equivalent thickness).
-            //
-            // Setting U_difference = U_freeze_on and solving for
-            // Hfrozen, we find the thickness of the basal water layer
-            // we need to freeze co restore energy conservation.
-
-            Hfrozen = E_difference * (0.5*dz) / EC->L(T_m);
-          }
-        }
+          // drain ice segments by mechanism in [\ref AschwandenBuelerKhroulevBlatter],
+          //   using DrainageCalculator dc
+          for (unsigned int k=0; k < system.ks(); k++) {
+            if (Enthnew[k] > system.Enth_s(k)) { // avoid doing any more work if cold
 
-      } // end of post-processing
-
-      // compute basal melt rate
-      {
-        bool base_is_cold = (Enthnew[0] < system.Enth_s(0)) && (till_water_thickness(i,j) == 0.0);
-        // Determine melt rate, but only preliminarily because of
-        // drainage, from heat flux out of bedrock, heat flux into
-        // ice, and frictional heating
-        if (is_floating == true) {
-          // The floating basal melt rate will be set later; cover
-          // this case and set to zero for now. Note that
-          // Hdrainedtotal is discarded (the ocean model determines
-          // the basal melt).
-          basal_melt_rate(i, j) = 0.0;
-        } else {
-          if (base_is_cold) {
-            basal_melt_rate(i, j) = 0.0;  // zero melt rate if cold base
-          } else {
-            const double
-              p_0 = EC->pressure(ice_thickness(i, j)),
-              p_1 = EC->pressure(ice_thickness(i, j) - dz), // FIXME issue #15
-              Tpmp_0 = EC->melting_temperature(p_0);
-
-            const bool k1_istemperate = EC->is_temperate(Enthnew[1], p_1); // level  z = + \Delta z
-            double hf_up;
-            if (k1_istemperate) {
               const double
-                Tpmp_1 = EC->melting_temperature(p_1);
+                depth = ice_thickness(i, j) - k * dz,
+                p     = EC->pressure(depth), // FIXME issue #15
+                T_m   = EC->melting_temperature(p),
+                L     = EC->L(T_m),
+                omega = EC->water_fraction(Enthnew[k], p);
+
+              if (Enthnew[k] >= system.Enth_s(k) + 0.5 * L) {
+                my_liquifiedCount++; // count these rare events...
+                Enthnew[k] = system.Enth_s(k) + 0.5 * L; //  but lose the energy
+              }
+
+              if (omega > 0.01) {                          // FIXME: make "0.01" configurable here
+                double fractiondrained = dc.get_drainage_rate(omega) * dt_TempAge; // pure number
+
+                fractiondrained  = std::min(fractiondrained, omega - 0.01); // only drain down to 0.01
+                Hdrainedtotal   += fractiondrained * dz; // always a positive contribution
+                Enthnew[k]      -= fractiondrained * L;
+              }
+            }
+          }
 
-              hf_up = -system.k_from_T(Tpmp_0) * (Tpmp_1 - Tpmp_0) / dz;
-            } else {
-              double T_0 = EC->temperature(Enthnew[0], p_0);
-              const double K_0 = system.k_from_T(T_0) / EC->c(T_0);
+          // apply bulge limiter
+          const double lowerEnthLimit = Enth_ks - bulgeEnthMax;
+          for (unsigned int k=0; k < system.ks(); k++) {
+            if (Enthnew[k] < lowerEnthLimit) {
+              my_bulgeCount += 1;      // count the columns which have very large cold
+              Enthnew[k] = lowerEnthLimit;  // limit advection bulge ... enthalpy not too low
+            }
+          }
 
-              hf_up = -K_0 * (Enthnew[1] - Enthnew[0]) / dz;
+          // if there is subglacial water, don't allow ice base enthalpy to be below
+          // pressure-melting; that is, assume subglacial water is at the pressure-
+          // melting temperature and enforce continuity of temperature
+          {
+            if (Enthnew[0] < system.Enth_s(0) && till_water_thickness(i,j) > 0.0) {
+              const double E_difference = system.Enth_s(0) - Enthnew[0];
+
+              const double depth = ice_thickness(i, j),
+                pressure         = EC->pressure(depth),
+                T_m              = EC->melting_temperature(pressure);
+
+              Enthnew[0] = system.Enth_s(0);
+              // This adjustment creates energy out of nothing. We will
+              // freeze some basal water, subtracting an equal amount of
+              // energy, to make up for it.
+              //
+              // Note that [E_difference] = J/kg, so
+              //
+              // U_difference = E_difference * ice_density * dx * dy * (0.5*dz)
+              //
+              // is the amount of energy created (we changed enthalpy of
+              // a block of ice with the volume equal to
+              // dx*dy*(0.5*dz); note that the control volume
+              // corresponding to the grid point at the base of the
+              // column has thickness 0.5*dz, not dz).
+              //
+              // Also, [L] = J/kg, so
+              //
+              // U_freeze_on = L * ice_density * dx * dy * Hfrozen,
+              //
+              // is the amount of energy created by freezing a water
+              // layer of thickness Hfrozen (using units of ice
+              // equivalent thickness).
+              //
+              // Setting U_difference = U_freeze_on and solving for
+              // Hfrozen, we find the thickness of the basal water layer
+              // we need to freeze co restore energy conservation.
+
+              Hfrozen = E_difference * (0.5*dz) / EC->L(T_m);
             }
+          }
 
-            // compute basal melt rate from flux balance:
-            //
-            // basal_melt_rate = - Mb / rho in [\ref AschwandenBuelerKhroulevBlatter];
-            //
-            // after we compute it we make sure there is no refreeze if
-            // there is no available basal water
-            basal_melt_rate(i, j) = (Rb(i, j) + basal_heat_flux(i, j) - hf_up) / (ice_density * EC->L(Tpmp_0));
+        } // end of post-processing
 
-            if (till_water_thickness(i, j) <= 0 && basal_melt_rate(i, j) < 0) {
-              basal_melt_rate(i, j) = 0.0;
+        // compute basal melt rate
+        {
+          bool base_is_cold = (Enthnew[0] < system.Enth_s(0)) && (till_water_thickness(i,j) == 0.0);
+          // Determine melt rate, but only preliminarily because of
+          // drainage, from heat flux out of bedrock, heat flux into
+          // ice, and frictional heating
+          if (is_floating == true) {
+            // The floating basal melt rate will be set later; cover
+            // this case and set to zero for now. Note that
+            // Hdrainedtotal is discarded (the ocean model determines
+            // the basal melt).
+            basal_melt_rate(i, j) = 0.0;
+          } else {
+            if (base_is_cold) {
+              basal_melt_rate(i, j) = 0.0;  // zero melt rate if cold base
+            } else {
+              const double
+                p_0 = EC->pressure(ice_thickness(i, j)),
+                p_1 = EC->pressure(ice_thickness(i, j) - dz), // FIXME issue #15
+                Tpmp_0 = EC->melting_temperature(p_0);
+
+              const bool k1_istemperate = EC->is_temperate(Enthnew[1], p_1); // level  z = + \Delta z
+              double hf_up;
+              if (k1_istemperate) {
+                const double
+                  Tpmp_1 = EC->melting_temperature(p_1);
+
+                hf_up = -system.k_from_T(Tpmp_0) * (Tpmp_1 - Tpmp_0) / dz;
+              } else {
+                double T_0 = EC->temperature(Enthnew[0], p_0);
+                const double K_0 = system.k_from_T(T_0) / EC->c(T_0);
+
+                hf_up = -K_0 * (Enthnew[1] - Enthnew[0]) / dz;
+              }
+
+              // compute basal melt rate from flux balance:
+              //
+              // basal_melt_rate = - Mb / rho in [\ref AschwandenBuelerKhroulevBlatter];
+              //
+              // after we compute it we make sure there is no refreeze if
+              // there is no available basal water
+              basal_melt_rate(i, j) = (Rb(i, j) + basal_heat_flux(i, j) - hf_up) / (ice_density * EC->L(Tpmp_0));
+
+              if (till_water_thickness(i, j) <= 0 && basal_melt_rate(i, j) < 0) {
+                basal_melt_rate(i, j) = 0.0;
+              }
             }
-          }
 
-          // Add drained water from the column to basal melt rate.
-          basal_melt_rate(i, j) += (Hdrainedtotal - Hfrozen) / dt_TempAge;
-        } // end of the grounded case
-      } // end of the basal melt rate computation
+            // Add drained water from the column to basal melt rate.
+            basal_melt_rate(i, j) += (Hdrainedtotal - Hfrozen) / dt_TempAge;
+          } // end of the grounded case
+        } // end of the basal melt rate computation
 
-      system.fine_to_coarse(Enthnew, i, j, vWork3d);
+        system.fine_to_coarse(Enthnew, i, j, vWork3d);
+      }
+    } catch (...) {
+      loop.failed();
+    }
+
+    PISM_OMP_CRITICAL
+    {
+      *vertSacrCount += my_vertSacrCount;
+      liquifiedCount += my_liquifiedCount;
+      *bulgeCount    += my_bulgeCount;
     }
-  } catch (...) {
-    loop.failed();
   }
   loop.check();
 
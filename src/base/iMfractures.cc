@@ -79,14 +79,14 @@ void IceModel::calculateFractureDensity() {
 
   //options
   /////////////////////////////////////////////////////////
-  double soft_residual = options::Real("-fracture_softening", "soft_residual", 1.0);
+  double soft_residual = m_config->get_double("fracture_density_softening_lower_limit");
   // assume linear response function: E_fr = (1-(1-soft_residual)*phi) -> 1-phi
   //
   // more: T. Albrecht, A. Levermann; Fracture-induced softening for
   // large-scale ice dynamics; (2013), The Cryosphere Discussions 7;
   // 4501-4544; DOI:10.5194/tcd-7-4501-2013
 
-  // get four options for calculation of fracture density.
+  // get four parameters for calculation of fracture density (set using -fractures).
   // 1st: fracture growth constant gamma
   // 2nd: fracture initiation stress threshold sigma_cr
   // 3rd: healing rate constant gamma_h
@@ -95,46 +95,32 @@ void IceModel::calculateFractureDensity() {
   // ice dynamics; (2012), Journal of Glaciology, Vol. 58, No. 207,
   // 165-176, DOI: 10.3189/2012JoG11J191.
 
-  double
-    gamma         = 1.0,
-    initThreshold = 7.0e4,
-    gammaheal     = 0.0,
-    healThreshold = 2.0e-10;
-
-  options::RealList fractures("-fractures", "gamma, initThreshold, gammaheal, healThreshold");
-
-  if (fractures.is_set()) {
-    if (fractures->size() != 4) {
-      throw RuntimeError("option -fractures requires exactly 4 arguments");
-    }
-    gamma         = fractures[0];
-    initThreshold = fractures[1];
-    gammaheal     = fractures[2];
-    healThreshold = fractures[3];
-  }
+  const double
+    gamma         = m_config->get_double("fracture_density_gamma"),
+    initThreshold = m_config->get_double("fracture_density_initiation_threshold"),
+    gammaheal     = m_config->get_double("fracture_density_healing_rate"),
+    healThreshold = m_config->get_double("fracture_density_healing_threshold");
 
   m_log->message(3,
              "PISM-PIK INFO: fracture density is found with parameters:\n"
              " gamma=%.2f, sigma_cr=%.2f, gammah=%.2f, healing_cr=%.1e and soft_res=%f \n",
              gamma, initThreshold, gammaheal, healThreshold, soft_residual);
 
-  bool do_fracground = options::Bool("-do_frac_on_grounded",
-                                     "model fracture density in grounded areas");
+  const bool do_fracground = m_config->get_boolean("fracture_density_on_grounded_ice");
 
-  double fdBoundaryValue = options::Real("-phi0", "phi0", 0.0);
+  const double fdBoundaryValue = m_config->get_double("fracture_density_boundary_value");
 
-  bool constant_healing = options::Bool("-constant_healing", "constant healing");
+  const bool constant_healing = m_config->get_boolean("fracture_density_constant_healing");
 
-  bool fracture_weighted_healing = options::Bool("-fracture_weighted_healing",
-                                                 "fracture weighted healing");
+  const bool fracture_weighted_healing = m_config->get_boolean("fracture_density_weighted_healing");
 
-  bool max_shear_stress = options::Bool("-max_shear", "max shear");
+  const bool max_shear_stress = m_config->get_boolean("fracture_density_max_shear_stress");
 
-  bool lefm = options::Bool("-lefm", "lefm");
+  const bool lefm = m_config->get_boolean("fracture_density_lefm");
 
-  bool constant_fd = options::Bool("-constant_fd", "constant fd");
+  const bool constant_fd = m_config->get_boolean("fracture_density_constant");
 
-  bool fd2d_scheme = options::Bool("-scheme_fd2d", "scheme fd2d");
+  const bool fd2d_scheme = m_config->get_boolean("fracture_density_fd2d_scheme");
 
   const double one_year = units::convert(m_sys, 1.0, "year", "seconds");
 
@@ -31,6 +31,7 @@
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/pism_const.hh"
+#include "base/util/pism_threads.hh"
 #include "coupler/PISMOcean.hh"
 #include "coupler/PISMSurface.hh"
 #include "earth/PISMBedDef.hh"
@@ -53,18 +54,132 @@ using namespace mask;
 
   Also calls the code which removes icebergs, to avoid stress balance
   solver problems associated to not-attached-to-grounded ice.
+
+  The mask and the surface elevation are re-computed only at grid
+  points where the bed elevation or the ice thickness changed (see
+  update_changed_mask_and_surface()). Icebergs can appear only if the
+  mask changed, so the iceberg remover (which gathers the mask on
+  processor 0) is skipped if the mask is the same everywhere.
 */
 void IceModel::updateSurfaceElevationAndMask() {
   const IceModelVec2S &bed_topography = beddef->bed_elevation();
 
-  update_mask(bed_topography, ice_thickness, vMask);
-  update_surface_elevation(bed_topography, ice_thickness, ice_surface_elevation);
+  update_changed_mask_and_surface(bed_topography, ice_thickness);
 
   if (m_config->get_boolean("kill_icebergs") && iceberg_remover != NULL) {
-    iceberg_remover->update(vMask, ice_thickness);
-    // the call above modifies ice thickness and updates the mask
-    // accordingly
-    update_surface_elevation(bed_topography, ice_thickness, ice_surface_elevation);
+    if (GlobalMax(m_grid->com, m_geometry_mask_changed ? 1.0 : 0.0) > 0.0) {
+      iceberg_remover->update(vMask, ice_thickness);
+      // the call above modifies ice thickness and updates the mask
+      // accordingly
+      update_changed_mask_and_surface(bed_topography, ice_thickness);
+    }
+  }
+
+  if (m_geometry_mask_changed) {
+    m_icy_columns.update(vMask);
+    m_geometry_mask_changed = false;
+  }
+}
+
+//! @brief Update the mask and the surface elevation at grid points
+//! (including ghosts) where the bed elevation or the ice thickness changed.
+/*!
+ * Values of `bed` and `thickness` used here are saved and compared to
+ * values at the next call. Everything is re-computed if the sea level
+ * changed or if the mask or the surface elevation was modified using
+ * an IceModelVec method (e.g. read from a file).
+ *
+ * Ghosts are updated redundantly, so no communication is needed.
+ *
+ * Sets `m_geometry_mask_changed` if the mask changed at any point
+ * owned by this processor. This flag is cleared by
+ * updateSurfaceElevationAndMask().
+ */
+void IceModel::update_changed_mask_and_surface(const IceModelVec2S &bed,
+                                               const IceModelVec2S &thickness) {
+  assert(ocean != NULL);
+  const double sea_level = ocean->sea_level_elevation();
+
+  GeometryCalculator gc(sea_level, *m_config);
+
+  const bool update_all = (not m_geometry_valid or
+                           sea_level != m_geometry_sea_level or
+                           vMask.get_state_counter() != m_geometry_mask_counter or
+                           ice_surface_elevation.get_state_counter() != m_geometry_surface_counter);
+
+  IceModelVec::AccessList list;
+  list.add(bed);
+  list.add(thickness);
+  list.add(vMask);
+  list.add(ice_surface_elevation);
+  list.add(m_geometry_bed);
+  list.add(m_geometry_thickness);
+
+  const unsigned int GHOSTS = vMask.get_stencil_width();
+  assert(ice_surface_elevation.get_stencil_width() >= GHOSTS);
+  assert(bed.get_stencil_width() >= GHOSTS);
+  assert(thickness.get_stencil_width() >= GHOSTS);
+  assert(m_geometry_bed.get_stencil_width() >= GHOSTS);
+  assert(m_geometry_thickness.get_stencil_width() >= GHOSTS);
+
+  RawArray2<double>
+    b(bed),
+    H(thickness),
+    M(vMask),
+    S(ice_surface_elevation),
+    b_last(m_geometry_bed),
+    H_last(m_geometry_thickness);
+
+  const int xs = m_grid->xs(), xm = m_grid->xm(),
+    ys = m_grid->ys(), ym = m_grid->ym();
+
+  bool mask_changed = update_all;
+
+  ParallelSection loop(m_grid->com);
+  try {
+    for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      if (not update_all and H(i, j) == H_last(i, j) and b(i, j) == b_last(i, j)) {
+        continue;
+      }
+
+      // take this opportunity to check that thickness(i, j) >= 0
+      if (H(i, j) < 0) {
+        throw RuntimeError::formatted("Thickness negative at point i=%d, j=%d", i, j);
+      }
+
+      int mask_value = 0;
+      double surface_value = 0.0;
+      gc.compute(b(i, j), H(i, j), &mask_value, &surface_value);
+
+      // Compare to the mask computed using saved inputs: the mask
+      // itself may have been updated by update_mask() since the last
+      // call.
+      if (not update_all and
+          i >= xs and i < xs + xm and j >= ys and j < ys + ym and
+          gc.mask(b_last(i, j), H_last(i, j)) != mask_value) {
+        mask_changed = true;
+      }
+
+      M(i, j) = mask_value;
+      S(i, j) = surface_value;
+
+      b_last(i, j) = b(i, j);
+      H_last(i, j) = H(i, j);
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  m_geometry_sea_level       = sea_level;
+  m_geometry_mask_counter    = vMask.get_state_counter();
+  m_geometry_surface_counter = ice_surface_elevation.get_state_counter();
+  m_geometry_valid           = true;
+
+  if (mask_changed) {
+    m_geometry_mask_changed = true;
   }
 }
 
@@ -95,11 +210,25 @@ void IceModel::update_mask(const IceModelVec2S &bed,
   assert(bed.get_stencil_width() >= result.get_stencil_width());
   assert(thickness.get_stencil_width() >= result.get_stencil_width());
 
-  for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  RawArray2<double>
+    M(result),
+    b(bed),
+    H(thickness);
 
-    result(i, j) = gc.mask(bed(i, j), thickness(i, j));
+  ParallelSection loop(m_grid->com);
+  PISM_OMP_PARALLEL
+  {
+    try {
+      for (ThreadPoints p(*m_grid, GHOSTS); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        M(i, j) = gc.mask(b(i, j), H(i, j));
+      }
+    } catch (...) {
+      loop.failed();
+    }
   }
+  loop.check();
 }
 
 /**
@@ -132,19 +261,27 @@ void IceModel::update_surface_elevation(const IceModelVec2S &bed,
   assert(bed.get_stencil_width() >= result.get_stencil_width());
   assert(thickness.get_stencil_width() >= result.get_stencil_width());
 
+  RawArray2<double>
+    S(result),
+    b(bed),
+    H(thickness);
+
   ParallelSection loop(m_grid->com);
-  try {
-    for (PointsWithGhosts p(*m_grid, GHOSTS); p; p.next()) {
-      const int i = p.i(), j = p.j();
+  PISM_OMP_PARALLEL
+  {
+    try {
+      for (ThreadPoints p(*m_grid, GHOSTS); p; p.next()) {
+        const int i = p.i(), j = p.j();
 
-      // take this opportunity to check that thickness(i, j) >= 0
-      if (thickness(i, j) < 0) {
-        throw RuntimeError::formatted("Thickness negative at point i=%d, j=%d", i, j);
+        // take this opportunity to check that thickness(i, j) >= 0
+        if (H(i, j) < 0) {
+          throw RuntimeError::formatted("Thickness negative at point i=%d, j=%d", i, j);
+        }
+        S(i, j) = gc.surface(b(i, j), H(i, j));
       }
-      result(i, j) = gc.surface(bed(i, j), thickness(i, j));
+    } catch (...) {
+      loop.failed();
     }
-  } catch (...) {
-    loop.failed();
   }
   loop.check();
 }
@@ -416,6 +553,159 @@ void IceModel::cell_interface_fluxes(bool dirichlet_bc,
 }
 
 
+//! Length of a sub-step (as a fraction of the time step) for an interface between cells in rate classes `a` and `b`.
+/*!
+  An interface belongs to the faster of the two cells sharing it and is
+  updated every `2^(max_class - class)` sub-steps. Returns 0 if the
+  interface is not updated during the sub-step `step`.
+
+  Results are powers of 2, so with one sub-step the flux divergence is
+  computed exactly as in massContExplicitStep().
+ */
+static double interface_substep(int a, int b, int max_class, int step) {
+  const int rate_class = std::max(a, b);
+
+  if (step % (1 << (max_class - rate_class)) != 0) {
+    return 0.0;
+  }
+
+  return 1.0 / (1 << rate_class);
+}
+
+//! @brief Compute the advective (sliding) part of the flux divergence using local sub-steps.
+/*!
+  Cells are grouped into rate classes by mass_continuity_rate_classes(). A
+  cell in the class `k` is updated `2^k` times during the time step `dt`,
+  so that fast outlet glaciers do not limit the time step of the whole
+  domain.
+
+  Each cell uses velocities through its interfaces computed by
+  cell_interface_fluxes() and the donor cell upwinding, exactly as in
+  massContExplicitStep(). If all cells are in the class 0 the result is
+  the same as without subcycling.
+
+  Only the ice thickness in icy cells evolves during sub-steps; ice-free
+  cells accumulate incoming flux but do not pass it on, so that the
+  part_grid mechanism and calving see the same fluxes as without
+  subcycling. The diffusive (SIA) part of the flux is not subcycled.
+
+  @param[in] dirichlet_bc true if Dirichlet B.C. are set
+  @param[out] result flux divergence averaged over the time step, m s-1
+ */
+void IceModel::subcycled_advective_divergence(bool dirichlet_bc, IceModelVec2S &result) {
+
+  // Rate classes are usually computed by max_timestep(); re-compute them if
+  // they correspond to a different time step.
+  if (m_rate_class_dt != dt) {
+    mass_continuity_rate_classes(dt);
+  }
+  const int max_class = m_rate_class_max;
+  // velocities may change before the next call
+  m_rate_class_dt = -1.0;
+
+  const double dx = m_grid->dx(), dy = m_grid->dy();
+
+  const IceModelVec2Stag &Qdiff = stress_balance->diffusive_flux();
+
+  const IceModelVec2V &vel_advective = stress_balance->advective_velocity();
+
+  MaskQuery mask(vMask);
+
+  // Store velocities through interfaces of each cell.
+  {
+    IceModelVec::AccessList list;
+    list.add(vMask);
+    list.add(Qdiff);
+    list.add(vel_advective);
+    list.add(m_face_velocity);
+    if (dirichlet_bc) {
+      list.add(vBCMask);
+      list.add(vBCvel);
+    }
+
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      StarStencil<double> Q, v;
+      cell_interface_fluxes(dirichlet_bc, i, j,
+                            vel_advective.star(i, j), Qdiff.star(i, j),
+                            v, Q);
+
+      m_face_velocity(i, j, 0) = v.e;
+      m_face_velocity(i, j, 1) = v.w;
+      m_face_velocity(i, j, 2) = v.n;
+      m_face_velocity(i, j, 3) = v.s;
+    }
+  }
+
+  m_subcycled_thickness.copy_from(ice_thickness);
+  m_subcycled_thickness.update_ghosts();
+
+  // result contains the flux divergence times the fraction of the time
+  // step (in m s-1) until the end of the loop below
+  result.set(0.0);
+
+  const int n_substeps = 1 << max_class;
+  for (int step = 0; step < n_substeps; ++step) {
+    {
+      IceModelVec::AccessList list;
+      list.add(m_rate_class);
+      list.add(m_face_velocity);
+      list.add(m_subcycled_thickness);
+      list.add(result);
+
+      for (Points p(*m_grid); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        const StarStencil<int> c = m_rate_class.int_star(i, j);
+        const StarStencil<double> H = m_subcycled_thickness.star(i, j);
+
+        const double
+          v_e = m_face_velocity(i, j, 0),
+          v_w = m_face_velocity(i, j, 1),
+          v_n = m_face_velocity(i, j, 2),
+          v_s = m_face_velocity(i, j, 3);
+
+        const double
+          f_e = interface_substep(c.ij, c.e, max_class, step),
+          f_w = interface_substep(c.ij, c.w, max_class, step),
+          f_n = interface_substep(c.ij, c.n, max_class, step),
+          f_s = interface_substep(c.ij, c.s, max_class, step);
+
+        // upwinded fluxes through interfaces; same as in massContExplicitStep()
+        result(i, j) += (f_e * v_e * std::max(v_e > 0 ? H.ij : H.e, 0.0)
+                         - f_w * v_w * std::max(v_w > 0 ? H.w : H.ij, 0.0)) / dx;
+        result(i, j) += (f_n * v_n * std::max(v_n > 0 ? H.ij : H.n, 0.0)
+                         - f_s * v_s * std::max(v_s > 0 ? H.s : H.ij, 0.0)) / dy;
+      }
+    }
+
+    if (step == n_substeps - 1) {
+      break;
+    }
+
+    {
+      IceModelVec::AccessList list;
+      list.add(vMask);
+      list.add(ice_thickness);
+      list.add(m_subcycled_thickness);
+      list.add(result);
+      if (dirichlet_bc) {
+        list.add(vBCMask);
+      }
+
+      for (Points p(*m_grid); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        if (mask.icy(i, j) and not (dirichlet_bc and vBCMask.as_int(i, j) == 1)) {
+          m_subcycled_thickness(i, j) = ice_thickness(i, j) - dt * result(i, j);
+        }
+      }
+    }
+    m_subcycled_thickness.update_ghosts();
+  }
+}
+
 //! Update the thickness from the diffusive flux and sliding velocity, and the surface and basal mass balance rates.
 /*!
   The partial differential equation describing the conservation of mass in the
@@ -574,6 +864,14 @@ void IceModel::massContExplicitStep() {
     list.add(vBCvel);
   }
 
+  // The advective part of the flux divergence is computed using local
+  // sub-steps if requested.
+  const bool subcycling = m_subcycling_levels > 0;
+  if (subcycling) {
+    subcycled_advective_divergence(dirichlet_bc, m_subcycled_divergence);
+    list.add(m_subcycled_divergence);
+  }
+
   if (compute_cumulative_climatic_mass_balance) {
     list.add(climatic_mass_balance_cumulative);
   }
@@ -639,10 +937,14 @@ void IceModel::massContExplicitStep() {
 
         // Plug flow part (i.e. basal sliding; from SSA): upwind by staggered grid
         // PIK method;  this is   \nabla \cdot [(u, v) H]
-        divQ_SSA += (v.e * (v.e > 0 ? ice_thickness(i, j) : ice_thickness(i + 1, j))
-                     - v.w * (v.w > 0 ? ice_thickness(i - 1, j) : ice_thickness(i, j))) / dx;
-        divQ_SSA += (v.n * (v.n > 0 ? ice_thickness(i, j) : ice_thickness(i, j + 1))
-                     - v.s * (v.s > 0 ? ice_thickness(i, j - 1) : ice_thickness(i, j))) / dy;
+        if (subcycling) {
+          divQ_SSA = m_subcycled_divergence(i, j);
+        } else {
+          divQ_SSA += (v.e * (v.e > 0 ? ice_thickness(i, j) : ice_thickness(i + 1, j))
+                       - v.w * (v.w > 0 ? ice_thickness(i - 1, j) : ice_thickness(i, j))) / dx;
+          divQ_SSA += (v.n * (v.n > 0 ? ice_thickness(i, j) : ice_thickness(i, j + 1))
+                       - v.s * (v.s > 0 ? ice_thickness(i, j - 1) : ice_thickness(i, j))) / dy;
+        }
       }
 
       // Set source terms
@@ -21,6 +21,7 @@
 
 #include <petscdmda.h>
 #include <cassert>
+#include <cmath>
 #include <algorithm>
 
 #include "iceModel.hh"
@@ -105,8 +106,17 @@ void IceModel::model_state_setup() {
   options::String input_file("-i", "Specifies the PISM input file");
   bool bootstrap = options::Bool("-bootstrap", "enable bootstrapping heuristics");
 
+  // With -checkpoint the input file is the state file of a binary
+  // checkpoint (see io::checkpoint_input_from_options()).
+  options::String checkpoint("-checkpoint",
+                             "Specifies the prefix of a binary checkpoint to restart from");
+
   if (input_file.is_set() and not bootstrap) {
-    initFromFile(input_file);
+    if (checkpoint.is_set()) {
+      init_from_checkpoint(checkpoint);
+    } else {
+      initFromFile(input_file);
+    }
 
     regrid(0);
     // Check consistency of geometry after initialization:
@@ -554,11 +564,55 @@ void IceModel::allocate_internal_objects() {
     vWork2d[j].create(m_grid, namestr, WITH_GHOSTS, WIDE_STENCIL);
   }
 
+  // copies of inputs of the last mask and surface elevation update
+  m_geometry_bed.create(m_grid, "geometry_bed", WITH_GHOSTS, WIDE_STENCIL);
+  m_geometry_bed.set_attrs("internal",
+                           "bed elevation used to compute the mask and surface elevation",
+                           "m", "");
+
+  m_geometry_thickness.create(m_grid, "geometry_thickness", WITH_GHOSTS, WIDE_STENCIL);
+  m_geometry_thickness.set_attrs("internal",
+                                 "ice thickness used to compute the mask and surface elevation",
+                                 "m", "");
+
   // 3d work vectors
   vWork3d.create(m_grid,"work_vector_3d",WITHOUT_GHOSTS);
   vWork3d.set_attrs("internal",
                     "e.g. new values of temperature or age or enthalpy during time step",
                     "", "");
+
+  {
+    const double levels = m_config->get_double("mass_continuity_subcycling_levels");
+    // 2^levels sub-steps are stored in an int
+    if (levels != floor(levels) or levels < 0.0 or levels >= 31.0) {
+      throw RuntimeError::formatted("mass_continuity_subcycling_levels = %f is invalid"
+                                    " (it has to be an integer between 0 and 30)", levels);
+    }
+    m_subcycling_levels = static_cast<unsigned int>(levels);
+  }
+
+  if (m_subcycling_levels > 0) {
+    m_rate_class.create(m_grid, "mass_continuity_rate_class", WITH_GHOSTS);
+    m_rate_class.set_attrs("internal", "mass continuity rate class", "", "");
+
+    m_subcycled_thickness.create(m_grid, "subcycled_thickness", WITH_GHOSTS);
+    m_subcycled_thickness.set_attrs("internal",
+                                    "ice thickness during mass continuity sub-steps",
+                                    "m", "");
+
+    m_subcycled_divergence.create(m_grid, "subcycled_divergence", WITHOUT_GHOSTS);
+    m_subcycled_divergence.set_attrs("internal",
+                                     "advective flux divergence averaged over a time step",
+                                     "m s-1", "");
+
+    m_face_velocity.create(m_grid, "face_velocity", WITHOUT_GHOSTS, 0, 4);
+    const char *faces[] = {"east", "west", "north", "south"};
+    for (unsigned int k = 0; k < 4; ++k) {
+      m_face_velocity.set_attrs("internal",
+                                std::string("advective velocity through the ") + faces[k] + " cell interface",
+                                "m s-1", "", k);
+    }
+  }
 }
 
 
@@ -50,6 +50,10 @@ void IceModel::setFromOptions() {
   id = options::Integer("-id", "Specifies the sounding row", id);
   jd = options::Integer("-jd", "Specifies the sounding column", jd);
 
+  // used if the stress balance fails during time-stepping
+  output_filename = options::String("-o", "Output file name", "output.nc",
+                                    options::DONT_ALLOW_EMPTY);
+
   // Set global attributes using the config database:
   global_attributes.set_string("title", m_config->get_string("run_title"));
   global_attributes.set_string("institution", m_config->get_string("institution"));
@@ -127,6 +127,14 @@ void IceModel::residual_redistribution(IceModelVec2S &H_residual) {
 //! @brief This routine carries-over the ice mass when using
 // -part_redist option, one step in the loop.
 /**
+ * Residual ice thickness is moved to ice-free ocean neighbors in one
+ * pass over the grid. Contributions to neighbors owned by other
+ * processors are stored in ghosts of a work field and added to owned
+ * values using one ghost reduction (IceModelVec::accumulate_ghosts()).
+ *
+ * The mask and the surface elevation are re-computed only where the
+ * ice thickness changed (see update_changed_mask_and_surface()).
+ *
  * @param[in,out] H_residual Residual Ice thickness. Updated in place.
  * @param[out] done set to 'true' if this was the last iteration we needed
  *
@@ -138,14 +146,20 @@ void IceModel::residual_redistribution_iteration(IceModelVec2S &H_residual, bool
 
   const IceModelVec2S &bed_topography = beddef->bed_elevation();
 
-  update_mask(bed_topography, ice_thickness, vMask);
+  update_changed_mask_and_surface(bed_topography, ice_thickness);
+
+  // Ice thickness added to partially filled cells. Values at ghost
+  // points are contributions to cells owned by neighboring
+  // processors.
+  IceModelVec2S &H_added = m_H_added;
+  H_added.set(0.0);
 
   // First step: distribute residual ice thickness
   {
     IceModelVec::AccessList list; // will be destroyed at the end of the block
     list.add(vMask);
     list.add(ice_thickness);
-    list.add(vHref);
+    list.add(H_added);
     list.add(H_residual);
     for (Points p(*m_grid); p; p.next()) {
       const int i = p.i(), j = p.j();
@@ -180,17 +194,18 @@ void IceModel::residual_redistribution_iteration(IceModelVec2S &H_residual, bool
         // Remaining ice mass will be redistributed equally among all
         // adjacent partially-filled cells (is there a more physical
         // way?)
+        const double share = H_residual(i, j) / N;
         if (neighbors.e) {
-          vHref(i + 1, j) += H_residual(i, j) / N;
+          H_added(i + 1, j) += share;
         }
         if (neighbors.w) {
-          vHref(i - 1, j) += H_residual(i, j) / N;
+          H_added(i - 1, j) += share;
         }
         if (neighbors.n) {
-          vHref(i, j + 1) += H_residual(i, j) / N;
+          H_added(i, j + 1) += share;
         }
         if (neighbors.s) {
-          vHref(i, j - 1) += H_residual(i, j) / N;
+          H_added(i, j - 1) += share;
         }
 
         H_residual(i, j) = 0.0;
@@ -204,12 +219,14 @@ void IceModel::residual_redistribution_iteration(IceModelVec2S &H_residual, bool
     }
   }
 
+  // add contributions to cells owned by neighbors
+  H_added.accumulate_ghosts();
+
   ice_thickness.update_ghosts();
 
-  // The loop above updated ice_thickness, so we need to re-calculate the mask:
-  update_mask(bed_topography, ice_thickness, vMask);
-  // and the surface elevation:
-  update_surface_elevation(bed_topography, ice_thickness, ice_surface_elevation);
+  // The loop above updated ice_thickness, so we need to re-calculate
+  // the mask and the surface elevation:
+  update_changed_mask_and_surface(bed_topography, ice_thickness);
 
   double remaining_residual_thickness = 0.0,
     remaining_residual_thickness_global    = 0.0;
@@ -222,9 +239,14 @@ void IceModel::residual_redistribution_iteration(IceModelVec2S &H_residual, bool
     list.add(ice_surface_elevation);
     list.add(bed_topography);
     list.add(vMask);
+    list.add(vHref);
+    list.add(H_added);
+    list.add(H_residual);
     for (Points p(*m_grid); p; p.next()) {
       const int i = p.i(), j = p.j();
 
+      vHref(i, j) += H_added(i, j);
+
       if (vHref(i,j) <= 0.0) {
         continue;
       }
@@ -136,7 +136,7 @@ This method should be kept because it is worth having alternative physics, and
 void IceModel::temperatureStep(unsigned int *vertSacrCount, unsigned int *bulgeCount) {
   PetscErrorCode  ierr;
 
-  bool viewOneColumn = options::Bool("-view_sys", "save column system information to a file");
+  const bool viewOneColumn = m_config->get_boolean("save_column_system");
 
   const double
     ice_density        = m_config->get_double("ice_density"),
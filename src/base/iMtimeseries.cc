@@ -216,6 +216,7 @@ void IceModel::init_extras() {
 
   bool split  = options::Bool("-extra_split", "Specifies whether to save to separate files");
   bool append = options::Bool("-extra_append", "append spatial diagnostics");
+  append_extra = append;
 
   if (extra_file.is_set() ^ times.is_set()) {
     throw RuntimeError("you need to specify both -extra_file and -extra_times to save spatial time-series.");
@@ -430,10 +431,8 @@ void IceModel::write_extras() {
 
   if (extra_file_is_ready == false) {
     // default behavior is to move the file aside if it exists already; option allows appending
-    bool append = options::Bool("-extra_append", "append -extra_file output");
-
     IO_Mode mode = PISM_READWRITE;
-    if (not append) {
+    if (not append_extra) {
       mode = PISM_READWRITE_MOVE;
     }
 
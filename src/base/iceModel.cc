@@ -87,12 +87,23 @@ IceModel::IceModel(IceGrid::Ptr g, Context::Ptr context)
 
   btu = NULL;
 
+  m_subcycling_levels = 0;
+  m_rate_class_dt     = -1.0;
+  m_rate_class_max    = 0;
+  m_subcycling_cfl_3d_warned = false;
+
   iceberg_remover             = NULL;
   ocean_kill_calving          = NULL;
   float_kill_calving          = NULL;
   thickness_threshold_calving = NULL;
   eigen_calving               = NULL;
 
+  m_geometry_sea_level       = 0.0;
+  m_geometry_mask_counter    = 0;
+  m_geometry_surface_counter = 0;
+  m_geometry_valid           = false;
+  m_geometry_mask_changed    = false;
+
   // initializr maximum |u|,|v|,|w| in ice
   gmaxu = 0;
   gmaxv = 0;
@@ -110,6 +121,7 @@ IceModel::IceModel(IceGrid::Ptr g, Context::Ptr context)
   // Do not save time-series by default:
   save_ts        = false;
   save_extra     = false;
+  append_extra   = false;
 
   reset_counters();
 }
@@ -358,6 +370,10 @@ void IceModel::createVecs() {
     vHref.set_attrs("model_state", "temporary ice thickness at calving front boundary",
                     "m", "");
     m_grid->variables().add(vHref);
+
+    m_H_added.create(m_grid, "H_added", WITH_GHOSTS);
+    m_H_added.set_attrs("internal", "ice thickness added to partially filled cells by residual redistribution",
+                        "m", "");
   }
 
   if (m_config->get_string("calving_methods").find("eigen_calving") != std::string::npos ||
@@ -653,10 +669,7 @@ void IceModel::step(bool do_mass_continuity,
                            melange_back_pressure);
     profiling.end("stress balance");
   } catch (RuntimeError &e) {
-    options::String output_file("-o", "output file name",
-                                "output.nc", options::DONT_ALLOW_EMPTY);
-
-    std::string o_file = pism_filename_add_suffix(output_file,
+    std::string o_file = pism_filename_add_suffix(output_filename,
                                                   "_stressbalance_failed", "");
     dumpToFile(o_file);
 
@@ -850,6 +863,8 @@ void IceModel::run() {
   // IceModel::step calls Time::step(dt), ensuring that this while loop
   // will terminate
   profiling.stage_begin("time-stepping loop");
+  // options should be processed during the initialization (see setFromOptions())
+  options::report_option_queries(true);
   while (m_time->current() < m_time->end()) {
 
     stdout_flags.erase();  // clear it out
@@ -862,18 +877,25 @@ void IceModel::run() {
     bool updateAtDepth = skipCountDown == 0;
     bool tempAgeStep = updateAtDepth && (do_energy || do_age);
 
-    const bool show_step = tempAgeStep || m_adaptive_timestep_reason == "end of the run";
+    // note: the reason may be followed by the list of mass continuity rate classes
+    const bool show_step = tempAgeStep || m_adaptive_timestep_reason.find("end of the run") == 0;
     summary(show_step);
 
-    // writing these fields here ensures that we do it after the last time-step
-    profiling.begin("I/O during run");
-    write_snapshot();
-    write_timeseries();
-    write_extras();
-    write_backup();
-    profiling.end("I/O during run");
+    {
+      // The model state does not change until the next step, so diagnostic
+      // quantities can be shared by all the output code below.
+      DiagnosticCache::Scope diagnostic_cache(m_ctx->diagnostic_cache());
+
+      // writing these fields here ensures that we do it after the last time-step
+      profiling.begin("I/O during run");
+      write_snapshot();
+      write_timeseries();
+      write_extras();
+      write_backup();
+      profiling.end("I/O during run");
 
-    update_viewers();
+      update_viewers();
+    }
 
     if (stepcount >= 0) {
       stepcount++;
@@ -882,6 +904,7 @@ void IceModel::run() {
       break;
     }
   } // end of the time-stepping loop
+  options::report_option_queries(false);
 
   profiling.stage_end("time-stepping loop");
 
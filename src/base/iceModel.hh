@@ -40,6 +40,7 @@
 
 // IceModel owns a bunch of fields, so we have to include this.
 #include "base/util/iceModelVec.hh"
+#include "base/util/Mask.hh"
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/Context.hh"
 #include "base/util/Logger.hh"
@@ -287,6 +288,13 @@ protected:
   IceModelVec2Int vMask, //!< \brief mask for flow type with values ice_free_bedrock,
   //!< grounded_ice, floating_ice, ice_free_ocean
     vBCMask; //!< mask to determine Dirichlet boundary locations
+
+  //! icy grid points owned by this processor; see updateSurfaceElevationAndMask()
+  IcyColumns m_icy_columns;
+
+  //! ice thickness added to partially filled cells by residual_redistribution_iteration();
+  //! ghosts hold contributions to cells owned by neighboring processors
+  IceModelVec2S m_H_added;
  
   IceModelVec2V vBCvel; //!< Dirichlet boundary velocities
   
@@ -335,6 +343,7 @@ protected:
   virtual void max_timestep(double &dt_result, unsigned int &skip_counter);
   virtual unsigned int countCFLViolations();
   virtual unsigned int skip_counter(double input_dt, double input_dt_diffusivity);
+  virtual void mass_continuity_rate_classes(double time_step);
 
   // see iMage.cc
   virtual void ageStep();
@@ -361,6 +370,8 @@ protected:
 
   // see iMgeometry.cc
   virtual void updateSurfaceElevationAndMask();
+  virtual void update_changed_mask_and_surface(const IceModelVec2S &bed,
+                                               const IceModelVec2S &ice_thickness);
   virtual void update_mask(const IceModelVec2S &bed,
                            const IceModelVec2S &ice_thickness,
                            IceModelVec2Int &mask);
@@ -377,6 +388,7 @@ protected:
                            StarStencil<double> &SSA_velocity,
                            StarStencil<double> &SIA_flux);
   virtual void massContExplicitStep();
+  virtual void subcycled_advective_divergence(bool dirichlet_bc, IceModelVec2S &result);
   virtual void update_floatation_mask();
   virtual void do_calving();
   virtual void Href_cleanup();
@@ -451,6 +463,33 @@ protected:
   // 3D working space
   IceModelVec3 vWork3d;
 
+  // storage used by the subcycled advective part of the mass continuity step
+  // (allocated if mass_continuity_subcycling_levels > 0)
+  unsigned int m_subcycling_levels;
+  IceModelVec2Int m_rate_class;
+  //! time step length used to compute m_rate_class
+  double m_rate_class_dt;
+  //! largest rate class in use
+  unsigned int m_rate_class_max;
+  //! number of icy cells in each rate class
+  std::vector<double> m_rate_class_counts;
+  //! true if the user was warned that the 3D CFL condition limits subcycled time steps
+  bool m_subcycling_cfl_3d_warned;
+  IceModelVec2S m_subcycled_thickness;
+  IceModelVec2S m_subcycled_divergence;
+  //! velocities through the east, west, north and south interfaces of each cell
+  IceModelVec2 m_face_velocity;
+
+  // bed elevation, ice thickness and sea level used by the last call of
+  // update_changed_mask_and_surface()
+  IceModelVec2S m_geometry_bed;
+  IceModelVec2S m_geometry_thickness;
+  double m_geometry_sea_level;
+  int m_geometry_mask_counter, m_geometry_surface_counter;
+  bool m_geometry_valid;
+  // true if the mask changed since the last updateSurfaceElevationAndMask() call
+  bool m_geometry_mask_changed;
+
   stressbalance::StressBalance *stress_balance;
 
 public:
@@ -484,7 +523,7 @@ protected:
   MaxTimestep ts_max_timestep(double my_t);
 
   // spatially-varying time-series
-  bool save_extra, extra_file_is_ready, split_extra;
+  bool save_extra, extra_file_is_ready, split_extra, append_extra;
   std::string extra_filename;
   std::vector<double> extra_times;
   unsigned int next_extra;
@@ -503,6 +542,9 @@ protected:
   std::set<std::string> backup_vars;
   void init_backups();
   void write_backup();
+  std::string checkpoint_prefix(const std::string &filename);
+  std::vector<IceModelVec*> checkpoint_fields();
+  void init_from_checkpoint(const std::string &prefix);
 
   // last time at which PISM hit a multiple of X years, see the
   // timestep_hit_multiples configuration parameter
@@ -514,6 +556,7 @@ protected:
   virtual void view_field(const IceModelVec *field);
   std::set<std::string> map_viewers, slice_viewers;
   int     id, jd;            // sounding indexes
+  std::string output_filename; // output file name set using -o (or "output.nc")
   std::map<std::string,petsc::Viewer::Ptr> viewers;
 
 private:
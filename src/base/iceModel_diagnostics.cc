@@ -321,7 +321,7 @@ IceModel_hardav::IceModel_hardav(IceModel *m)
 }
 
 //! \brief Computes vertically-averaged ice hardness.
-IceModelVec::Ptr IceModel_hardav::compute() {
+IceModelVec::Ptr IceModel_hardav::compute_impl() {
   const double fillval = m_grid->ctx()->config()->get_double("fill_value");
   double *Eij; // columns of enthalpy values
 
@@ -377,7 +377,7 @@ IceModel_rank::IceModel_rank(IceModel *m)
   m_vars[0].set_time_independent(true);
 }
 
-IceModelVec::Ptr IceModel_rank::compute() {
+IceModelVec::Ptr IceModel_rank::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "rank", WITHOUT_GHOSTS);
@@ -404,7 +404,7 @@ IceModel_cts::IceModel_cts(IceModel *m)
             "", "", 0);
 }
 
-IceModelVec::Ptr IceModel_cts::compute() {
+IceModelVec::Ptr IceModel_cts::compute_impl() {
 
   // update vertical levels (in case the grid was extended
   m_vars[0].set_levels(m_grid->z());
@@ -429,7 +429,7 @@ IceModel_proc_ice_area::IceModel_proc_ice_area(IceModel *m)
   m_vars[0].set_time_independent(true);
 }
 
-IceModelVec::Ptr IceModel_proc_ice_area::compute() {
+IceModelVec::Ptr IceModel_proc_ice_area::compute_impl() {
 
   const IceModelVec2S *thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
   const IceModelVec2Int *ice_mask = m_grid->variables().get_2d_mask("mask");
@@ -469,7 +469,7 @@ IceModel_temp::IceModel_temp(IceModel *m)
   m_vars[0].set_double("valid_min", 0);
 }
 
-IceModelVec::Ptr IceModel_temp::compute() {
+IceModelVec::Ptr IceModel_temp::compute_impl() {
 
   // update vertical levels (in case the grid was extended
   m_vars[0].set_levels(m_grid->z());
@@ -486,6 +486,10 @@ IceModelVec::Ptr IceModel_temp::compute() {
   double *Tij;
   const double *Enthij; // columns of these values
 
+  const unsigned int Mz = m_grid->Mz();
+  const std::vector<double> &z = m_grid->z();
+  std::vector<double> depth(Mz), pressure(Mz);
+
   IceModelVec::AccessList list;
   list.add(*result);
   list.add(*enthalpy);
@@ -498,10 +502,11 @@ IceModelVec::Ptr IceModel_temp::compute() {
 
       Tij = result->get_column(i,j);
       Enthij = enthalpy->get_column(i,j);
-      for (unsigned int k=0; k <m_grid->Mz(); ++k) {
-        const double depth = (*thickness)(i,j) - m_grid->z(k);
-        Tij[k] = EC->temperature(Enthij[k], EC->pressure(depth));
+      for (unsigned int k=0; k < Mz; ++k) {
+        depth[k] = (*thickness)(i,j) - z[k];
       }
+      EC->pressure_n(&depth[0], &pressure[0], Mz);
+      EC->temperature_n(Enthij, &pressure[0], Tij, Mz);
     }
   } catch (...) {
     loop.failed();
@@ -523,7 +528,7 @@ IceModel_temp_pa::IceModel_temp_pa(IceModel *m)
   m_vars[0].set_double("valid_max", 0);
 }
 
-IceModelVec::Ptr IceModel_temp_pa::compute() {
+IceModelVec::Ptr IceModel_temp_pa::compute_impl() {
   bool cold_mode = m_grid->ctx()->config()->get_boolean("do_cold_ice_methods");
   double melting_point_temp = m_grid->ctx()->config()->get_double("water_melting_point_temperature");
 
@@ -588,7 +593,7 @@ IceModel_temppabase::IceModel_temppabase(IceModel *m)
             "Celsius", "Celsius", 0);
 }
 
-IceModelVec::Ptr IceModel_temppabase::compute() {
+IceModelVec::Ptr IceModel_temppabase::compute_impl() {
 
   bool cold_mode = m_grid->ctx()->config()->get_boolean("do_cold_ice_methods");
   double melting_point_temp = m_grid->ctx()->config()->get_double("water_melting_point_temperature");
@@ -648,7 +653,7 @@ IceModel_enthalpysurf::IceModel_enthalpysurf(IceModel *m)
   m_vars[0].set_double("_FillValue", m_grid->ctx()->config()->get_double("fill_value"));
 }
 
-IceModelVec::Ptr IceModel_enthalpysurf::compute() {
+IceModelVec::Ptr IceModel_enthalpysurf::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "enthalpysurf", WITHOUT_GHOSTS);
@@ -692,7 +697,7 @@ IceModel_enthalpybase::IceModel_enthalpybase(IceModel *m)
   m_vars[0].set_double("_FillValue", m_grid->ctx()->config()->get_double("fill_value"));
 }
 
-IceModelVec::Ptr IceModel_enthalpybase::compute() {
+IceModelVec::Ptr IceModel_enthalpybase::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "enthalpybase", WITHOUT_GHOSTS);
@@ -717,23 +722,24 @@ IceModel_tempbase::IceModel_tempbase(IceModel *m)
   m_vars[0].set_double("_FillValue", m_grid->ctx()->config()->get_double("fill_value"));
 }
 
-IceModelVec::Ptr IceModel_tempbase::compute() {
+IceModelVec::Ptr IceModel_tempbase::compute_impl() {
 
   const IceModelVec2S *thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
-  IceModelVec::Ptr enth = IceModel_enthalpybase(model).compute();
+  // basal enthalpy; this field may be shared with other diagnostics (see
+  // DiagnosticCache), so it is treated as read-only here
+  IceModelVec2S::Ptr enth = IceModelVec2S::To2DScalar(IceModel_enthalpybase(model).compute());
 
   EnthalpyConverter::Ptr EC = model->ctx()->enthalpy_converter();
 
-  IceModelVec2S::Ptr result = IceModelVec2S::To2DScalar(enth);
-
-  // result contains basal enthalpy; note that it is allocated by
-  // IceModel_enthalpybase::compute().
+  IceModelVec2S::Ptr result(new IceModelVec2S);
+  result->create(m_grid, "tempbase", WITHOUT_GHOSTS);
 
   MaskQuery mask(model->vMask);
 
   IceModelVec::AccessList list;
   list.add(model->vMask);
+  list.add(*enth);
   list.add(*result);
   list.add(*thickness);
 
@@ -745,7 +751,7 @@ IceModelVec::Ptr IceModel_tempbase::compute() {
       double depth = (*thickness)(i,j),
         pressure = EC->pressure(depth);
       if (mask.icy(i, j)) {
-        (*result)(i,j) = EC->temperature((*result)(i,j), pressure);
+        (*result)(i,j) = EC->temperature((*enth)(i,j), pressure);
       } else {
         (*result)(i,j) = m_grid->ctx()->config()->get_double("fill_value");
       }
@@ -770,19 +776,20 @@ IceModel_tempsurf::IceModel_tempsurf(IceModel *m)
   m_vars[0].set_double("_FillValue", m_grid->ctx()->config()->get_double("fill_value"));
 }
 
-IceModelVec::Ptr IceModel_tempsurf::compute() {
+IceModelVec::Ptr IceModel_tempsurf::compute_impl() {
 
   const IceModelVec2S *thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
-  IceModelVec::Ptr enth = IceModel_enthalpysurf(model).compute();
-  IceModelVec2S::Ptr result = IceModelVec2S::To2DScalar(enth);
+  // surface enthalpy; treated as read-only (see IceModel_tempbase)
+  IceModelVec2S::Ptr enth = IceModelVec2S::To2DScalar(IceModel_enthalpysurf(model).compute());
 
-  EnthalpyConverter::Ptr EC = model->ctx()->enthalpy_converter();
+  IceModelVec2S::Ptr result(new IceModelVec2S);
+  result->create(m_grid, "tempsurf", WITHOUT_GHOSTS);
 
-  // result contains surface enthalpy; note that it is allocated by
-  // IceModel_enthalpysurf::compute().
+  EnthalpyConverter::Ptr EC = model->ctx()->enthalpy_converter();
 
   IceModelVec::AccessList list;
+  list.add(*enth);
   list.add(*result);
   list.add(*thickness);
 
@@ -794,7 +801,7 @@ IceModelVec::Ptr IceModel_tempsurf::compute() {
       const int i = p.i(), j = p.j();
 
       if ((*thickness)(i,j) > 1) {
-        (*result)(i,j) = EC->temperature((*result)(i,j), pressure);
+        (*result)(i,j) = EC->temperature((*enth)(i,j), pressure);
       } else {
         (*result)(i,j) = m_grid->ctx()->config()->get_double("fill_value");
       }
@@ -822,7 +829,7 @@ IceModel_liqfrac::IceModel_liqfrac(IceModel *m)
   m_vars[0].set_double("valid_max", 1);
 }
 
-IceModelVec::Ptr IceModel_liqfrac::compute() {
+IceModelVec::Ptr IceModel_liqfrac::compute_impl() {
 
   IceModelVec3::Ptr result(new IceModelVec3);
   result->create(m_grid, "liqfrac", WITHOUT_GHOSTS);
@@ -851,7 +858,7 @@ IceModel_tempicethk::IceModel_tempicethk(IceModel *m)
   m_vars[0].set_double("_FillValue", m_grid->ctx()->config()->get_double("fill_value"));
 }
 
-IceModelVec::Ptr IceModel_tempicethk::compute() {
+IceModelVec::Ptr IceModel_tempicethk::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "tempicethk", WITHOUT_GHOSTS);
@@ -922,7 +929,7 @@ IceModel_tempicethk_basal::IceModel_tempicethk_basal(IceModel *m)
 /*!
  * Uses linear interpolation to go beyond vertical grid resolution.
  */
-IceModelVec::Ptr IceModel_tempicethk_basal::compute() {
+IceModelVec::Ptr IceModel_tempicethk_basal::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "tempicethk_basal", WITHOUT_GHOSTS);
@@ -1023,7 +1030,7 @@ IceModel_flux_divergence::IceModel_flux_divergence(IceModel *m)
   set_attrs("flux divergence", "", "m s-1", "m year-1", 0);
 }
 
-IceModelVec::Ptr IceModel_flux_divergence::compute() {
+IceModelVec::Ptr IceModel_flux_divergence::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "flux_divergence", WITHOUT_GHOSTS);
@@ -1046,7 +1053,7 @@ IceModel_climatic_mass_balance_cumulative::IceModel_climatic_mass_balance_cumula
             "kg m-2", "kg m-2", 0);
 }
 
-IceModelVec::Ptr IceModel_climatic_mass_balance_cumulative::compute() {
+IceModelVec::Ptr IceModel_climatic_mass_balance_cumulative::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "climatic_mass_balance_cumulative", WITHOUT_GHOSTS);
@@ -1564,7 +1571,7 @@ IceModel_dHdt::IceModel_dHdt(IceModel *m)
   last_report_time = GSL_NAN;
 }
 
-IceModelVec::Ptr IceModel_dHdt::compute() {
+IceModelVec::Ptr IceModel_dHdt::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "dHdt", WITHOUT_GHOSTS);
@@ -1775,7 +1782,7 @@ IceModel_nonneg_flux_2D_cumulative::IceModel_nonneg_flux_2D_cumulative(IceModel
   m_vars[0].set_string("comment", "positive means ice gain");
 }
 
-IceModelVec::Ptr IceModel_nonneg_flux_2D_cumulative::compute() {
+IceModelVec::Ptr IceModel_nonneg_flux_2D_cumulative::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "nonneg_flux_cumulative", WITHOUT_GHOSTS);
@@ -1800,7 +1807,7 @@ IceModel_grounded_basal_flux_2D_cumulative::IceModel_grounded_basal_flux_2D_cumu
   m_vars[0].set_string("comment", "positive means ice gain");
 }
 
-IceModelVec::Ptr IceModel_grounded_basal_flux_2D_cumulative::compute() {
+IceModelVec::Ptr IceModel_grounded_basal_flux_2D_cumulative::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "grounded_basal_flux_cumulative", WITHOUT_GHOSTS);
@@ -1824,7 +1831,7 @@ IceModel_floating_basal_flux_2D_cumulative::IceModel_floating_basal_flux_2D_cumu
   m_vars[0].set_string("comment", "positive means ice gain");
 }
 
-IceModelVec::Ptr IceModel_floating_basal_flux_2D_cumulative::compute() {
+IceModelVec::Ptr IceModel_floating_basal_flux_2D_cumulative::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "floating_basal_flux_cumulative", WITHOUT_GHOSTS);
@@ -1850,7 +1857,7 @@ IceModel_discharge_flux_2D_cumulative::IceModel_discharge_flux_2D_cumulative(Ice
   m_vars[0].set_string("comment", "positive means ice gain");
 }
 
-IceModelVec::Ptr IceModel_discharge_flux_2D_cumulative::compute() {
+IceModelVec::Ptr IceModel_discharge_flux_2D_cumulative::compute_impl() {
 
   IceModelVec2S::Ptr result(new IceModelVec2S);
   result->create(m_grid, "discharge_flux_cumulative", WITHOUT_GHOSTS);
@@ -1911,7 +1918,7 @@ IceModel_lat_lon_bounds::~IceModel_lat_lon_bounds() {
   pj_free(lonlat);
 }
 
-IceModelVec::Ptr IceModel_lat_lon_bounds::compute() {
+IceModelVec::Ptr IceModel_lat_lon_bounds::compute_impl() {
 
   std::map<std::string,std::string> attrs;
   std::vector<double> indices(4);
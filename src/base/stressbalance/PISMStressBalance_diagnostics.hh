@@ -30,7 +30,8 @@ class PSB_velbar : public Diag<StressBalance>
 {
 public:
   PSB_velbar(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes velbar_mag, the magnitude of vertically-integrated horizontal
@@ -39,7 +40,8 @@ class PSB_velbar_mag : public Diag<StressBalance>
 {
 public:
   PSB_velbar_mag(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes uflux and vflux, components of vertically-integrated horizontal
@@ -48,7 +50,8 @@ class PSB_flux : public Diag<StressBalance>
 {
 public:
   PSB_flux(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes flux_mag, the magnitude of vertically-integrated horizontal
@@ -57,7 +60,8 @@ class PSB_flux_mag : public Diag<StressBalance>
 {
 public:
   PSB_flux_mag(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes velbase_mag, the magnitude of horizontal velocity of ice at base
@@ -66,7 +70,8 @@ class PSB_velbase_mag : public Diag<StressBalance>
 {
 public:
   PSB_velbase_mag(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes velsurf_mag, the magnitude of horizontal ice velocity at the
@@ -75,7 +80,8 @@ class PSB_velsurf_mag : public Diag<StressBalance>
 {
 public:
   PSB_velsurf_mag(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes velsurf, the horizontal velocity of ice at ice surface.
@@ -83,7 +89,8 @@ class PSB_velsurf : public Diag<StressBalance>
 {
 public:
   PSB_velsurf(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! Computes vertical ice velocity (relative to the geoid).
@@ -102,7 +109,8 @@ class PSB_wvel : public Diag<StressBalance>
 {
 public:
   PSB_wvel(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! Computes wvelsurf, the vertical velocity of ice at ice surface.
@@ -110,7 +118,8 @@ class PSB_wvelsurf : public Diag<StressBalance>
 {
 public:
   PSB_wvelsurf(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! Computes wvelbase, the vertical velocity of ice at the base of ice.
@@ -118,7 +127,8 @@ class PSB_wvelbase : public Diag<StressBalance>
 {
 public:
   PSB_wvelbase(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes horizontal ice velocity at the base of ice.
@@ -126,7 +136,8 @@ class PSB_velbase : public Diag<StressBalance>
 {
 public:
   PSB_velbase(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes basal frictional heating.
@@ -134,7 +145,8 @@ class PSB_bfrict : public Diag<StressBalance>
 {
 public:
   PSB_bfrict(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes the x-component of the horizontal ice velocity.
@@ -142,7 +154,8 @@ class PSB_uvel : public Diag<StressBalance>
 {
 public:
   PSB_uvel(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes the y-component of the horizontal ice velocity.
@@ -150,7 +163,8 @@ class PSB_vvel : public Diag<StressBalance>
 {
 public:
   PSB_vvel(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Computes vertical velocity of ice, relative to the bed directly
@@ -159,7 +173,8 @@ class PSB_wvel_rel : public Diag<StressBalance>
 {
 public:
   PSB_wvel_rel(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the volumetric strain heating (3D).
@@ -167,7 +182,8 @@ class PSB_strainheat : public Diag<StressBalance>
 {
 public:
   PSB_strainheat(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the vertically-integrated (2D) principal strain rates.
@@ -175,7 +191,8 @@ class PSB_strain_rates : public Diag<StressBalance>
 {
 public:
   PSB_strain_rates(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the vertically-integrated (2D) deviatoric stresses.
@@ -183,7 +200,8 @@ class PSB_deviatoric_stresses : public Diag<StressBalance>
 {
 public:
   PSB_deviatoric_stresses(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the pressure within the ice (3D).
@@ -191,7 +209,8 @@ class PSB_pressure : public Diag<StressBalance>
 {
 public:
   PSB_pressure(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the xz component of the shear stress within the ice (3D), according to the SIA formula.
@@ -199,7 +218,8 @@ class PSB_tauxz : public Diag<StressBalance>
 {
 public:
   PSB_tauxz(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! \brief Reports the yz component of the shear stress within the ice (3D), according to the SIA formula.
@@ -207,7 +227,8 @@ class PSB_tauyz : public Diag<StressBalance>
 {
 public:
   PSB_tauyz(StressBalance *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 
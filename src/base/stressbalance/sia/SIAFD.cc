@@ -26,6 +26,7 @@
 #include "base/util/Mask.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/error_handling.hh"
+#include "base/util/pism_threads.hh"
 #include "base/util/pism_const.hh"
 #include "base/util/Profiling.hh"
 
@@ -56,12 +57,16 @@ SIAFD::SIAFD(IceGrid::ConstPtr g, EnthalpyConverter::Ptr e)
     }
   }
 
-  m_delta[0].create(m_grid, "delta_0", WITH_GHOSTS);
-  m_delta[1].create(m_grid, "delta_1", WITH_GHOSTS);
+  m_streaming = m_config->get_boolean("sia_streaming");
 
-  // 3D temporary storage:
-  m_work_3d[0].create(m_grid, "work_3d_0", WITH_GHOSTS);
-  m_work_3d[1].create(m_grid, "work_3d_1", WITH_GHOSTS);
+  if (not m_streaming) {
+    m_delta[0].create(m_grid, "delta_0", WITH_GHOSTS);
+    m_delta[1].create(m_grid, "delta_1", WITH_GHOSTS);
+
+    // 3D temporary storage:
+    m_work_3d[0].create(m_grid, "work_3d_0", WITH_GHOSTS);
+    m_work_3d[1].create(m_grid, "work_3d_1", WITH_GHOSTS);
+  }
 
   // bed smoother
   m_bed_smoother = new BedSmoother(m_grid, WIDE_STENCIL);
@@ -92,6 +97,11 @@ void SIAFD::init() {
   m_log->message(2,
              "  [using the %s flow law]\n", m_flow_law->name().c_str());
 
+  if (m_streaming) {
+    m_log->message(2,
+               "  [computing 3D velocities without storing delta and I]\n");
+  }
+
   // set bed_state_counter to -1 so that the smoothed bed is computed the first
   // time update() is called.
   m_bed_state_counter = -1;
@@ -142,7 +152,11 @@ void SIAFD::update(const IceModelVec2V &vel_input, bool fast) {
 
   if (!fast) {
     profiling.begin("SIA 3D hor. vel.");
-    compute_3d_horizontal_velocity(h_x, h_y, vel_input, m_u, m_v);
+    if (m_streaming) {
+      compute_3d_horizontal_velocity_streaming(h_x, h_y, vel_input, m_u, m_v);
+    } else {
+      compute_3d_horizontal_velocity(h_x, h_y, vel_input, m_u, m_v);
+    }
     profiling.end("SIA 3D hor. vel.");
   }
 }
@@ -545,6 +559,98 @@ void SIAFD::surface_gradient_haseloff(IceModelVec2Stag &h_x, IceModelVec2Stag &h
  */
 void SIAFD::compute_diffusive_flux(const IceModelVec2Stag &h_x, const IceModelVec2Stag &h_y,
                                    IceModelVec2Stag &result, bool fast) {
+
+  // delta is not stored in the streaming mode
+  const bool full_update = (fast == false) and (not m_streaming);
+
+  result.set(0.0);
+
+  DeltaInputs inputs = prepare_delta_inputs(h_x, h_y);
+
+  IceModelVec::AccessList list;
+  list.add(*inputs.theta);
+  list.add(*inputs.thk_smooth);
+  list.add(result);
+
+  list.add(h_x);
+  list.add(h_y);
+
+  if (inputs.age != NULL) {
+    list.add(*inputs.age);
+  }
+
+  if (full_update) {
+    list.add(m_delta[0]);
+    list.add(m_delta[1]);
+    assert(m_delta[0].get_stencil_width()  >= 1);
+    assert(m_delta[1].get_stencil_width()  >= 1);
+  }
+
+  list.add(*inputs.enthalpy);
+
+  assert(result.get_stencil_width()     >= 1);
+
+  double my_D_max = 0.0;
+  for (int o=0; o<2; o++) {
+    ParallelSection loop(m_grid->com);
+    PISM_OMP_PARALLEL
+    {
+      std::vector<double> delta_ij(m_grid->Mz());
+      double thread_D_max = 0.0;
+
+      try {
+        for (ThreadPoints p(*m_grid, 1); p; p.next()) {
+          const int i = p.i(), j = p.j();
+
+          double Dfoffset = compute_delta(i, j, o, inputs, delta_ij);
+
+          // Override diffusivity at the edges of the domain. (At these
+          // locations PISM uses ghost cells *beyond* the boundary of
+          // the computational domain. This does not matter if the ice
+          // does not extend all the way to the domain boundary, as in
+          // whole-ice-sheet simulations. In a regional setup, though,
+          // this adjustment lets us avoid taking very small time-steps
+          // because of the possible thickness and bed elevation
+          // "discontinuities" at the boundary.)
+          if (i < 0 || i >= (int)m_grid->Mx() - 1 ||
+              j < 0 || j >= (int)m_grid->My() - 1) {
+            Dfoffset = 0.0;
+          }
+
+          thread_D_max = std::max(thread_D_max, Dfoffset);
+
+          // vertically-averaged SIA-only flux, sans sliding; note
+          //   result(i,j,0) is  u  at E (east)  staggered point (i+1/2,j)
+          //   result(i,j,1) is  v  at N (north) staggered point (i,j+1/2)
+          const double slope = (o==0) ? h_x(i,j,o) : h_y(i,j,o);
+          result(i,j,o) = - Dfoffset * slope;
+
+          // if doing the full update, store the delta column
+          if (full_update) {
+            m_delta[o].set_column(i,j,&delta_ij[0]);
+          }
+        } // i,j-loop
+      } catch (...) {
+        loop.failed();
+      }
+
+      PISM_OMP_CRITICAL
+      {
+        my_D_max = std::max(my_D_max, thread_D_max);
+      }
+    }
+    loop.check();
+  } // o-loop
+
+  m_D_max = GlobalMax(m_grid->com, my_D_max);
+}
+
+//! \brief Prepare inputs of compute_delta(), including theta and the smoothed thickness.
+/*!
+ * Uses m_work_2d[0] to store the smoothed thickness and m_work_2d[1] to store theta.
+ */
+SIAFD::DeltaInputs SIAFD::prepare_delta_inputs(const IceModelVec2Stag &h_x,
+                                               const IceModelVec2Stag &h_y) {
   IceModelVec2S
     &thk_smooth = m_work_2d[0],
     &theta      = m_work_2d[1];
@@ -555,15 +661,6 @@ void SIAFD::compute_diffusive_flux(const IceModelVec2Stag &h_x, const IceModelVe
 
   const IceModelVec2Int *mask = m_grid->variables().get_2d_mask("mask");
 
-  bool full_update = (fast == false);
-
-  result.set(0.0);
-
-  std::vector<double> delta_ij(m_grid->Mz());
-
-  const double enhancement_factor = m_flow_law->enhancement_factor();
-  double ice_grain_size = m_config->get_double("ice_grain_size");
-
   bool compute_grain_size_using_age = m_config->get_boolean("compute_grain_size_using_age");
 
   // some flow laws use grain size, and even need age to update grain size
@@ -583,142 +680,110 @@ void SIAFD::compute_diffusive_flux(const IceModelVec2Stag &h_x, const IceModelVe
 
   m_bed_smoother->get_smoothed_thk(h, H, *mask, thk_smooth);
 
-  IceModelVec::AccessList list;
-  list.add(theta);
-  list.add(thk_smooth);
-  list.add(result);
-
-  list.add(h_x);
-  list.add(h_y);
-
-  const IceModelVec3 *age = NULL;
-  if (use_age) {
-    age = m_grid->variables().get_3d_scalar("age");
-    list.add(*age);
-  }
-
-  if (full_update) {
-    list.add(m_delta[0]);
-    list.add(m_delta[1]);
-  }
-
-  const IceModelVec3 &enthalpy = *m_grid->variables().get_3d_scalar("enthalpy");
-  list.add(enthalpy);
+  DeltaInputs result;
+  result.thk_smooth         = &thk_smooth;
+  result.theta              = &theta;
+  result.h_x                = &h_x;
+  result.h_y                = &h_y;
+  result.enthalpy           = m_grid->variables().get_3d_scalar("enthalpy");
+  result.age                = use_age ? m_grid->variables().get_3d_scalar("age") : NULL;
+  result.enhancement_factor = m_flow_law->enhancement_factor();
+  result.ice_grain_size     = m_config->get_double("ice_grain_size");
 
   assert(theta.get_stencil_width()      >= 2);
   assert(thk_smooth.get_stencil_width() >= 2);
-  assert(result.get_stencil_width()     >= 1);
   assert(h_x.get_stencil_width()        >= 1);
   assert(h_y.get_stencil_width()        >= 1);
   if (use_age) {
-    assert(age->get_stencil_width() >= 2);
+    assert(result.age->get_stencil_width() >= 2);
   }
-  assert(enthalpy.get_stencil_width() >= 2);
-  assert(m_delta[0].get_stencil_width()  >= 1);
-  assert(m_delta[1].get_stencil_width()  >= 1);
+  assert(result.enthalpy->get_stencil_width() >= 2);
 
-  double my_D_max = 0.0;
-  for (int o=0; o<2; o++) {
-    ParallelSection loop(m_grid->com);
-    try {
-      for (PointsWithGhosts p(*m_grid); p; p.next()) {
-        const int i = p.i(), j = p.j();
-
-        // staggered point: o=0 is i+1/2, o=1 is j+1/2, (i,j) and (i+oi,j+oj)
-        //   are regular grid neighbors of a staggered point:
-        const int oi = 1 - o, oj = o;
-
-        const double
-          thk = 0.5 * (thk_smooth(i,j) + thk_smooth(i+oi,j+oj));
-
-        // zero thickness case:
-        if (thk == 0.0) {
-          result(i,j,o) = 0.0;
-          if (full_update) {
-            m_delta[o].set_column(i, j, 0.0);
-          }
-          continue;
-        }
+  return result;
+}
 
-        const double *age_ij = NULL, *age_offset = NULL;
-        if (use_age) {
-          age_ij     = age->get_column(i, j);
-          age_offset = age->get_column(i+oi, j+oj);
-        }
+//! \brief Compute delta in the column at the staggered grid point (i,j,o).
+/*!
+ * Fills `delta` (the part above the ice is set to zero) and returns the
+ * diffusivity \f$D = \int_b^h\delta(z)(h-z)dz\f$ at this point. See
+ * compute_diffusive_flux().
+ *
+ * Fields in `inputs` have to be accessible (see IceModelVec::AccessList).
+ */
+double SIAFD::compute_delta(int i, int j, int o, const DeltaInputs &inputs,
+                            std::vector<double> &delta) {
+  const IceModelVec2S
+    &thk_smooth = *inputs.thk_smooth,
+    &theta      = *inputs.theta;
+  const IceModelVec2Stag
+    &h_x = *inputs.h_x,
+    &h_y = *inputs.h_y;
 
-        const double
-          *E_ij     = enthalpy.get_column(i, j),
-          *E_offset = enthalpy.get_column(i+oi, j+oj);
-
-        const double slope = (o==0) ? h_x(i,j,o) : h_y(i,j,o);
-        const int      ks = m_grid->kBelowHeight(thk);
-        const double   alpha =
-          sqrt(PetscSqr(h_x(i,j,o)) + PetscSqr(h_y(i,j,o)));
-        const double theta_local = 0.5 * (theta(i,j) + theta(i+oi,j+oj));
-
-        double  Dfoffset = 0.0;  // diffusivity for deformational SIA flow
-        for (int k = 0; k <= ks; ++k) {
-          double depth = thk - m_grid->z(k); // FIXME issue #15
-          // pressure added by the ice (i.e. pressure difference between the
-          // current level and the top of the column)
-          const double pressure = m_EC->pressure(depth);
-
-          double flow;
-          if (use_age) {
-            ice_grain_size = grainSizeVostok(0.5 * (age_ij[k] + age_offset[k]));
-          }
-          // If the flow law does not use grain size, it will just ignore it,
-          // no harm there
-          double E = 0.5 * (E_ij[k] + E_offset[k]);
-          flow = m_flow_law->flow(alpha * pressure, E, pressure, ice_grain_size);
+  // staggered point: o=0 is i+1/2, o=1 is j+1/2, (i,j) and (i+oi,j+oj)
+  //   are regular grid neighbors of a staggered point:
+  const int oi = 1 - o, oj = o;
 
-          delta_ij[k] = enhancement_factor * theta_local * 2.0 * pressure * flow;
+  const double
+    thk = 0.5 * (thk_smooth(i,j) + thk_smooth(i+oi,j+oj));
 
-          if (k > 0) { // trapezoidal rule
-            const double dz = m_grid->z(k) - m_grid->z(k-1);
-            Dfoffset += 0.5 * dz * ((depth + dz) * delta_ij[k-1] + depth * delta_ij[k]);
-          }
-        }
-        // finish off D with (1/2) dz (0 + (H-z[ks])*delta_ij[ks]), but dz=H-z[ks]:
-        const double dz = thk - m_grid->z(ks);
-        Dfoffset += 0.5 * dz * dz * delta_ij[ks];
+  // zero thickness case:
+  if (thk == 0.0) {
+    for (unsigned int k = 0; k < m_grid->Mz(); ++k) {
+      delta[k] = 0.0;
+    }
+    return 0.0;
+  }
 
-        // Override diffusivity at the edges of the domain. (At these
-        // locations PISM uses ghost cells *beyond* the boundary of
-        // the computational domain. This does not matter if the ice
-        // does not extend all the way to the domain boundary, as in
-        // whole-ice-sheet simulations. In a regional setup, though,
-        // this adjustment lets us avoid taking very small time-steps
-        // because of the possible thickness and bed elevation
-        // "discontinuities" at the boundary.)
-        if (i < 0 || i >= (int)m_grid->Mx() - 1 ||
-            j < 0 || j >= (int)m_grid->My() - 1) {
-          Dfoffset = 0.0;
-        }
+  const double *age_ij = NULL, *age_offset = NULL;
+  if (inputs.age != NULL) {
+    age_ij     = inputs.age->get_column(i, j);
+    age_offset = inputs.age->get_column(i+oi, j+oj);
+  }
 
-        my_D_max = std::max(my_D_max, Dfoffset);
+  const double
+    *E_ij     = inputs.enthalpy->get_column(i, j),
+    *E_offset = inputs.enthalpy->get_column(i+oi, j+oj);
+
+  const int      ks = m_grid->kBelowHeight(thk);
+  const double   alpha =
+    sqrt(PetscSqr(h_x(i,j,o)) + PetscSqr(h_y(i,j,o)));
+  const double theta_local = 0.5 * (theta(i,j) + theta(i+oi,j+oj));
+
+  double ice_grain_size = inputs.ice_grain_size;
+
+  double  Dfoffset = 0.0;  // diffusivity for deformational SIA flow
+  for (int k = 0; k <= ks; ++k) {
+    double depth = thk - m_grid->z(k); // FIXME issue #15
+    // pressure added by the ice (i.e. pressure difference between the
+    // current level and the top of the column)
+    const double pressure = m_EC->pressure(depth);
+
+    double flow;
+    if (age_ij != NULL) {
+      ice_grain_size = grainSizeVostok(0.5 * (age_ij[k] + age_offset[k]));
+    }
+    // If the flow law does not use grain size, it will just ignore it,
+    // no harm there
+    double E = 0.5 * (E_ij[k] + E_offset[k]);
+    flow = m_flow_law->flow(alpha * pressure, E, pressure, ice_grain_size);
 
-        // vertically-averaged SIA-only flux, sans sliding; note
-        //   result(i,j,0) is  u  at E (east)  staggered point (i+1/2,j)
-        //   result(i,j,1) is  v  at N (north) staggered point (i,j+1/2)
-        result(i,j,o) = - Dfoffset * slope;
+    delta[k] = inputs.enhancement_factor * theta_local * 2.0 * pressure * flow;
 
-        // if doing the full update, fill the delta column above the ice and
-        // store it:
-        if (full_update) {
-          for (unsigned int k = ks + 1; k < m_grid->Mz(); ++k) {
-            delta_ij[k] = 0.0;
-          }
-          m_delta[o].set_column(i,j,&delta_ij[0]);
-        }
-      } // i,j-loop
-    } catch (...) {
-      loop.failed();
+    if (k > 0) { // trapezoidal rule
+      const double dz = m_grid->z(k) - m_grid->z(k-1);
+      Dfoffset += 0.5 * dz * ((depth + dz) * delta[k-1] + depth * delta[k]);
     }
-    loop.check();
-  } // o-loop
+  }
+  // finish off D with (1/2) dz (0 + (H-z[ks])*delta[ks]), but dz=H-z[ks]:
+  const double dz = thk - m_grid->z(ks);
+  Dfoffset += 0.5 * dz * dz * delta[ks];
 
-  m_D_max = GlobalMax(m_grid->com, my_D_max);
+  // fill the delta column above the ice
+  for (unsigned int k = ks + 1; k < m_grid->Mz(); ++k) {
+    delta[k] = 0.0;
+  }
+
+  return Dfoffset;
 }
 
 //! \brief Compute diffusivity (diagnostically).
@@ -749,6 +814,11 @@ void SIAFD::compute_diffusivity(IceModelVec2S &result) {
  */
 void SIAFD::compute_diffusivity_staggered(IceModelVec2Stag &D_stag) {
 
+  if (m_streaming) {
+    compute_diffusivity_staggered_streaming(D_stag);
+    return;
+  }
+
   const IceModelVec2S
     &h = *m_grid->variables().get_2d_scalar("surface_altitude"),
     &H = *m_grid->variables().get_2d_scalar("land_ice_thickness");
@@ -804,6 +874,25 @@ void SIAFD::compute_diffusivity_staggered(IceModelVec2Stag &D_stag) {
   loop.check();
 }
 
+//! Compute \f$I(z) = \int_b^z\delta(s)ds\f$ in a column using the trapezoidal rule.
+static void integrate_delta(const IceGrid &grid, double thk, const double *delta, double *I) {
+  const unsigned int ks = grid.kBelowHeight(thk);
+
+  // within the ice:
+  I[0] = 0.0;
+  double I_current = 0.0;
+  for (unsigned int k = 1; k <= ks; ++k) {
+    const double dz = grid.z(k) - grid.z(k-1);
+    // trapezoidal rule
+    I_current += 0.5 * dz * (delta[k-1] + delta[k]);
+    I[k] = I_current;
+  }
+  // above the ice:
+  for (unsigned int k = ks + 1; k < grid.Mz(); ++k) {
+    I[k] = I_current;
+  }
+}
+
 //! \brief Compute I.
 /*!
  * This computes
@@ -855,21 +944,7 @@ void SIAFD::compute_I() {
         double *delta_ij = m_delta[o].get_column(i,j);
         double *I_ij     = I[o].get_column(i,j);
 
-        const unsigned int ks = m_grid->kBelowHeight(thk);
-
-        // within the ice:
-        I_ij[0] = 0.0;
-        double I_current = 0.0;
-        for (unsigned int k = 1; k <= ks; ++k) {
-          const double dz = m_grid->z(k) - m_grid->z(k-1);
-          // trapezoidal rule
-          I_current += 0.5 * dz * (delta_ij[k-1] + delta_ij[k]);
-          I_ij[k] = I_current;
-        }
-        // above the ice:
-        for (unsigned int k = ks + 1; k < m_grid->Mz(); ++k) {
-          I_ij[k] = I_current;
-        }
+        integrate_delta(*m_grid, thk, delta_ij, I_ij);
       }
     } catch (...) {
       loop.failed();
@@ -962,6 +1037,177 @@ void SIAFD::compute_3d_horizontal_velocity(const IceModelVec2Stag &h_x, const Ic
   v_out.update_ghosts();
 }
 
+//! \brief Compute horizontal components of the SIA velocity (in 3D) without storing delta and I.
+/*!
+ * Computes the same velocity as compute_3d_horizontal_velocity(), but
+ * instead of storing \f$\delta\f$ and \f$I\f$ on the whole staggered grid
+ * it computes them in one strip of columns (fixed `i`) at a time. The
+ * strip buffers are `O(ym * Mz)`, compared to four `O(xm * ym * Mz)`
+ * fields used by compute_diffusive_flux() and compute_I().
+ *
+ * Each staggered value is computed once; \f$I\f$ at the "west" staggered
+ * points of a strip is taken from the "east" points of the previous
+ * strip. Staggered points just outside the subdomain are computed
+ * locally instead of communicating ghosts.
+ *
+ * The price is that the flow law is evaluated again (it was evaluated
+ * in compute_diffusive_flux()).
+ */
+void SIAFD::compute_3d_horizontal_velocity_streaming(const IceModelVec2Stag &h_x,
+                                                     const IceModelVec2Stag &h_y,
+                                                     const IceModelVec2V &vel_input,
+                                                     IceModelVec3 &u_out, IceModelVec3 &v_out) {
+  const unsigned int Mz = m_grid->Mz();
+  const int
+    xs = m_grid->xs(),
+    xm = m_grid->xm(),
+    ys = m_grid->ys(),
+    ym = m_grid->ym();
+
+  DeltaInputs inputs = prepare_delta_inputs(h_x, h_y);
+  const IceModelVec2S &thk_smooth = *inputs.thk_smooth;
+
+  // I at staggered points (i-1/2, j) ("west"), (i+1/2, j) ("east"), for
+  // j = ys, ..., ys + ym - 1, and (i, j+1/2) for j = ys - 1, ..., ys + ym - 1
+  std::vector<double>
+    I_west(ym * Mz),
+    I_east(ym * Mz),
+    I_north(ym * Mz + Mz),
+    delta(Mz);
+
+  IceModelVec::AccessList list;
+  list.add(u_out);
+  list.add(v_out);
+
+  list.add(h_x);
+  list.add(h_y);
+  list.add(vel_input);
+
+  list.add(*inputs.theta);
+  list.add(thk_smooth);
+  list.add(*inputs.enthalpy);
+  if (inputs.age != NULL) {
+    list.add(*inputs.age);
+  }
+
+  ParallelSection loop(m_grid->com);
+  try {
+    // I at (xs - 1/2, j)
+    for (int j = ys; j < ys + ym; ++j) {
+      const int i = xs - 1;
+      compute_delta(i, j, 0, inputs, delta);
+      integrate_delta(*m_grid, 0.5 * (thk_smooth(i, j) + thk_smooth(i + 1, j)),
+                      &delta[0], &I_east[(j - ys) * Mz]);
+    }
+
+    for (int i = xs; i < xs + xm; ++i) {
+      I_west.swap(I_east);
+
+      for (int j = ys; j < ys + ym; ++j) {
+        compute_delta(i, j, 0, inputs, delta);
+        integrate_delta(*m_grid, 0.5 * (thk_smooth(i, j) + thk_smooth(i + 1, j)),
+                        &delta[0], &I_east[(j - ys) * Mz]);
+      }
+
+      for (int j = ys - 1; j < ys + ym; ++j) {
+        compute_delta(i, j, 1, inputs, delta);
+        integrate_delta(*m_grid, 0.5 * (thk_smooth(i, j) + thk_smooth(i, j + 1)),
+                        &delta[0], &I_north[(j - ys + 1) * Mz]);
+      }
+
+      for (int j = ys; j < ys + ym; ++j) {
+        const double
+          *I_e = &I_east[(j - ys) * Mz],
+          *I_w = &I_west[(j - ys) * Mz],
+          *I_n = &I_north[(j - ys + 1) * Mz],
+          *I_s = &I_north[(j - ys) * Mz];
+
+        double
+          *u_ij = u_out.get_column(i, j),
+          *v_ij = v_out.get_column(i, j);
+
+        // Fetch values from 2D fields *outside* of the k-loop:
+        double
+          h_x_w = h_x(i - 1, j, 0),
+          h_x_e = h_x(i, j, 0),
+          h_x_n = h_x(i, j, 1),
+          h_x_s = h_x(i, j - 1, 1);
+
+        double
+          h_y_w = h_y(i - 1, j, 0),
+          h_y_e = h_y(i, j, 0),
+          h_y_n = h_y(i, j, 1),
+          h_y_s = h_y(i, j - 1, 1);
+
+        double
+          vel_input_u = vel_input(i, j).u,
+          vel_input_v = vel_input(i, j).v;
+
+        for (unsigned int k = 0; k < Mz; ++k) {
+          u_ij[k] = - 0.25 * (I_e[k] * h_x_e + I_w[k] * h_x_w +
+                              I_n[k] * h_x_n + I_s[k] * h_x_s);
+          v_ij[k] = - 0.25 * (I_e[k] * h_y_e + I_w[k] * h_y_w +
+                              I_n[k] * h_y_n + I_s[k] * h_y_s);
+
+          // Add the "SSA" velocity:
+          u_ij[k] += vel_input_u;
+          v_ij[k] += vel_input_v;
+        }
+      }
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  // Communicate to get ghosts:
+  u_out.update_ghosts();
+  v_out.update_ghosts();
+}
+
+/*!
+ * \brief Computes the diffusivity of the SIA mass continuity equation on the
+ * staggered grid, re-computing delta (used in the streaming mode).
+ */
+void SIAFD::compute_diffusivity_staggered_streaming(IceModelVec2Stag &D_stag) {
+  // D_stag may be one of the work vectors used to store the surface
+  // gradient, so use separate storage here
+  IceModelVec2Stag h_x, h_y;
+  h_x.create(m_grid, "h_x", WITH_GHOSTS);
+  h_y.create(m_grid, "h_y", WITH_GHOSTS);
+
+  compute_surface_gradient(h_x, h_y);
+
+  DeltaInputs inputs = prepare_delta_inputs(h_x, h_y);
+
+  std::vector<double> delta(m_grid->Mz());
+
+  IceModelVec::AccessList list;
+  list.add(h_x);
+  list.add(h_y);
+  list.add(*inputs.theta);
+  list.add(*inputs.thk_smooth);
+  list.add(*inputs.enthalpy);
+  if (inputs.age != NULL) {
+    list.add(*inputs.age);
+  }
+  list.add(D_stag);
+
+  ParallelSection loop(m_grid->com);
+  try {
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      for (int o = 0; o < 2; ++o) {
+        D_stag(i,j,o) = compute_delta(i, j, o, inputs, delta);
+      }
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+}
+
 //! Use the Vostok core as a source of a relationship between the age of the ice and the grain size.
 /*! A data set is interpolated here. The intention is that the softness of the
   ice has nontrivial dependence on its age, through its grainsize, because of
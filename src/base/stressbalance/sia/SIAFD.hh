@@ -19,6 +19,8 @@
 #ifndef _SIAFD_H_
 #define _SIAFD_H_
 
+#include <vector>
+
 #include "base/stressbalance/SSB_Modifier.hh"      // derivesfrom SSB_Modifier
 
 namespace pism {
@@ -91,20 +93,45 @@ protected:
 
   virtual void compute_I();
 
+  virtual void compute_3d_horizontal_velocity_streaming(const IceModelVec2Stag &h_x,
+                                                        const IceModelVec2Stag &h_y,
+                                                        const IceModelVec2V &vel_input,
+                                                        IceModelVec3 &u_out, IceModelVec3 &v_out);
+
+  //! Fields and parameters needed to compute delta; see compute_delta().
+  struct DeltaInputs {
+    const IceModelVec2S *thk_smooth, *theta;
+    const IceModelVec2Stag *h_x, *h_y;
+    const IceModelVec3 *enthalpy;
+    //! NULL if the grain size does not depend on the age
+    const IceModelVec3 *age;
+    double enhancement_factor, ice_grain_size;
+  };
+
+  DeltaInputs prepare_delta_inputs(const IceModelVec2Stag &h_x, const IceModelVec2Stag &h_y);
+
+  double compute_delta(int i, int j, int o, const DeltaInputs &inputs,
+                       std::vector<double> &delta);
+
   virtual double grainSizeVostok(double age) const;
 
   virtual void compute_diffusivity(IceModelVec2S &result);
   virtual void compute_diffusivity_staggered(IceModelVec2Stag &result);
+  virtual void compute_diffusivity_staggered_streaming(IceModelVec2Stag &result);
 
   //! temporary storage for eta, theta and the smoothed thickness
   IceModelVec2S m_work_2d[2];
   //! temporary storage for the surface gradient
   IceModelVec2Stag m_work_2d_stag[2];
-  //! temporary storage for delta on the staggered grid
+  //! temporary storage for delta on the staggered grid (not allocated in the streaming mode)
   IceModelVec3 m_delta[2];
-  //! temporary storage used to store I and strain_heating on the staggered grid
+  //! temporary storage used to store I and strain_heating on the staggered grid (not
+  //! allocated in the streaming mode)
   IceModelVec3 m_work_3d[2];
 
+  //! true if delta and I are re-computed instead of stored; see sia_streaming
+  bool m_streaming;
+
   BedSmoother *m_bed_smoother;
   int m_bed_state_counter;
 
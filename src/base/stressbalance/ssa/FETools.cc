@@ -307,6 +307,10 @@ Quadrature::Quadrature(const IceGrid &grid, double L) {
       shape.eval(k, quadPoints[q][0], quadPoints[q][1], &m_germs[q][k]);
       m_germs[q][k].dx /= jacobian_x;
       m_germs[q][k].dy /= jacobian_y;
+
+      m_shape.val[q][k] = m_germs[q][k].val;
+      m_shape.dx[q][k]  = m_germs[q][k].dx;
+      m_shape.dy[q][k]  = m_germs[q][k].dy;
     }
   }
 
@@ -339,16 +343,21 @@ const FunctionGerm *Quadrature::testFunctionValues(int q, int k) {
   return m_germs[q] + k;
 }
 
+//! Return values and derivatives of all shape functions at all quadrature points.
+const Quadrature::ShapeTable& Quadrature::shapeTable() const {
+  return m_shape;
+}
+
 
 /*! @brief Compute the values at the quadrature ponits of a scalar-valued
   finite-element function with element-local degrees of freedom `x_local`.*/
 /*! There should be room for Quadrature::Nq values in the output vector `vals`. */
 void Quadrature_Scalar::computeTrialFunctionValues(const double *x_local, double *vals) {
   for (unsigned int q = 0; q < Nq; q++) {
-    const FunctionGerm *test = m_germs[q];
+    const double *phi = m_shape.val[q];
     vals[q] = 0;
     for (unsigned int k = 0; k < Nk; k++) {
-      vals[q] += test[k].val * x_local[k];
+      vals[q] += phi[k] * x_local[k];
     }
   }
 }
@@ -360,12 +369,15 @@ void Quadrature_Scalar::computeTrialFunctionValues(const double *x_local, double
   and `dy`. */
 void Quadrature_Scalar::computeTrialFunctionValues(const double *x_local, double *vals, double *dx, double *dy) {
   for (unsigned int q = 0; q < Nq; q++) {
-    const FunctionGerm *test = m_germs[q];
+    const double
+      *phi   = m_shape.val[q],
+      *phi_x = m_shape.dx[q],
+      *phi_y = m_shape.dy[q];
     vals[q] = 0; dx[q] = 0; dy[q] = 0;
     for (unsigned int k = 0; k < Nk; k++) {
-      vals[q] += test[k].val * x_local[k];
-      dx[q]   += test[k].dx * x_local[k];
-      dy[q]   += test[k].dy * x_local[k];
+      vals[q] += phi[k] * x_local[k];
+      dx[q]   += phi_x[k] * x_local[k];
+      dy[q]   += phi_y[k] * x_local[k];
     }
   }
 }
@@ -413,10 +425,10 @@ void Quadrature_Vector::computeTrialFunctionValues(const Vector2 *x_local, Vecto
   for (unsigned int q = 0; q < Nq; q++) {
     result[q].u = 0;
     result[q].v = 0;
-    const FunctionGerm *test = m_germs[q];
+    const double *phi = m_shape.val[q];
     for (unsigned int k = 0; k < Nk; k++) {
-      result[q].u += test[k].val * x_local[k].u;
-      result[q].v += test[k].val * x_local[k].v;
+      result[q].u += phi[k] * x_local[k].u;
+      result[q].v += phi[k] * x_local[k].v;
     }
   }
 }
@@ -433,18 +445,34 @@ void Quadrature_Vector::computeTrialFunctionValues(const Vector2 *x_local, Vecto
  * \right] @f].
  */
 void Quadrature_Vector::computeTrialFunctionValues(const Vector2 *x_local, Vector2 *vals, double (*Dv)[3]) {
+  // element-local degrees of freedom, split into components
+  double U[Nk], V[Nk];
+  for (unsigned int k = 0; k < Nk; k++) {
+    U[k] = x_local[k].u;
+    V[k] = x_local[k].v;
+  }
+
   for (unsigned int q = 0; q < Nq; q++) {
-    vals[q].u = 0; vals[q].v = 0;
-    double *Dvq = Dv[q];
-    Dvq[0] = 0; Dvq[1] = 0; Dvq[2] = 0;
-    const FunctionGerm *test = m_germs[q];
+    const double
+      *phi   = m_shape.val[q],
+      *phi_x = m_shape.dx[q],
+      *phi_y = m_shape.dy[q];
+
+    double u = 0.0, v = 0.0, u_x = 0.0, u_y = 0.0, v_x = 0.0, v_y = 0.0;
     for (unsigned int k = 0; k < Nk; k++) {
-      vals[q].u += test[k].val * x_local[k].u;
-      vals[q].v += test[k].val * x_local[k].v;
-      Dvq[0] += test[k].dx * x_local[k].u;
-      Dvq[1] += test[k].dy * x_local[k].v;
-      Dvq[2] += 0.5*(test[k].dy*x_local[k].u + test[k].dx*x_local[k].v);
+      u   += phi[k]   * U[k];
+      v   += phi[k]   * V[k];
+      u_x += phi_x[k] * U[k];
+      u_y += phi_y[k] * U[k];
+      v_x += phi_x[k] * V[k];
+      v_y += phi_y[k] * V[k];
     }
+
+    vals[q].u = u;
+    vals[q].v = v;
+    Dv[q][0] = u_x;
+    Dv[q][1] = v_y;
+    Dv[q][2] = 0.5 * (u_y + v_x);
   }
 }
 
@@ -459,14 +487,17 @@ void Quadrature_Vector::computeTrialFunctionValues(const Vector2 *x_local, Vecto
     vals[q].u = 0; vals[q].v = 0;
     dx[q].u = 0; dx[q].v = 0;
     dy[q].u = 0; dy[q].v = 0;
-    const FunctionGerm *test = m_germs[q];
+    const double
+      *phi   = m_shape.val[q],
+      *phi_x = m_shape.dx[q],
+      *phi_y = m_shape.dy[q];
     for (unsigned int k = 0; k < Nk; k++) {
-      vals[q].u += test[k].val * x_local[k].u;
-      vals[q].v += test[k].val * x_local[k].v;
-      dx[q].u += test[k].dx * x_local[k].u;
-      dx[q].v += test[k].dx * x_local[k].v;
-      dy[q].u += test[k].dy * x_local[k].u;
-      dy[q].v += test[k].dy * x_local[k].v;
+      vals[q].u += phi[k] * x_local[k].u;
+      vals[q].v += phi[k] * x_local[k].v;
+      dx[q].u += phi_x[k] * x_local[k].u;
+      dx[q].v += phi_x[k] * x_local[k].v;
+      dy[q].u += phi_y[k] * x_local[k].u;
+      dy[q].v += phi_y[k] * x_local[k].v;
     }
   }
 }
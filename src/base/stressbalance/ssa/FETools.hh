@@ -408,9 +408,18 @@ public:
   // FunctionGerms
   typedef FunctionGerm FunctionGermArray[Quadrature::Nq];
 
+  //! Values and derivatives of shape functions at quadrature points.
+  /*! Same as testFunctionValues(), but each of `val`, `dx`, `dy` is a
+      contiguous `Nq` by `Nk` array, so that loops over shape functions
+      in element kernels can be vectorized. */
+  struct ShapeTable {
+    double val[Nq][Nk], dx[Nq][Nk], dy[Nq][Nk];
+  };
+
   const FunctionGermArray* testFunctionValues();
   const FunctionGerm* testFunctionValues(int q);
   const FunctionGerm* testFunctionValues(int q, int k);
+  const ShapeTable& shapeTable() const;
   
   const double* getWeightedJacobian();
 
@@ -428,6 +437,8 @@ protected:
   double m_JxW[Nq];
   //! Trial function values (for each of `Nq` quadrature points, and each of `Nk` trial function).
   FunctionGerm m_germs[Nq][Nk];
+  //! Same as `m_germs`, stored as separate arrays.
+  ShapeTable m_shape;
 };
 
 //! This version supports 2D scalar fields.
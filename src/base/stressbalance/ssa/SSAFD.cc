@@ -16,6 +16,7 @@
 // along with PISM; if not, write to the Free Software
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -28,6 +29,7 @@
 #include "base/util/PISMVars.hh"
 #include "base/util/IceGrid.hh"
 #include "base/util/PISMTime.hh"
+#include "base/util/io/PIO.hh"
 
 namespace pism {
 namespace stressbalance {
@@ -252,11 +254,48 @@ void SSAFD::init_impl() {
   m_default_pc_failure_count     = 0;
   m_default_pc_failure_max_count = 5;
 
+  // Restore the number of block Jacobi failures so that a re-started run does
+  // not re-try the preconditioner that kept failing before the restart.
+  options::String input_file("-i", "PISM input file");
+  bool bootstrap = options::Bool("-bootstrap", "enable bootstrapping heuristics");
+  bool dont_read_initial_guess = options::Bool("-dontreadSSAvels",
+                                               "don't read the initial guess");
+
+  if (input_file.is_set() and not (bootstrap or dont_read_initial_guess)) {
+    PIO nc(m_grid->com, "guess_mode");
+    nc.open(input_file, PISM_READONLY);
+
+    if (nc.inq_var("u_ssa")) {
+      std::vector<double> count = nc.get_att_double("u_ssa", "ssafd_bjacobi_failure_count");
+      if (count.size() == 1 and count[0] > 0.0) {
+        m_default_pc_failure_count = std::min((unsigned int)count[0],
+                                              m_default_pc_failure_max_count);
+        m_log->message(3, "  block Jacobi failed %d time(s) before the restart...\n",
+                       m_default_pc_failure_count);
+      }
+    }
+
+    nc.close();
+  }
+
   if (m_config->get_boolean("do_fracture_density")) {
     fracture_density = m_grid->variables().get_2d_scalar("fracture_density");
   }
 }
 
+void SSAFD::define_variables_impl(const std::set<std::string> &vars, const PIO &nc,
+                                  IO_Type nctype) {
+  SSA::define_variables_impl(vars, nc, nctype);
+
+  // Save the solver state needed to warm-start after a restart. (The
+  // effective viscosity is re-computed from the velocity at the beginning
+  // of each solve, so it does not need to be saved.)
+  if (set_contains(vars, "vel_ssa")) {
+    nc.put_att_double("u_ssa", "ssafd_bjacobi_failure_count", PISM_INT,
+                      m_default_pc_failure_count);
+  }
+}
+
 void SSAFD::update(bool fast, const IceModelVec2S& melange_back_pressure) {
   m_melange_back_pressure = &melange_back_pressure;
 
@@ -1806,7 +1845,7 @@ SSAFD_nuH::SSAFD_nuH(SSAFD *m)
             "Pa s m", "kPa s m", 1);
 }
 
-IceModelVec::Ptr SSAFD_nuH::compute() {
+IceModelVec::Ptr SSAFD_nuH::compute_impl() {
 
   IceModelVec2Stag::Ptr result(new IceModelVec2Stag);
   result->create(m_grid, "nuH", WITH_GHOSTS);
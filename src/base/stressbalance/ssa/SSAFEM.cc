@@ -99,6 +99,18 @@ SSAFEM::SSAFEM(IceGrid::ConstPtr g, EnthalpyConverter::Ptr e)
   // elements, and Quadrature::Nq quadrature points.
   int nElements = m_element_index.element_count();
   m_coefficients.resize(fem::Quadrature::Nq * nElements);
+
+  // Values re-used by compute_local_jacobian() and cacheQuadPtValues(); see
+  // cache_nuH_and_beta() and cacheQuadPtValues() for details.
+  m_nuH_and_beta_velocity.resize(fem::Quadrature::Nk * nElements);
+  m_nuH_and_beta.resize(fem::Quadrature::Nq * nElements);
+  m_nuH_and_beta_valid = false;
+  m_nuH_and_beta_derivatives = true;
+
+  m_hardness.resize(fem::Quadrature::Nq * nElements, 0.0);
+  m_hardness_thickness.resize(fem::Quadrature::Nq * nElements, -1.0);
+  m_hardness_enthalpy = NULL;
+  m_hardness_enthalpy_counter = -1;
 }
 
 SSA* SSAFEMFactory(IceGrid::ConstPtr g, EnthalpyConverter::Ptr ec) {
@@ -167,6 +179,27 @@ TerminationReason::Ptr SSAFEM::solve_with_reason() {
   return solve_nocache();
 }
 
+//! Returns true if `snes` computes the Jacobian at every iteration.
+/*!
+ * This is the case for (lagless) Newton-type methods. Other methods
+ * (NGMRES, quasi-Newton, etc.) evaluate the residual only.
+ */
+static bool jacobian_follows_residual(SNES snes) {
+  PetscErrorCode ierr;
+
+  PetscBool newton = PETSC_FALSE;
+  ierr = PetscObjectTypeCompareAny((PetscObject)snes, &newton,
+                                   SNESNEWTONLS, SNESNEWTONTR,
+                                   SNESVINEWTONRSLS, SNESVINEWTONSSLS, "");
+  PISM_CHK(ierr, "PetscObjectTypeCompareAny");
+
+  PetscInt lag = 1;
+  ierr = SNESGetLagJacobian(snes, &lag);
+  PISM_CHK(ierr, "SNESGetLagJacobian");
+
+  return newton == PETSC_TRUE and lag == 1;
+}
+
 //! Solve the SSA without first recomputing the values of coefficients at quad
 //! points.  See the disccusion of SSAFEM::solve for more discussion.
 TerminationReason::Ptr SSAFEM::solve_nocache() {
@@ -174,6 +207,14 @@ TerminationReason::Ptr SSAFEM::solve_nocache() {
 
   m_epsilon_ssa = m_config->get_double("epsilon_ssa");
 
+  // Values of nuH and beta depend on epsilon_ssa and parameters of
+  // the basal resistance model, so they have to be re-computed.
+  invalidate_nuH_and_beta();
+
+  // Derivatives of nuH and beta are needed only if SNES is going to
+  // compute a Jacobian after (almost) every residual evaluation.
+  m_nuH_and_beta_derivatives = jacobian_follows_residual(m_snes);
+
   options::String filename("-ssa_view", "");
   if (filename.is_set()) {
     petsc::Viewer viewer;
@@ -236,22 +277,32 @@ TerminationReason::Ptr SSAFEM::solve_nocache() {
 any geometry or temperature related coefficients have changed. The method
 stores the values of the coefficients at the quadrature points of each
 element so that these interpolated values do not need to be computed
-during each outer iteration of the nonlinear solve.*/
+during each outer iteration of the nonlinear solve.
+
+The vertically-averaged ice hardness is re-computed only if the enthalpy
+field changed (according to its state counter) or if the ice thickness
+at a quadrature point changed. */
 void SSAFEM::cacheQuadPtValues() {
 
   using fem::Quadrature;
-  using fem::FunctionGerm;
+
+  const unsigned int Mz = m_grid->Mz();
 
   const double
-    *Enth_e[4];
-  double
-    *Enth_q[4];
+    *Enth_e[Quadrature::Nk];
+  // Enthalpy at quadrature points, Mz values per column.
+  std::vector<double> Enth_q(Quadrature::Nq * Mz);
 
   double ice_density = m_config->get_double("ice_density");
 
-  for (unsigned int q=0; q<Quadrature::Nq; q++) {
-    Enth_q[q] = new double[m_grid->Mz()];
-  }
+  const bool hardness_up_to_date = (m_hardness_enthalpy == m_enthalpy and
+                                    m_hardness_enthalpy_counter == m_enthalpy->get_state_counter());
+  // Mark the hardness cache as invalid until all elements are processed.
+  m_hardness_enthalpy = NULL;
+
+  invalidate_nuH_and_beta();
+
+  const Quadrature::ShapeTable &shape = m_quadrature.shapeTable();
 
   GeometryCalculator gc(sea_level, *m_config);
 
@@ -310,40 +361,55 @@ void SSAFEM::cacheQuadPtValues() {
           coefficients[q].mask = gc.mask(coefficients[q].b, coefficients[q].H);
         }
 
-        // In the following, we obtain the averaged hardness value from enthalpy by
-        // interpolating enthalpy in each column over a quadrature point and then
-        // taking the average over the column.  A faster approach would be to take
-        // the column average over each element nodes and then interpolate to the
-        // quadrature points. Does this make a difference?
-
-        // Obtain the values of enthalpy at each vertical level at each of the vertices
-        // of the current element.
-        Enth_e[0] = m_enthalpy->get_column(i, j);
-        Enth_e[1] = m_enthalpy->get_column(i+1, j);
-        Enth_e[2] = m_enthalpy->get_column(i+1, j+1);
-        Enth_e[3] = m_enthalpy->get_column(i, j+1);
-
-        // We now want to interpolate to the quadrature points at each of the
-        // vertical levels.  It would be nice to use quadrature::computeTestFunctionValues,
-        // but the way we have just obtained the values at the element vertices
-        // using getInternalColumn doesn't make this straightforward.  So we compute the values
-        // by hand.
-        const FunctionGerm (*test)[Quadrature::Nk] = m_quadrature.testFunctionValues();
-        for (unsigned int k = 0; k < m_grid->Mz(); k++) {
-          Enth_q[0][k] = Enth_q[1][k] = Enth_q[2][k] = Enth_q[3][k] = 0;
+        double
+          *B_cached = &m_hardness[ij*Quadrature::Nq],
+          *H_cached = &m_hardness_thickness[ij*Quadrature::Nq];
+
+        bool reuse_hardness = hardness_up_to_date;
+        for (unsigned int q = 0; q < Quadrature::Nq; q++) {
+          reuse_hardness = reuse_hardness and H_cached[q] == Hq[q];
+        }
+
+        if (not reuse_hardness) {
+          // In the following, we obtain the averaged hardness value from enthalpy by
+          // interpolating enthalpy in each column over a quadrature point and then
+          // taking the average over the column.  A faster approach would be to take
+          // the column average over each element nodes and then interpolate to the
+          // quadrature points. Does this make a difference?
+
+          // Obtain the values of enthalpy at each vertical level at each of the vertices
+          // of the current element.
+          Enth_e[0] = m_enthalpy->get_column(i, j);
+          Enth_e[1] = m_enthalpy->get_column(i+1, j);
+          Enth_e[2] = m_enthalpy->get_column(i+1, j+1);
+          Enth_e[3] = m_enthalpy->get_column(i, j+1);
+
+          // We now want to interpolate to the quadrature points at each of the
+          // vertical levels.  It would be nice to use quadrature::computeTestFunctionValues,
+          // but the way we have just obtained the values at the element vertices
+          // using getInternalColumn doesn't make this straightforward.  So we compute the values
+          // by hand.
           for (unsigned int q = 0; q < Quadrature::Nq; q++) {
-            for (unsigned int p = 0; p < Quadrature::Nk; p++) {
-              Enth_q[q][k] += test[q][p].val * Enth_e[p][k];
+            const double *phi = shape.val[q];
+            double *E = &Enth_q[q * Mz];
+            for (unsigned int k = 0; k < Mz; k++) {
+              E[k] = (phi[0] * Enth_e[0][k] + phi[1] * Enth_e[1][k] +
+                      phi[2] * Enth_e[2][k] + phi[3] * Enth_e[3][k]);
             }
           }
+
+          // Now, for each column over a quadrature point, find the averaged_hardness.
+          for (unsigned int q = 0; q < Quadrature::Nq; q++) {
+            // Evaluate column integrals in flow law at every quadrature point's column
+            B_cached[q] = m_flow_law->averaged_hardness(Hq[q],
+                                                        m_grid->kBelowHeight(Hq[q]),
+                                                        &(m_grid->z()[0]), &Enth_q[q * Mz]);
+            H_cached[q] = Hq[q];
+          }
         }
 
-        // Now, for each column over a quadrature point, find the averaged_hardness.
         for (unsigned int q = 0; q < Quadrature::Nq; q++) {
-          // Evaluate column integrals in flow law at every quadrature point's column
-          coefficients[q].B = m_flow_law->averaged_hardness(coefficients[q].H,
-                                                            m_grid->kBelowHeight(coefficients[q].H),
-                                                            &(m_grid->z()[0]), Enth_q[q]);
+          coefficients[q].B = B_cached[q];
         }
 
       } // j-loop
@@ -353,11 +419,62 @@ void SSAFEM::cacheQuadPtValues() {
   }
   loop.check();
 
+  m_hardness_enthalpy         = m_enthalpy;
+  m_hardness_enthalpy_counter = m_enthalpy->get_state_counter();
+}
+
+//! Mark values of nuH and beta saved by compute_local_function() as out of date.
+/*!
+ * Has to be called whenever SSA coefficients at quadrature points change.
+ */
+void SSAFEM::invalidate_nuH_and_beta() {
+  m_nuH_and_beta_valid = false;
+}
+
+//! Save nuH, beta and their derivatives at quadrature points of the element `ij`.
+void SSAFEM::cache_nuH_and_beta(int ij, const Vector2 *velocity_local,
+                                const NuHAndBeta *values) {
+  using fem::Quadrature;
+
+  Vector2 *velocity = &m_nuH_and_beta_velocity[ij*Quadrature::Nk];
+  for (unsigned int k = 0; k < Quadrature::Nk; k++) {
+    velocity[k] = velocity_local[k];
+  }
+
+  NuHAndBeta *result = &m_nuH_and_beta[ij*Quadrature::Nq];
   for (unsigned int q = 0; q < Quadrature::Nq; q++) {
-    delete [] Enth_q[q];
+    result[q] = values[q];
   }
 }
 
+//! Get nuH, beta and their derivatives at quadrature points of the element `ij`.
+/*!
+ * Returns false if saved values were computed using a different
+ * velocity or coefficients that changed since then.
+ */
+bool SSAFEM::cached_nuH_and_beta(int ij, const Vector2 *velocity_local,
+                                 NuHAndBeta *values) const {
+  using fem::Quadrature;
+
+  if (not m_nuH_and_beta_valid) {
+    return false;
+  }
+
+  const Vector2 *velocity = &m_nuH_and_beta_velocity[ij*Quadrature::Nk];
+  for (unsigned int k = 0; k < Quadrature::Nk; k++) {
+    if (velocity[k].u != velocity_local[k].u or
+        velocity[k].v != velocity_local[k].v) {
+      return false;
+    }
+  }
+
+  const NuHAndBeta *cached = &m_nuH_and_beta[ij*Quadrature::Nq];
+  for (unsigned int q = 0; q < Quadrature::Nq; q++) {
+    values[q] = cached[q];
+  }
+  return true;
+}
+
 /** @brief Compute the "(effective viscosity) x (ice thickness)"
  *  and effective viscous bed strength from the current solution, at a
  *  single quadrature point.
@@ -446,8 +563,15 @@ void SSAFEM::compute_local_function(DMDALocalInfo *info,
   Vector2 u[Quadrature::Nq];
   double Du[Quadrature::Nq][3];
 
-  // An Nq by Nk array of test function values.
-  const FunctionGerm (*test)[Quadrature::Nk] = m_quadrature.testFunctionValues();
+  // Viscosity and basal drag at quadrature points. If a Jacobian
+  // evaluation is expected to follow, derivatives are computed here,
+  // too, and all values are saved so that compute_local_jacobian() can
+  // re-use them.
+  NuHAndBeta values[Quadrature::Nq];
+  const bool derivatives = m_nuH_and_beta_derivatives;
+
+  // Values of test functions and their derivatives (Nq by Nk arrays).
+  const Quadrature::ShapeTable &shape = m_quadrature.shapeTable();
 
   // Iterate over the elements.
   int xs = m_element_index.xs,
@@ -488,15 +612,25 @@ void SSAFEM::compute_local_function(DMDALocalInfo *info,
       // Compute the solution values and symmetric gradient at the quadrature points.
       m_quadrature_vector.computeTrialFunctionValues(velocity_local, u, Du);
 
+      for (unsigned int q = 0; q < Quadrature::Nq; q++) {
+        NuHAndBeta &value = values[q];
+        PointwiseNuHAndBeta(coefficients[q], u[q], Du[q],
+                            &value.nuH, derivatives ? &value.dnuH : NULL,
+                            &value.beta, derivatives ? &value.dbeta : NULL);
+      }
+      if (derivatives) {
+        cache_nuH_and_beta(ij, velocity_local, values);
+      }
+
       // loop over quadrature points on this element:
       for (unsigned int q = 0; q < Quadrature::Nq; q++) {
 
         // Symmetric gradient at the quadrature point.
         const double *Duq = Du[q];
 
-        double eta = 0.0, beta = 0.0;
-        PointwiseNuHAndBeta(coefficients[q], u[q], Duq,
-                            &eta, NULL, &beta, NULL);
+        const double
+          eta  = values[q].nuH,
+          beta = values[q].beta;
 
         // The next few lines compute the actual residual for the element.
         const Vector2
@@ -508,13 +642,24 @@ void SSAFEM::compute_local_function(DMDALocalInfo *info,
           V_y          = Duq[1],
           U_y_plus_V_x = 2.0 * Duq[2];
 
+        // Coefficients of test functions and their derivatives.
+        const double
+          a_x = JxW[q] * eta * (4.0 * U_x + 2.0 * V_y),
+          a_y = JxW[q] * eta * U_y_plus_V_x,
+          a   = JxW[q] * (tau_b.u + tau_d.u),
+          b_x = JxW[q] * eta * U_y_plus_V_x,
+          b_y = JxW[q] * eta * (2.0 * U_x + 4.0 * V_y),
+          b   = JxW[q] * (tau_b.v + tau_d.v);
+
+        const double
+          *psi   = shape.val[q],
+          *psi_x = shape.dx[q],
+          *psi_y = shape.dy[q];
+
         // Loop over test functions.
         for (unsigned int k = 0; k < Quadrature::Nk; k++) {
-          const FunctionGerm &psi = test[q][k];
-          residual[k].u += JxW[q] * (eta * (psi.dx * (4.0 * U_x + 2.0 * V_y) + psi.dy * U_y_plus_V_x)
-                                     - psi.val * (tau_b.u + tau_d.u));
-          residual[k].v += JxW[q] * (eta * (psi.dx * U_y_plus_V_x + psi.dy * (2.0 * U_x + 4.0 * V_y))
-                                     - psi.val * (tau_b.v + tau_d.v));
+          residual[k].u += a_x * psi_x[k] + a_y * psi_y[k] - a * psi[k];
+          residual[k].v += b_x * psi_x[k] + b_y * psi_y[k] - b * psi[k];
         } // k
       } // q
 
@@ -522,6 +667,8 @@ void SSAFEM::compute_local_function(DMDALocalInfo *info,
     } // j-loop
   } // i-loop
 
+  m_nuH_and_beta_valid = derivatives;
+
   // Until now we have not touched rows in the residual corresponding to Dirichlet data.
   // We fix this now.
   if (dirichlet_data) {
@@ -607,9 +754,12 @@ void SSAFEM::compute_local_jacobian(DMDALocalInfo *info,
   Vector2 u[Quadrature::Nq];
   double Du[Quadrature::Nq][3];
 
+  // Viscosity and basal drag at quadrature points.
+  NuHAndBeta values[Quadrature::Nq];
+
   // Values of the finite element test functions at the quadrature points.
-  // This is an Nq by Nk array of function germs (Nq=#of quad pts, Nk=#of test functions).
-  const fem::FunctionGerm (*test)[Quadrature::Nk] = m_quadrature.testFunctionValues();
+  // These are Nq by Nk arrays (Nq=#of quad pts, Nk=#of test functions).
+  const Quadrature::ShapeTable &shape = m_quadrature.shapeTable();
 
   // Loop through all the elements.
   int
@@ -652,6 +802,15 @@ void SSAFEM::compute_local_jacobian(DMDALocalInfo *info,
         // Compute the values of the solution at the quadrature points.
         m_quadrature_vector.computeTrialFunctionValues(velocity_local, u, Du);
 
+        // Re-use values computed by compute_local_function() if possible.
+        if (not cached_nuH_and_beta(ij, velocity_local, values)) {
+          for (unsigned int q = 0; q < Quadrature::Nq; q++) {
+            NuHAndBeta &value = values[q];
+            PointwiseNuHAndBeta(coefficients[q], u[q], Du[q],
+                                &value.nuH, &value.dnuH, &value.beta, &value.dbeta);
+          }
+        }
+
         // Build the element-local Jacobian.
         ierr = PetscMemzero(K, sizeof(K));
         PISM_CHK(ierr, "PetscMemzero");
@@ -665,17 +824,29 @@ void SSAFEM::compute_local_jacobian(DMDALocalInfo *info,
             V_y          = Du[q][1],
             U_y_plus_V_x = 2.0 * Du[q][2]; // u_y + v_x is twice the symmetric gradient
 
-          double eta = 0.0, deta = 0.0, beta = 0.0, dbeta = 0.0;
-          PointwiseNuHAndBeta(coefficients[q], u[q], Du[q],
-                              &eta, &deta, &beta, &dbeta);
+          const double
+            eta   = values[q].nuH,
+            deta  = values[q].dnuH,
+            beta  = values[q].beta,
+            dbeta = values[q].dbeta;
+
+          if (eta == 0) {
+            ierr = PetscPrintf(PETSC_COMM_SELF, "eta=0 i %d j %d q %d\n", i, j, q);
+            PISM_CHK(ierr, "PetscPrintf");
+          }
+
+          const double
+            *psi_q   = shape.val[q],
+            *psi_x_q = shape.dx[q],
+            *psi_y_q = shape.dy[q];
 
           for (unsigned int l = 0; l < Quadrature::Nk; l++) { // Trial functions
 
             // Current trial function and its derivatives:
             const double
-              phi   = test[q][l].val,
-              phi_x = test[q][l].dx,
-              phi_y = test[q][l].dy;
+              phi   = psi_q[l],
+              phi_x = psi_x_q[l],
+              phi_y = psi_y_q[l];
 
             // Derivatives of \gamma with respect to u_l and v_l:
             const double
@@ -698,14 +869,9 @@ void SSAFEM::compute_local_jacobian(DMDALocalInfo *info,
 
               // Current test function and its derivatives:
               const double
-                psi   = test[q][k].val,
-                psi_x = test[q][k].dx,
-                psi_y = test[q][k].dy;
-
-              if (eta == 0) {
-                ierr = PetscPrintf(PETSC_COMM_SELF, "eta=0 i %d j %d q %d k %d\n", i, j, q, k);
-                PISM_CHK(ierr, "PetscPrintf");
-              }
+                psi   = psi_q[k],
+                psi_x = psi_x_q[k],
+                psi_y = psi_y_q[k];
 
               // u-u coupling
               K[k*2 + 0][l*2 + 0] += jw * (eta_u * (psi_x * (4 * U_x + 2 * V_y) + psi_y * U_y_plus_V_x)
@@ -98,7 +98,36 @@ protected:
   fem::Quadrature_Vector m_quadrature_vector;
   fem::DOFMap m_dofmap;
 
+  //! Values at a quadrature point computed by compute_local_function()
+  //! and re-used by compute_local_jacobian().
+  struct NuHAndBeta {
+    double nuH, dnuH, beta, dbeta;
+  };
+
+  void invalidate_nuH_and_beta();
+
 private:
+  void cache_nuH_and_beta(int ij, const Vector2 *velocity_local,
+                          const NuHAndBeta *values);
+  bool cached_nuH_and_beta(int ij, const Vector2 *velocity_local,
+                           NuHAndBeta *values) const;
+
+  //! Element-local velocity (Quadrature::Nk per element) used to compute `m_nuH_and_beta`.
+  std::vector<Vector2> m_nuH_and_beta_velocity;
+  //! Viscosity and basal drag at quadrature points (Quadrature::Nq per element).
+  std::vector<NuHAndBeta> m_nuH_and_beta;
+  bool m_nuH_and_beta_valid;
+  //! True if compute_local_function() should compute (and save) derivatives of nuH and beta.
+  bool m_nuH_and_beta_derivatives;
+
+  //! Vertically-averaged ice hardness at quadrature points (Quadrature::Nq per element).
+  std::vector<double> m_hardness;
+  //! Ice thickness used to compute `m_hardness`.
+  std::vector<double> m_hardness_thickness;
+  //! Enthalpy field (and its revision) used to compute `m_hardness`.
+  const IceModelVec3 *m_hardness_enthalpy;
+  int m_hardness_enthalpy_counter;
+
   void monitor_jacobian(Mat Jac);
   void monitor_function(const Vector2 **velocity_global,
                         Vector2 **residual_global);
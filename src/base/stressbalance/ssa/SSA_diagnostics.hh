@@ -32,19 +32,21 @@ class SSA_taud_mag : public Diag<SSA>
 {
 public:
   SSA_taud_mag(SSA *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 //! @brief Computes the driving shear stress at the base of ice
 //! (diagnostically).
-/*! This is *not* a duplicate of SSB_taud: SSA_taud::compute() uses
+/*! This is *not* a duplicate of SSB_taud: SSA_taud::compute_impl() uses
   SSA::compute_driving_stress(), which tries to be smarter near ice margins.
 */
 class SSA_taud : public Diag<SSA>
 {
 public:
   SSA_taud(SSA *m);
-  virtual IceModelVec::Ptr compute();
+protected:
+  virtual IceModelVec::Ptr compute_impl();
 };
 
 
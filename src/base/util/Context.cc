@@ -23,6 +23,8 @@
 #include "PISMConfig.hh"
 #include "PISMTime.hh"
 #include "Logger.hh"
+#include "PISMDiagnostic.hh"
+#include "SharedArrays.hh"
 #include "base/enthalpyConverter.hh"
 
 namespace pism {
@@ -47,6 +49,8 @@ public:
   TimePtr time;
   std::string prefix;
   Profiling profiling;
+  DiagnosticCache diagnostic_cache;
+  SharedArrays shared_arrays;
   LoggerPtr logger;
 };
 
@@ -110,6 +114,14 @@ const Profiling& Context::profiling() const {
   return m_impl->profiling;
 }
 
+const DiagnosticCache& Context::diagnostic_cache() const {
+  return m_impl->diagnostic_cache;
+}
+
+const SharedArrays& Context::shared_arrays() const {
+  return m_impl->shared_arrays;
+}
+
 Context::ConstLoggerPtr Context::log() const {
   return m_impl->logger;
 }
@@ -36,6 +36,8 @@ class Config;
 class EnthalpyConverter;
 class Time;
 class Profiling;
+class DiagnosticCache;
+class SharedArrays;
 class Logger;
 
 class Context {
@@ -67,6 +69,8 @@ public:
   ConstTimePtr time() const;
   const std::string& prefix() const;
   const Profiling& profiling() const;
+  const DiagnosticCache& diagnostic_cache() const;
+  const SharedArrays& shared_arrays() const;
 
   ConstLoggerPtr log() const;
   LoggerPtr log();
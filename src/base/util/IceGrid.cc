@@ -30,6 +30,7 @@
 #include "base/util/io/PIO.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/Logger.hh"
+#include "base/util/iceModelVec.hh"
 
 namespace pism {
 
@@ -300,6 +301,7 @@ IceGrid::Ptr IceGrid::FromFile(Context::Ptr ctx,
     // override periodicity
     p.periodicity = periodicity;
     p.ownership_ranges_from_options(ctx->size());
+    p.balance_ownership_ranges(ctx, filename);
 
     return IceGrid::Ptr(new IceGrid(ctx, p));
   } catch (RuntimeError &e) {
@@ -388,7 +390,13 @@ unsigned int IceGrid::kBelowHeight(double height) const {
                                   " grid Lz = %5.4f\n", height, Lz());
   }
 
+#ifdef _OPENMP
+  // the accelerator is modified by gsl_interp_accel_find(), so it
+  // cannot be shared by threads
+  return gsl_interp_bsearch(&m_impl->z[0], height, 0, m_impl->z.size() - 1);
+#else
   return gsl_interp_accel_find(m_impl->bsearch_accel, &m_impl->z[0], m_impl->z.size(), height);
+#endif
 }
 
 //! \brief Computes the number of processors in the X- and Y-directions.
@@ -1137,6 +1145,190 @@ void GridParameters::ownership_ranges_from_options(unsigned int size) {
   procs_y = procs.y;
 }
 
+//! @brief Split `weights.size()` grid points into `N` parts with approximately equal sums of
+//! weights. Each part gets at least `min_size` points.
+static std::vector<unsigned int> weighted_ownership_ranges(const std::vector<double> &weights,
+                                                           unsigned int N,
+                                                           unsigned int min_size) {
+  const unsigned int M = weights.size();
+
+  std::vector<double> cumulative(M + 1, 0.0);
+  for (unsigned int i = 0; i < M; ++i) {
+    cumulative[i + 1] = cumulative[i] + weights[i];
+  }
+
+  // boundary[k] is the index of the first grid point owned by the part k
+  std::vector<unsigned int> boundary(N + 1);
+  boundary[0] = 0;
+  boundary[N] = M;
+
+  unsigned int i = 0;
+  for (unsigned int k = 1; k < N; ++k) {
+    const double target = cumulative[M] * k / N;
+
+    while (i < M and cumulative[i] < target) {
+      ++i;
+    }
+
+    // pick the closest boundary
+    if (i > 0 and target - cumulative[i - 1] < cumulative[i] - target) {
+      boundary[k] = i - 1;
+    } else {
+      boundary[k] = i;
+    }
+  }
+
+  // enforce the minimum size of a part
+  for (unsigned int k = 1; k < N; ++k) {
+    boundary[k] = std::max(boundary[k], boundary[k - 1] + min_size);
+  }
+  for (int k = N - 1; k >= 1; --k) {
+    boundary[k] = std::min(boundary[k], boundary[k + 1] - min_size);
+  }
+
+  std::vector<unsigned int> result(N);
+  for (unsigned int k = 0; k < N; ++k) {
+    result[k] = boundary[k + 1] - boundary[k];
+  }
+
+  return result;
+}
+
+//! Maps grid indexes to indexes of processor sub-domains in one direction.
+static std::vector<unsigned int> owners(const std::vector<unsigned int> &procs) {
+  std::vector<unsigned int> result;
+  for (unsigned int k = 0; k < procs.size(); ++k) {
+    result.insert(result.end(), procs[k], k);
+  }
+  return result;
+}
+
+//! @brief Compute the ratio of the maximum to the mean work load of a processor sub-domain for
+//! given ownership ranges.
+static double load_imbalance(const IceModelVec2S &cost,
+                             const std::vector<unsigned int> &procs_x,
+                             const std::vector<unsigned int> &procs_y) {
+  IceGrid::ConstPtr grid = cost.get_grid();
+
+  const std::vector<unsigned int>
+    owner_x = owners(procs_x),
+    owner_y = owners(procs_y);
+
+  const unsigned int N = procs_x.size() * procs_y.size();
+  std::vector<double> local(N, 0.0), total(N, 0.0);
+
+  IceModelVec::AccessList list(cost);
+  for (Points p(*grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    local[owner_y[j] * procs_x.size() + owner_x[i]] += cost(i, j);
+  }
+
+  GlobalSum(grid->com, &local[0], &total[0], N);
+
+  double max = 0.0, sum = 0.0;
+  for (unsigned int k = 0; k < N; ++k) {
+    max = std::max(max, total[k]);
+    sum += total[k];
+  }
+
+  return sum > 0.0 ? max * N / sum : 1.0;
+}
+
+/*!
+ * Work in column solvers (energy, age, SIA) is proportional to the number of
+ * vertical levels in the ice, so the cost of a column is estimated as 1 (2D
+ * computations) plus the number of grid levels below the ice surface.
+ *
+ * PISM's domain decomposition is a tensor product of ranges in the X and Y
+ * directions, so this balances sums of costs over rows and columns of the
+ * grid. The equal-area decomposition is kept if balancing does not reduce the
+ * load imbalance (the ratio of the maximum to the mean work load of a
+ * sub-domain); both numbers are reported.
+ *
+ * Does nothing if `grid_load_balancing` is not set, if running on one
+ * processor, or if -procs_x or -procs_y are set. Because ranges are computed
+ * when the grid is created, work is re-balanced every time a run is
+ * re-started from a PISM output file.
+ *
+ * Uses current values of Mx, My, z, procs_x and procs_y.
+ */
+void GridParameters::balance_ownership_ranges(Context::Ptr ctx, const std::string &filename) {
+  if (not ctx->config()->get_boolean("grid_load_balancing") or
+      ctx->size() == 1 or
+      options::Bool("-procs_x", "Processor ownership ranges (x direction)") or
+      options::Bool("-procs_y", "Processor ownership ranges (y direction)")) {
+    return;
+  }
+
+  const unsigned int
+    Nx = procs_x.size(),
+    Ny = procs_y.size(),
+    min_size = std::max(2, (int)ctx->config()->get_double("grid_max_stencil_width"));
+
+  if (Mx < Nx * min_size or My < Ny * min_size) {
+    return;
+  }
+
+  // A temporary grid (using current ownership ranges) used to read ice thickness.
+  IceGrid::Ptr grid(new IceGrid(ctx, *this));
+
+  IceModelVec2S thickness, cost;
+  thickness.create(grid, "thk", WITHOUT_GHOSTS);
+  thickness.set_attrs("internal", "land ice thickness", "m", "land_ice_thickness");
+  thickness.regrid(filename, OPTIONAL, 0.0);
+
+  cost.create(grid, "column_cost", WITHOUT_GHOSTS);
+
+  std::vector<double>
+    cost_x(Mx, 0.0), cost_y(My, 0.0),
+    total_x(Mx, 0.0), total_y(My, 0.0);
+
+  {
+    const double Lz = grid->Lz();
+
+    IceModelVec::AccessList list;
+    list.add(thickness);
+    list.add(cost);
+
+    for (Points p(*grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+
+      const double H = thickness(i, j);
+
+      double C = 1.0;
+      if (H > 0.0) {
+        C += grid->kBelowHeight(std::min(H, Lz)) + 1;
+      }
+      cost(i, j) = C;
+
+      cost_x[i] += C;
+      cost_y[j] += C;
+    }
+  }
+
+  GlobalSum(ctx->com(), &cost_x[0], &total_x[0], Mx);
+  GlobalSum(ctx->com(), &cost_y[0], &total_y[0], My);
+
+  const std::vector<unsigned int>
+    new_procs_x = weighted_ownership_ranges(total_x, Nx, min_size),
+    new_procs_y = weighted_ownership_ranges(total_y, Ny, min_size);
+
+  const double
+    old_imbalance = load_imbalance(cost, procs_x, procs_y),
+    new_imbalance = load_imbalance(cost, new_procs_x, new_procs_y);
+
+  ctx->log()->message(2,
+                      "* Load balancing: max/mean work load per processor is %.3f"
+                      " (equal-area decomposition: %.3f)\n",
+                      std::min(old_imbalance, new_imbalance), old_imbalance);
+
+  if (new_imbalance < old_imbalance) {
+    procs_x = new_procs_x;
+    procs_y = new_procs_y;
+  }
+}
+
 //! Initialize from a configuration database. Does not try to compute ownership ranges.
 void GridParameters::init_from_config(Config::ConstPtr config) {
   Lx = config->get_double("grid_Lx");
@@ -1356,6 +1548,7 @@ IceGrid::Ptr IceGrid::FromOptions(Context::Ptr ctx) {
     input_grid.horizontal_extent_from_options();
     input_grid.vertical_grid_from_options(ctx->config());
     input_grid.ownership_ranges_from_options(ctx->size());
+    input_grid.balance_ownership_ranges(ctx, input_file);
 
     return IceGrid::Ptr(new IceGrid(ctx, input_grid));
   } else {
@@ -108,6 +108,8 @@ public:
   void vertical_grid_from_options(Config::ConstPtr config);
   //! Re-compute ownership ranges. Uses current values of Mx and My.
   void ownership_ranges_from_options(unsigned int size);
+  //! Re-compute ownership ranges to balance the work load using ice thickness in `filename`.
+  void balance_ownership_ranges(Context::Ptr ctx, const std::string &filename);
 
   //! Validate data members.
   void validate() const;
@@ -48,4 +48,31 @@ void GeometryCalculator::compute(IceModelVec2S &bed, IceModelVec2S &thickness,
   
 }
 
+IcyColumns::IcyColumns() {
+  // empty
+}
+
+//! Re-build the list of icy grid points using `mask`.
+/*!
+ * Storage is re-used, so repeated updates do not allocate memory unless
+ * the ice extent grows.
+ */
+void IcyColumns::update(const IceModelVec2Int &mask) {
+  m_i.clear();
+  m_j.clear();
+
+  MaskQuery M(mask);
+
+  IceModelVec::AccessList list(mask);
+
+  for (Points p(*mask.get_grid()); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    if (M.icy(i, j)) {
+      m_i.push_back(i);
+      m_j.push_back(j);
+    }
+  }
+}
+
 } // end of namespace pism
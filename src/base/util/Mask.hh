@@ -22,6 +22,7 @@
 // the following three includes are needed here because of inlined code
 #include "iceModelVec.hh"
 #include "PISMConfigInterface.hh"
+#include "pism_threads.hh"
 
 namespace pism {
 
@@ -210,6 +211,82 @@ protected:
   const IceModelVec2Int &mask;
 };
 
+//! @brief The list of icy grid points in the sub-domain owned by this processor ("active set").
+/*!
+ * Many loops do work in icy columns only. Iterating over this list (using
+ * IcyPoints) instead of testing the mask at every grid point avoids visiting
+ * ice-free parts of the domain.
+ *
+ * The list reflects the mask as of the most recent update() call; it is not
+ * updated automatically.
+ */
+class IcyColumns {
+public:
+  IcyColumns();
+
+  void update(const IceModelVec2Int &mask);
+
+  //! Number of icy grid points owned by this processor.
+  unsigned int size() const {
+    return m_i.size();
+  }
+private:
+  friend class IcyPoints;
+  std::vector<int> m_i, m_j;
+};
+
+/** Iterator class for traversing icy grid points (without ghosts).
+ *
+ * Usage:
+ *
+ * `for (IcyPoints p(columns); p; p.next()) { ... }`
+ */
+class IcyPoints {
+public:
+  IcyPoints(const IcyColumns &columns)
+    : m_i(columns.m_i), m_j(columns.m_j), m_k(0), m_end(columns.m_i.size()) {
+  }
+
+  int i() const {
+    return m_i[m_k];
+  }
+  int j() const {
+    return m_j[m_k];
+  }
+
+  void next() {
+    assert(m_k < m_end);
+    m_k += 1;
+  }
+
+  operator bool() const {
+    return m_k < m_end;
+  }
+protected:
+  IcyPoints(const IcyColumns &columns, size_t first, size_t end)
+    : m_i(columns.m_i), m_j(columns.m_j), m_k(first), m_end(end) {
+  }
+private:
+  const std::vector<int> &m_i, &m_j;
+  size_t m_k, m_end;
+};
+
+/** Iterator class for traversing icy grid points assigned to the
+ * calling thread (see pism_threads.hh).
+ *
+ * Usage:
+ *
+ * `for (ThreadIcyPoints p(columns); p; p.next()) { ... }`
+ */
+class ThreadIcyPoints : public IcyPoints {
+public:
+  ThreadIcyPoints(const IcyColumns &columns)
+    : IcyPoints(columns,
+                threads::block_start(columns.size(), threads::index()),
+                threads::block_start(columns.size(), threads::index() + 1)) {
+  }
+};
+
 } // end of namespace pism
 
 #endif /* _MASK_H_ */
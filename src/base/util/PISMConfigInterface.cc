@@ -518,6 +518,18 @@ void set_config_from_options(Config &config) {
     config.set_double("till_topg_to_phi_topg_max", topg_to_phi[3]);
   }
 
+  // read the comma-separated list of four fracture density parameters
+  options::RealList fractures("-fractures", "gamma, initThreshold, gammaheal, healThreshold");
+  if (fractures.is_set()) {
+    if (fractures->size() != 4) {
+      throw RuntimeError("option -fractures requires exactly 4 arguments");
+    }
+    config.set_double("fracture_density_gamma", fractures[0]);
+    config.set_double("fracture_density_initiation_threshold", fractures[1]);
+    config.set_double("fracture_density_healing_rate", fractures[2]);
+    config.set_double("fracture_density_healing_threshold", fractures[3]);
+  }
+
   // Ice shelves
 
   bool nu_bedrock = options::Bool("-nu_bedrock", "constant viscosity near margins");
@@ -17,6 +17,8 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <typeinfo>
+
 #include "PISMDiagnostic.hh"
 #include "error_handling.hh"
 #include "io/io_helpers.hh"
@@ -33,6 +35,32 @@ Diagnostic::~Diagnostic() {
   // empty
 }
 
+//! Compute a diagnostic quantity, re-using a cached result if possible.
+/*!
+ * Results are cached only while a DiagnosticCache::Scope is active.
+ */
+IceModelVec::Ptr Diagnostic::compute() {
+  Context::ConstPtr ctx = m_grid->ctx();
+  const DiagnosticCache &cache = ctx->diagnostic_cache();
+
+  if (not cache.enabled() or
+      not ctx->config()->get_boolean("cache_diagnostics")) {
+    return this->compute_impl();
+  }
+
+  // The key includes the dynamic type to distinguish diagnostics provided by
+  // different sub-models that happen to use the same variable name.
+  const std::string key = std::string(typeid(*this).name()) + ":" + m_vars[0].get_name();
+
+  IceModelVec::Ptr result = cache.get(key);
+  if (not result) {
+    result = this->compute_impl();
+    cache.insert(key, result);
+  }
+
+  return result;
+}
+
 //! \brief Update a cumulative quantity needed to compute a rate of change.
 //! So far we there is only one such quantity: the rate of change of the ice
 //! thickness.
@@ -96,5 +124,48 @@ void Diagnostic::set_attrs(const std::string &my_long_name,
   }
 }
 
+DiagnosticCache::DiagnosticCache()
+  : m_depth(0) {
+  // empty
+}
+
+//! True if a DiagnosticCache::Scope is active, i.e. if results can be cached.
+bool DiagnosticCache::enabled() const {
+  return m_depth > 0;
+}
+
+//! Get a cached result. Returns an empty pointer if `key` is not found.
+IceModelVec::Ptr DiagnosticCache::get(const std::string &key) const {
+  std::map<std::string, IceModelVec::Ptr>::const_iterator j = m_entries.find(key);
+
+  if (j == m_entries.end()) {
+    return IceModelVec::Ptr();
+  }
+
+  return j->second;
+}
+
+//! Store the result of a diagnostic computation.
+void DiagnosticCache::insert(const std::string &key, IceModelVec::Ptr value) const {
+  m_entries[key] = value;
+}
+
+//! Discard all cached results.
+void DiagnosticCache::clear() const {
+  m_entries.clear();
+}
+
+DiagnosticCache::Scope::Scope(const DiagnosticCache &cache)
+  : m_cache(cache) {
+  m_cache.m_depth += 1;
+}
+
+//! Leaving the outermost scope discards all cached results.
+DiagnosticCache::Scope::~Scope() {
+  m_cache.m_depth -= 1;
+  if (m_cache.m_depth == 0) {
+    m_cache.clear();
+  }
+}
 
 } // end of namespace pism
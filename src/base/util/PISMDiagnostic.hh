@@ -26,6 +26,8 @@
 #include "PISMConfigInterface.hh"
 #include "iceModelVec.hh"
 
+#include <map>
+
 namespace pism {
 
 //! @brief Class representing diagnostic computations in PISM.
@@ -59,7 +61,11 @@ public:
 
   //! @brief Compute a diagnostic quantity and return a pointer to a newly-allocated
   //! IceModelVec.
-  virtual IceModelVec::Ptr compute() = 0;
+  /*!
+   * If the configuration flag `cache_diagnostics` is set, the result may be shared with
+   * other callers (see DiagnosticCache), so it should be treated as read-only.
+   */
+  IceModelVec::Ptr compute();
 
   virtual int get_nvars();
 
@@ -75,6 +81,8 @@ public:
                  const std::string &my_glaciological_units,
                  int N = 0);
 protected:
+  virtual IceModelVec::Ptr compute_impl() = 0;
+
   //! the grid
   IceGrid::ConstPtr m_grid;
   //! the unit system
@@ -87,6 +95,45 @@ protected:
   std::vector<SpatialVariableMetadata> m_vars;
 };
 
+//! @brief Stores results of diagnostic computations so that each quantity is computed at
+//! most once per model state.
+/*!
+ * Output code (`-extra_vars`, snapshots, backups, viewers) and diagnostics
+ * that depend on other diagnostics (`velbar` uses `flux`, `tempbase` uses
+ * `enthalpybase`, etc) may request the same field several times after a
+ * time step.
+ *
+ * Results are cached only while a DiagnosticCache::Scope is active. The
+ * code creating a scope promises that the model state does not change
+ * during its lifetime; all cached results are discarded when the
+ * outermost scope ends. Without a scope (e.g. in drivers other than
+ * IceModel::run() and in Python scripts) nothing is cached.
+ *
+ * Methods are `const` so that the cache can be reached through
+ * Context::ConstPtr, similar to Profiling.
+ */
+class DiagnosticCache {
+public:
+  DiagnosticCache();
+
+  //! Enables caching during the lifetime of an instance.
+  class Scope {
+  public:
+    Scope(const DiagnosticCache &cache);
+    ~Scope();
+  private:
+    const DiagnosticCache &m_cache;
+  };
+
+  bool enabled() const;
+  IceModelVec::Ptr get(const std::string &key) const;
+  void insert(const std::string &key, IceModelVec::Ptr value) const;
+  void clear() const;
+private:
+  mutable int m_depth;
+  mutable std::map<std::string, IceModelVec::Ptr> m_entries;
+};
+
 //! A template derived from Diagnostic, adding a "Model".
 template <class Model>
 class Diag : public Diagnostic {
@@ -19,6 +19,7 @@
 #include <cassert>
 #include <sstream>
 #include <cstdlib>
+#include <algorithm>
 
 #include "error_handling.hh"
 
@@ -59,7 +60,7 @@ Time_Calendar::Time_Calendar(MPI_Comm c, Config::ConstPtr conf,
                              const std::string &calendar_string,
                              units::System::Ptr units_system)
   : Time(conf, calendar_string, units_system),
-    m_com(c) {
+    m_com(c), m_first_year(0) {
 
   std::string ref_date = m_config->get_string("reference_date");
 
@@ -76,6 +77,7 @@ Time_Calendar::Time_Calendar(MPI_Comm c, Config::ConstPtr conf,
     e.add_context("setting time units");
     throw;
   }
+  reset_calendar_cache();
 
   m_run_start = increment_date(0, (int)m_config->get_double("start_year"));
   m_run_end   = increment_date(m_run_start, (int)m_config->get_double("run_length_years"));
@@ -155,6 +157,7 @@ void Time_Calendar::init_from_input_file(const PIO &nc,
       std::string date_string = reference_date_from_file(nc, time_name);
       m_time_units = units::Unit(m_unit_system, "seconds " + date_string);
     }
+    reset_calendar_cache();
 
     // Read time information from the file. (PISM output files don't have time bounds, so we don't
     // bother checking for them.)
@@ -226,6 +229,7 @@ void Time_Calendar::init_from_file(const std::string &filename, const Logger &lo
       std::string date_string = reference_date_from_file(nc, time_name);
       m_time_units = units::Unit(m_unit_system, "seconds " + date_string);
     }
+    reset_calendar_cache();
 
     // Read time information from the file.
     std::vector<double> time;
@@ -264,28 +268,11 @@ double Time_Calendar::mod(double time, unsigned int) const {
 }
 
 double Time_Calendar::year_fraction(double T) const {
-  int year, month, day, hour, minute;
-  double second, year_start, next_year_start;
-
-  utCalendar2_cal(T, m_time_units.get(),
-                  &year, &month, &day, &hour, &minute, &second,
-                  m_calendar_string.c_str());
+  const unsigned int k = month_index(T);
+  const unsigned int year_start = k - k % 12;
 
-  utInvCalendar2_cal(year,
-                     1, 1,            // month, day
-                     0, 0, 0,         // hour, minute, second
-                     m_time_units.get(),
-                     &year_start,
-                     m_calendar_string.c_str());
-
-  utInvCalendar2_cal(year + 1,
-                     1, 1,           // month, day
-                     0, 0, 0,        // hour, minute, second
-                     m_time_units.get(),
-                     &next_year_start,
-                     m_calendar_string.c_str());
-
-  return (T - year_start) / (next_year_start - year_start);
+  return ((T - m_month_start[year_start]) /
+          (m_month_start[year_start + 12] - m_month_start[year_start]));
 }
 
 std::string Time_Calendar::date(double T) const {
@@ -315,61 +302,123 @@ std::string Time_Calendar::end_date() const {
 }
 
 double Time_Calendar::calendar_year_start(double T) const {
-  int year, month, day, hour, minute;
-  double second, result;
+  const unsigned int k = month_index(T);
 
-  // Get the date corresponding to time T:
-  utCalendar2_cal(T, m_time_units.get(),
-                  &year, &month, &day, &hour, &minute, &second,
-                  m_calendar_string.c_str());
+  return m_month_start[k - k % 12];
+}
 
-  // Get the time in seconds corresponding to the beginning of the
-  // year.
-  utInvCalendar2_cal(year,
-                     1, 1, 0, 0, 0.0, // month, day, hour, minute, second
-                     m_time_units.get(), &result,
-                     m_calendar_string.c_str());
+/*!
+ * Keeps the month, the day, and the time of day. If the resulting date does
+ * not exist (stepping from February 29 to a non-leap year), uses the previous
+ * day instead.
+ */
+double Time_Calendar::increment_date(double T, int years) const {
+  unsigned int k = month_index(T);
 
-  return result;
-}
+  const int
+    year  = m_first_year + (int)(k / 12),
+    month = k % 12;             // zero-based
 
+  // time since the beginning of the month
+  double offset = T - m_month_start[k];
 
-// FIXME: this feeds invalid dates to utInvCalendar2_cal! (step 1 year from Feb 29...)
-double Time_Calendar::increment_date(double T, int years) const {
-  int year, month, day, hour, minute;
-  double second, result;
+  // this may re-allocate m_month_start and change m_first_year
+  cache_years(year + years, year + years);
 
-  // Get the date corresponding ti time T:
-  utCalendar2_cal(T, m_time_units.get(),
-                  &year, &month, &day, &hour, &minute, &second,
-                  m_calendar_string.c_str());
+  k = 12 * (year + years - m_first_year) + month;
 
-  calcalcs_cal *cal = NULL;
-  int errcode, leap = 0;
-  cal = ccs_init_calendar(m_calendar_string.c_str());
-  assert(cal != NULL);
-  errcode = ccs_isleap(cal, year + years, &leap);
-  assert(errcode == 0);
-  ccs_free_calendar(cal);
+  const double
+    seconds_per_day = 86400.0,
+    month_length    = m_month_start[k + 1] - m_month_start[k];
+
+  if (offset >= month_length) {
+    const int day = (int)(offset / seconds_per_day) + 1;
 
-  if (leap == 0 && month == 2 && day == 29) {
     PetscErrorCode ierr = PetscPrintf(m_com,
                                       "PISM WARNING: date %d year(s) since %d-%d-%d does not exist."
                                       " Using %d-%d-%d instead of %d-%d-%d.\n",
                                       years,
-                                      year, month, day,
-                                      year + years, month, day-1,
-                                      year + years, month, day);
+                                      year, month + 1, day,
+                                      year + years, month + 1, day-1,
+                                      year + years, month + 1, day);
     PISM_CHK(ierr, "PetscPrintf");
-    day -= 1;
+    offset -= seconds_per_day;
+  }
+
+  return m_month_start[k] + offset;
+}
+
+//! Discard cached month boundaries. Call this every time the calendar or time units change.
+void Time_Calendar::reset_calendar_cache() {
+  m_month_start.clear();
+  m_first_year = 0;
+}
+
+//! @brief Make sure that beginnings of all months of years from `first` to `last` (inclusive)
+//! are cached.
+/*!
+ * The cache is extended in chunks to avoid re-allocating it often, so (once
+ * the cache covers the run) no udunits or calcalcs calls are made.
+ */
+void Time_Calendar::cache_years(int first, int last) const {
+  const int chunk = 16;
+
+  int
+    cached_first = m_first_year,
+    cached_last  = m_first_year + (int)(m_month_start.size() / 12) - 1;
+
+  if (not m_month_start.empty() and first >= cached_first and last <= cached_last) {
+    return;
+  }
+
+  if (m_month_start.empty()) {
+    cached_first = first;
+    cached_last  = last + chunk;
+  } else {
+    cached_first = std::min(cached_first, first - chunk);
+    cached_last  = std::max(cached_last, last + chunk);
+  }
+
+  const unsigned int N = 12 * (cached_last - cached_first + 1) + 1;
+  std::vector<double> month_start(N);
+
+  for (unsigned int k = 0; k < N; ++k) {
+    const int
+      year  = cached_first + (int)(k / 12),
+      month = k % 12 + 1;
+
+    int errcode = utInvCalendar2_cal(year, month, 1, // year, month, day
+                                     0, 0, 0.0,      // hour, minute, second
+                                     m_time_units.get(), &month_start[k],
+                                     m_calendar_string.c_str());
+    PISM_C_CHK(errcode, 0, "utInvCalendar2_cal");
+  }
+
+  m_month_start.swap(month_start);
+  m_first_year = cached_first;
+}
+
+//! Returns the index of the month containing `T` in `m_month_start`, extending the cache if needed.
+unsigned int Time_Calendar::month_index(double T) const {
+  if (m_month_start.empty() or
+      T < m_month_start.front() or
+      T >= m_month_start.back()) {
+    int year, month, day, hour, minute;
+    double second;
+
+    utCalendar2_cal(T, m_time_units.get(),
+                    &year, &month, &day, &hour, &minute, &second,
+                    m_calendar_string.c_str());
+
+    cache_years(year, year);
   }
 
-  // Get the time in seconds corresponding to the new date.
-  utInvCalendar2_cal(year + years, month, day,
-                     hour, minute, second, m_time_units.get(), &result,
-                     m_calendar_string.c_str());
+  std::vector<double>::const_iterator j = std::upper_bound(m_month_start.begin(),
+                                                           m_month_start.end(),
+                                                           T);
+  assert(j != m_month_start.begin());
 
-  return result;
+  return (j - m_month_start.begin()) - 1;
 }
 
 /**
@@ -22,6 +22,8 @@
 #include "PISMTime.hh"
 #include "PISMUnits.hh"
 
+#include <vector>
+
 namespace pism {
 
 class Time_Calendar : public Time
@@ -91,7 +93,21 @@ protected:
 
   void compute_times_yearly(std::vector<double> &result) const;
 private:
+  void reset_calendar_cache();
+  void cache_years(int first, int last) const;
+  unsigned int month_index(double T) const;
+
   MPI_Comm m_com;
+
+  //! Cached times of the beginning of months, in seconds since the reference date.
+  /*!
+   * `m_month_start[12 * (Y - m_first_year) + (M - 1)]` corresponds to the
+   * month `M` of the year `Y`. The last element is the beginning of the year
+   * following the last cached year. Filled (and extended) as needed by
+   * cache_years().
+   */
+  mutable std::vector<double> m_month_start;
+  mutable int m_first_year;
   // Hide copy constructor / assignment operator.
   Time_Calendar(Time_Calendar const &);
   Time_Calendar & operator=(Time_Calendar const &);
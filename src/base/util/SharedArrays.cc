@@ -0,0 +1,266 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstdlib>
+#include <sstream>
+
+#include "SharedArrays.hh"
+#include "error_handling.hh"
+
+namespace pism {
+
+SharedArrays::Provider::~Provider() {
+  // empty
+}
+
+SharedArrays::Array::Array()
+  : data(NULL), window(MPI_WIN_NULL), com(MPI_COMM_NULL) {
+  // empty
+}
+
+SharedArrays::SharedArrays()
+  : m_sharing(false) {
+  // empty
+}
+
+//! Does not free shared memory windows (see release()).
+/*!
+ * MPI_Win_free() is collective, but the order in which processes
+ * destroy their models (and their SharedArrays) is not. Windows that
+ * were not released are freed by MPI_Finalize().
+ */
+SharedArrays::~SharedArrays() {
+  // empty
+}
+
+//! @brief Free shared memory windows. Arrays are not available after
+//! this call.
+/*!
+ * This is collective on each group of processes sharing an array, so
+ * all processes that called fulfill() have to call it, after all users
+ * of shared arrays are destroyed. Processes free windows in the order
+ * of keys, so groups sharing different sets of arrays cannot deadlock.
+ */
+void SharedArrays::release() const {
+  std::map<std::string, Array>::iterator j;
+  for (j = m_arrays.begin(); j != m_arrays.end(); ++j) {
+    if (j->second.window != MPI_WIN_NULL) {
+      MPI_Win_free(&j->second.window);
+    }
+    if (j->second.com != MPI_COMM_NULL) {
+      MPI_Comm_free(&j->second.com);
+    }
+  }
+  m_arrays.clear();
+}
+
+//! Defer requests until fulfill() is called.
+void SharedArrays::enable_sharing() const {
+  m_sharing = true;
+}
+
+//! Request an array. Use get() to access it after it is computed.
+/*!
+ * `provider` has to remain valid until the request is fulfilled.
+ */
+void SharedArrays::request(const std::string &key, unsigned int size,
+                           const Provider &provider) const {
+  if (m_arrays.find(key) != m_arrays.end()) {
+    // this array is available already
+    return;
+  }
+
+  Request r;
+  r.size     = size;
+  r.provider = &provider;
+
+  if (m_sharing) {
+    m_requests[key] = r;
+  } else {
+    compute_locally(key, r);
+  }
+}
+
+//! Returns an array computed earlier.
+const double* SharedArrays::get(const std::string &key) const {
+  std::map<std::string, Array>::const_iterator j = m_arrays.find(key);
+  if (j == m_arrays.end()) {
+    throw RuntimeError::formatted("shared array '%s' is not available"
+                                  " (it was not requested or the request was not fulfilled yet)",
+                                  key.c_str());
+  }
+  return j->second.data;
+}
+
+//! @brief Compute all pending requests, sharing arrays with other
+//! processes in `com` running on the same node.
+/*!
+ * This is collective on `com`. Processes without pending requests
+ * have to call it too.
+ */
+void SharedArrays::fulfill(MPI_Comm com) const {
+  int rank = 0, size = 0;
+  MPI_Comm_rank(com, &rank);
+  MPI_Comm_size(com, &size);
+
+  // Collect requests of all processes: each request is stored as two
+  // lines, "key" and "size".
+  std::map<std::string, unsigned int> keys;
+  {
+    std::ostringstream local;
+    std::map<std::string, Request>::const_iterator j;
+    for (j = m_requests.begin(); j != m_requests.end(); ++j) {
+      local << j->first << "\n" << j->second.size << "\n";
+    }
+    const std::string buffer = local.str();
+
+    int length = buffer.size();
+    std::vector<int> lengths(size), offsets(size);
+    MPI_Allgather(&length, 1, MPI_INT, &lengths[0], 1, MPI_INT, com);
+
+    int total = 0;
+    for (int r = 0; r < size; ++r) {
+      offsets[r] = total;
+      total += lengths[r];
+    }
+
+    std::vector<char> all(total + 1);
+    MPI_Allgatherv(const_cast<char*>(buffer.c_str()), length, MPI_CHAR,
+                   &all[0], &lengths[0], &offsets[0], MPI_CHAR, com);
+
+    std::istringstream input(std::string(all.begin(), all.begin() + total));
+    std::string key, length_string;
+    while (std::getline(input, key) and std::getline(input, length_string)) {
+      const unsigned int N = strtoul(length_string.c_str(), NULL, 10);
+
+      if (keys.find(key) != keys.end() and keys[key] != N) {
+        throw RuntimeError::formatted("requests for the shared array '%s' disagree on its size",
+                                      key.c_str());
+      }
+      keys[key] = N;
+    }
+  }
+
+  // Arrays can be shared by processes on the same node only.
+  MPI_Comm node = MPI_COMM_NULL;
+#if MPI_VERSION >= 3
+  MPI_Comm_split_type(com, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &node);
+#else
+  MPI_Comm_split(com, rank, 0, &node);
+#endif
+
+  try {
+    // all processes iterate over keys in the same order
+    std::map<std::string, unsigned int>::const_iterator k;
+    for (k = keys.begin(); k != keys.end(); ++k) {
+      std::map<std::string, Request>::const_iterator j = m_requests.find(k->first);
+      const bool requested = j != m_requests.end();
+
+      MPI_Comm group = MPI_COMM_NULL;
+      MPI_Comm_split(node, requested ? 0 : MPI_UNDEFINED, rank, &group);
+
+      if (requested) {
+        compute_shared(k->first, j->second, group);
+      }
+    }
+  } catch (...) {
+    MPI_Comm_free(&node);
+    m_requests.clear();
+    throw;
+  }
+
+  MPI_Comm_free(&node);
+  m_requests.clear();
+}
+
+void SharedArrays::compute_locally(const std::string &key, const Request &request) const {
+  Array &a = m_arrays[key];
+
+  a.storage.resize(request.size);
+  if (request.size > 0) {
+    request.provider->compute(0, request.size, &a.storage[0]);
+  }
+  a.data = request.size > 0 ? &a.storage[0] : NULL;
+}
+
+//! Compute an array using all processes in `com` and store it in a
+//! shared memory window. Takes ownership of `com`.
+void SharedArrays::compute_shared(const std::string &key, const Request &request,
+                                  MPI_Comm com) const {
+#if MPI_VERSION >= 3
+  int rank = 0, size = 0;
+  MPI_Comm_rank(com, &rank);
+  MPI_Comm_size(com, &size);
+
+  Array &a = m_arrays[key];
+  a.com = com;
+
+  // the first process in the group allocates the whole array
+  double *array = NULL;
+  const MPI_Aint local_size = rank == 0 ? request.size * sizeof(double) : 0;
+  MPI_Win_allocate_shared(local_size, sizeof(double), MPI_INFO_NULL, com,
+                          &array, &a.window);
+  {
+    MPI_Aint window_size = 0;
+    int displacement_unit = 0;
+    MPI_Win_shared_query(a.window, 0, &window_size, &displacement_unit, &array);
+  }
+
+  // each process computes a contiguous part
+  const unsigned int
+    begin = ((unsigned long int)request.size * rank) / size,
+    end   = ((unsigned long int)request.size * (rank + 1)) / size;
+
+  int failed = 0;
+  std::string message;
+
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, a.window);
+  try {
+    request.provider->compute(begin, end, array);
+  } catch (std::exception &e) {
+    failed = 1;
+    message = e.what();
+  } catch (...) {
+    failed = 1;
+  }
+  MPI_Win_sync(a.window);
+  MPI_Barrier(com);
+  MPI_Win_sync(a.window);
+  MPI_Win_unlock_all(a.window);
+
+  int any_failed = 0;
+  MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, com);
+
+  if (any_failed != 0) {
+    MPI_Win_free(&a.window);
+    MPI_Comm_free(&a.com);
+    m_arrays.erase(key);
+    throw RuntimeError::formatted("failed to compute the shared array '%s'%s%s",
+                                  key.c_str(), message.empty() ? "" : ": ", message.c_str());
+  }
+
+  a.data = array;
+#else
+  // MPI-2 has no shared memory windows
+  MPI_Comm_free(&com);
+  compute_locally(key, request);
+#endif
+}
+
+} // end of namespace pism
@@ -0,0 +1,89 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _SHAREDARRAYS_H_
+#define _SHAREDARRAYS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+namespace pism {
+
+//! @brief Read-only arrays that can be shared by processes running
+//! different models (e.g. members of an ensemble) on the same node.
+/*!
+ * A component requests an array using a key that identifies its
+ * contents completely (two requests with the same key have to produce
+ * the same values) and a Provider that can compute any part of it.
+ *
+ * By default requests are computed immediately. If sharing is enabled
+ * (see enable_sharing()), requests are deferred until fulfill() is
+ * called: then processes that requested the same array on the same node
+ * split the work of computing it and store one copy in an MPI-3 shared
+ * memory window. Windows are freed by release(), which is collective.
+ */
+class SharedArrays {
+public:
+  SharedArrays();
+  ~SharedArrays();
+
+  //! Computes values of a shared array.
+  class Provider {
+  public:
+    virtual ~Provider();
+    //! Compute entries with indices in `[begin, end)`, storing them in `array[begin]`, ...
+    virtual void compute(unsigned int begin, unsigned int end, double *array) const = 0;
+  };
+
+  void enable_sharing() const;
+  void request(const std::string &key, unsigned int size, const Provider &provider) const;
+  void fulfill(MPI_Comm com) const;
+  void release() const;
+  const double* get(const std::string &key) const;
+private:
+  struct Array {
+    Array();
+    const double *data;
+    std::vector<double> storage; // used if the array is not shared
+    MPI_Win window;
+    MPI_Comm com;
+  };
+  struct Request {
+    unsigned int size;
+    const Provider *provider;
+  };
+
+  mutable bool m_sharing;
+  mutable std::map<std::string, Request> m_requests;
+  mutable std::map<std::string, Array> m_arrays;
+
+  void compute_locally(const std::string &key, const Request &request) const;
+  void compute_shared(const std::string &key, const Request &request, MPI_Comm com) const;
+
+  // disable copying and assignments
+  SharedArrays(const SharedArrays &other);
+  SharedArrays & operator=(const SharedArrays &);
+};
+
+} // end of namespace pism
+
+#endif /* _SHAREDARRAYS_H_ */
@@ -18,6 +18,7 @@
  */
 
 #include "error_handling.hh"
+#include "pism_threads.hh"
 #include <petsc.h>
 
 #include <stdexcept>
@@ -151,8 +152,10 @@ void check_petsc_call(int errcode,
 }
 
 ParallelSection::ParallelSection(MPI_Comm com)
-  : m_failed(false), m_com(com) {
-  // empty
+  : m_failed(false), m_com(com), m_rank(0) {
+  // get the rank here so that failed() does not have to call MPI
+  // from a thread other than the main one
+  MPI_Comm_rank(m_com, &m_rank);
 }
 
 ParallelSection::~ParallelSection() {
@@ -162,18 +165,23 @@ ParallelSection::~ParallelSection() {
 //! @brief Indicates a failure of a parallel section.
 /*!
  * This should be called from a `catch (...) { ... }` block **only**.
+ *
+ * May be called by several threads of a parallel region (see
+ * pism_threads.hh); check() has to be called outside of it.
  */
 void ParallelSection::failed() {
-  int rank = 0;
-  MPI_Comm_rank(m_com, &rank);
+  const int rank = m_rank;
 
-  PetscPrintf(MPI_COMM_SELF, "PISM ERROR: ### Rank %d message:\n", rank);
+  PISM_OMP_CRITICAL
+  {
+    PetscPrintf(MPI_COMM_SELF, "PISM ERROR: ### Rank %d message:\n", rank);
 
-  handle_fatal_errors(MPI_COMM_SELF);
+    handle_fatal_errors(MPI_COMM_SELF);
 
-  PetscPrintf(MPI_COMM_SELF, "PISM ERROR: ### Rank %d message ends here.\n", rank);
+    PetscPrintf(MPI_COMM_SELF, "PISM ERROR: ### Rank %d message ends here.\n", rank);
 
-  m_failed = true;
+    m_failed = true;
+  }
 }
 
 void ParallelSection::reset() {
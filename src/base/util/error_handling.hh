@@ -54,6 +54,7 @@ public:
 private:
   bool m_failed;
   MPI_Comm m_com;
+  int m_rank;
 };
 
 void handle_fatal_errors(MPI_Comm com);
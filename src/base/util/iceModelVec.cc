@@ -633,6 +633,37 @@ void  IceModelVec::update_ghosts() {
 #endif
 }
 
+//! @brief Adds values at ghost points to values at corresponding points
+//! owned by other processors, then updates ghost points.
+/*!
+ * Use this to add contributions of a processor to values owned by its
+ * neighbors ("halo accumulation"): set the field (including ghosts) to
+ * zero, add contributions at owned and ghost points, then call this
+ * method.
+ */
+void IceModelVec::accumulate_ghosts() {
+  if (m_has_ghosts == false) {
+    return;
+  }
+
+  assert(m_v != NULL);
+
+  petsc::TemporaryGlobalVec tmp(m_da);
+
+  PetscErrorCode ierr = VecSet(tmp, 0.0);
+  PISM_CHK(ierr, "VecSet");
+
+  ierr = DMLocalToGlobalBegin(*m_da, m_v, ADD_VALUES, tmp);
+  PISM_CHK(ierr, "DMLocalToGlobalBegin");
+
+  ierr = DMLocalToGlobalEnd(*m_da, m_v, ADD_VALUES, tmp);
+  PISM_CHK(ierr, "DMLocalToGlobalEnd");
+
+  global_to_local(m_da, tmp, m_v);
+
+  inc_state_counter();          // mark as modified
+}
+
 void IceModelVec::global_to_local(petsc::DM::Ptr dm, Vec source, Vec destination) const {
   PetscErrorCode ierr;
 
@@ -667,12 +698,8 @@ void  IceModelVec::update_ghosts(IceModelVec &destination) const {
     ierr = DMLocalToLocalEnd(*m_da, m_v, INSERT_VALUES, destination.m_v);
     PISM_CHK(ierr, "DMLocalToLocalEnd");
 #endif
-    return;
-  }
-
-  if (m_has_ghosts == false && destination.m_has_ghosts == true) {
+  } else if (m_has_ghosts == false && destination.m_has_ghosts == true) {
     global_to_local(destination.m_da, m_v, destination.m_v);
-    return;
   }
 
   destination.inc_state_counter();          // mark as modified
@@ -896,28 +923,47 @@ void IceModelVec::write(const PIO &nc) const {
   write_impl(nc);
 }
 
-IceModelVec::AccessList::AccessList() {
+IceModelVec::AccessList::AccessList()
+  : m_size(0) {
   // empty
 }
 
 IceModelVec::AccessList::~AccessList() {
-  while (not m_vecs.empty()) {
+  // end access in the reverse order
+  while (not m_overflow.empty()) {
+    const IceModelVec *vec = m_overflow.back();
+    m_overflow.pop_back();
     try {
-      m_vecs.back()->end_access();
-      m_vecs.pop_back();
+      vec->end_access();
+    } catch (...) {
+      handle_fatal_errors(MPI_COMM_SELF);
+    }
+  }
+
+  while (m_size > 0) {
+    m_size -= 1;
+    try {
+      m_buffer[m_size]->end_access();
     } catch (...) {
       handle_fatal_errors(MPI_COMM_SELF);
     }
   }
 }
 
-IceModelVec::AccessList::AccessList(const IceModelVec &vec) {
+IceModelVec::AccessList::AccessList(const IceModelVec &vec)
+  : m_size(0) {
   add(vec);
 }
 
 void IceModelVec::AccessList::add(const IceModelVec &vec) {
   vec.begin_access();
-  m_vecs.push_back(&vec);
+
+  if (m_size < buffer_size) {
+    m_buffer[m_size] = &vec;
+    m_size += 1;
+  } else {
+    m_overflow.push_back(&vec);
+  }
 }
 
 void convert_vec(Vec v, units::System::Ptr system,
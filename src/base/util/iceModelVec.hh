@@ -220,6 +220,7 @@ public:
   virtual void  end_access() const;
   virtual void  update_ghosts();
   virtual void  update_ghosts(IceModelVec &destination) const;
+  void accumulate_ghosts();
 
   void  set(double c);
 
@@ -291,6 +292,12 @@ public:
 public:
 
   //! Makes sure that we call begin_access() and end_access() for all accessed IceModelVecs.
+  //! Calls begin_access() on fields it is given and end_access() when it goes out of scope.
+  /*!
+   * Pointers to the first `buffer_size` fields are stored in a
+   * fixed-size array, so creating an AccessList in a kernel that is
+   * called often does not allocate memory.
+   */
   class AccessList {
   public:
     AccessList();
@@ -298,7 +305,15 @@ public:
     ~AccessList();
     void add(const IceModelVec &v);
   private:
-    std::vector<const IceModelVec*> m_vecs;
+    static const unsigned int buffer_size = 16;
+    const IceModelVec* m_buffer[buffer_size];
+    unsigned int m_size;
+    //! fields that did not fit in `m_buffer`
+    std::vector<const IceModelVec*> m_overflow;
+
+    // disable copying
+    AccessList(const AccessList &);
+    AccessList& operator=(const AccessList &);
   };
 };
 
@@ -325,6 +340,7 @@ public:
   virtual void set_component(unsigned int n, const IceModelVec2S &source);
   inline double& operator() (int i, int j, int k);
   inline const double& operator() (int i, int j, int k) const;
+  double* local_array(unsigned int dof, int &i_first, int &j_first, int &j_count) const;
   void create(IceGrid::ConstPtr my_grid, const std::string &my_short_name,
               IceModelVecKind ghostedp, unsigned int stencil_width, int dof);
 protected:
@@ -452,6 +468,49 @@ public:
   inline StarStencil<double> star(int i, int j) const;
 };
 
+//! \brief Typed access to the local storage of a 2D field, bypassing row pointers.
+/*!
+ * Use
+ *
+ * - `RawArray2<double>` with IceModelVec2S and IceModelVec2Int,
+ * - `RawArray2<Vector2>` with IceModelVec2V,
+ * - `RawArray2<double, 2>` with IceModelVec2Stag.
+ *
+ * The stride of the last index is a compile-time constant, so
+ * `a(i, j, k)` computes the address of a value directly instead of
+ * going through `double***` row pointers.
+ *
+ * The field has to be accessed (e.g. using an IceModelVec::AccessList)
+ * during the whole lifetime of a RawArray2.
+ *
+ * Example:
+ *
+ *     IceModelVec::AccessList list(thickness);
+ *     RawArray2<double> H(thickness);
+ *     for (Points p(*grid); p; p.next()) {
+ *       const int i = p.i(), j = p.j();
+ *       H(i, j) = std::max(H(i, j), 0.0);
+ *     }
+ */
+template<typename T, unsigned int N = 1>
+class RawArray2 {
+public:
+  RawArray2(const IceModelVec2 &field) {
+    int i_first = 0, j_first = 0;
+    double *data = field.local_array(sizeof(T) * N / sizeof(double),
+                                     i_first, j_first, m_stride);
+    m_base   = reinterpret_cast<T*>(data);
+    m_offset = (i_first * m_stride + j_first) * (int)N;
+  }
+
+  inline T& operator()(int i, int j, unsigned int k = 0) const {
+    return m_base[(i * m_stride + j) * (int)N + (int)k - m_offset];
+  }
+private:
+  T *m_base;
+  int m_stride, m_offset;
+};
+
 //! \brief A virtual class collecting methods common to ice and bedrock 3D
 //! fields.
 class IceModelVec3D : public IceModelVec {
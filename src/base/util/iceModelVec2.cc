@@ -588,6 +588,42 @@ double IceModelVec2S::min() const {
 
 // IceModelVec2
 
+//! @brief Returns the pointer to the local storage of this field (including ghosts).
+/*!
+ * Values are stored so that the value at `(i, j)` (component `k`) is
+ *
+ *     result[((i - i_first) * j_count + (j - j_first)) * dof + k]
+ *
+ * The field has to be accessed (see begin_access()). See RawArray2.
+ *
+ * @param[in] dof expected number of degrees of freedom
+ * @param[out] i_first first `i` index in the local storage
+ * @param[out] j_first first `j` index in the local storage
+ * @param[out] j_count size of the local storage in the `j` direction
+ */
+double* IceModelVec2::local_array(unsigned int dof, int &i_first, int &j_first, int &j_count) const {
+  if (dof != m_dof) {
+    throw RuntimeError::formatted("%s has %d degrees of freedom (%d requested)",
+                                  m_name.c_str(), m_dof, dof);
+  }
+
+  if (array == NULL) {
+    throw RuntimeError::formatted("%s: begin_access() was not called", m_name.c_str());
+  }
+
+  const int width = m_has_ghosts ? m_da_stencil_width : 0;
+
+  i_first = m_grid->xs() - width;
+  j_first = m_grid->ys() - width;
+  j_count = m_grid->ym() + 2 * width;
+
+  if (begin_end_access_use_dof) {
+    return &static_cast<double***>(array)[i_first][j_first][0];
+  } else {
+    return static_cast<double**>(array)[i_first] + j_first * m_dof;
+  }
+}
+
 void IceModelVec2::get_component(unsigned int n, IceModelVec2S &result) const {
 
   IceModelVec2::get_dof(result.get_dm(), result.m_v, n);
@@ -69,6 +69,21 @@ void IceModelVec2T::create(IceGrid::ConstPtr my_grid, const std::string &my_shor
 
   IceModelVec2S::create(my_grid, my_short_name, WITHOUT_GHOSTS, width);
 
+  const std::string precision = m_grid->ctx()->config()->get_string("climate_forcing_buffer_precision");
+
+  if (precision == "single") {
+    m_single.resize(m_grid->xm() * m_grid->ym() * n_records);
+
+    const double MiB = 1024.0 * 1024.0,
+      size = double(m_grid->Mx()) * double(m_grid->My()) * n_records;
+    m_grid->ctx()->log()->message(2,
+                                  "  storing %d records of '%s' in single precision"
+                                  " (%.1f MiB instead of %.1f MiB)\n",
+                                  n_records, my_short_name.c_str(),
+                                  size * sizeof(float) / MiB, size * sizeof(double) / MiB);
+    return;
+  }
+
   // initialize the m_da3 member:
   m_da3 = m_grid->get_dm(this->n_records, this->m_da_stencil_width);
 
@@ -82,8 +97,13 @@ double*** IceModelVec2T::get_array3() {
   return reinterpret_cast<double***>(array3);
 }
 
+//! Returns the pointer to records at `i,j` (single precision storage only).
+float* IceModelVec2T::single_column(int i, int j) {
+  return &m_single[((i - m_grid->xs()) * m_grid->ym() + (j - m_grid->ys())) * n_records];
+}
+
 void IceModelVec2T::begin_access() const {
-  if (m_access_counter == 0) {
+  if (m_access_counter == 0 and m_da3) {
     PetscErrorCode ierr = DMDAVecGetArrayDOF(*m_da3, m_v3, &array3);
     PISM_CHK(ierr, "DMDAVecGetArrayDOF");
   }
@@ -97,7 +117,7 @@ void IceModelVec2T::end_access() const {
   // this call will decrement the m_access_counter
   IceModelVec2S::end_access();
 
-  if (m_access_counter == 0) {
+  if (m_access_counter == 0 and m_da3) {
     PetscErrorCode ierr = DMDAVecRestoreArrayDOF(*m_da3, m_v3, &array3);
     PISM_CHK(ierr, "DMDAVecRestoreArrayDOF");
     array3 = NULL;
@@ -371,6 +391,16 @@ void IceModelVec2T::discard(int number) {
 
   N -= number;
 
+  if (not m_single.empty()) {
+    for (Points p(*m_grid); p; p.next()) {
+      float *column = single_column(p.i(), p.j());
+      for (unsigned int k = 0; k < N; ++k) {
+        column[k] = column[k + number];
+      }
+    }
+    return;
+  }
+
   double ***a3 = get_array3();
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
@@ -385,6 +415,16 @@ void IceModelVec2T::discard(int number) {
 //! Sets the record number n to the contents of the (internal) Vec v.
 void IceModelVec2T::set_record(int n) {
 
+  if (not m_single.empty()) {
+    double **a2 = get_array();
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+      single_column(i, j)[n] = a2[i][j];
+    }
+    end_access();
+    return;
+  }
+
   double  **a2 = get_array();
   double ***a3 = get_array3();
   for (Points p(*m_grid); p; p.next()) {
@@ -398,6 +438,16 @@ void IceModelVec2T::set_record(int n) {
 //! Sets the (internal) Vec v to the contents of the nth record.
 void IceModelVec2T::get_record(int n) {
 
+  if (not m_single.empty()) {
+    double **a2 = get_array();
+    for (Points p(*m_grid); p; p.next()) {
+      const int i = p.i(), j = p.j();
+      a2[i][j] = single_column(i, j)[n];
+    }
+    end_access();
+    return;
+  }
+
   double  **a2 = get_array();
   double ***a3 = get_array3();
   for (Points p(*m_grid); p; p.next()) {
@@ -566,9 +616,17 @@ void IceModelVec2T::init_interpolation(const std::vector<double> &ts) {
  *
  */
 void IceModelVec2T::interp(int i, int j, std::vector<double> &result) {
-  double ***a3 = (double***) array3;
   unsigned int ts_length = m_interp_indices.size();
 
+  if (not m_single.empty()) {
+    const float *column = single_column(i, j);
+    for (unsigned int k = 0; k < ts_length; ++k) {
+      result[k] = column[m_interp_indices[k]];
+    }
+    return;
+  }
+
+  double ***a3 = (double***) array3;
   for (unsigned int k = 0; k < ts_length; ++k) {
     result[k] = a3[i][j][m_interp_indices[k]];
   }
@@ -584,8 +642,12 @@ double IceModelVec2T::average(int i, int j) {
   double result = 0.0;
 
   if (N == 1) {
-    double ***a3 = (double***) array3;
-    result = a3[i][j][0];
+    if (not m_single.empty()) {
+      result = single_column(i, j)[0];
+    } else {
+      double ***a3 = (double***) array3;
+      result = a3[i][j][0];
+    }
   } else {
     std::vector<double> values(M);
 
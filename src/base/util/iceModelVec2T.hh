@@ -19,6 +19,8 @@
 #ifndef __IceModelVec2T_hh
 #define __IceModelVec2T_hh
 
+#include <vector>
+
 #include "iceModelVec.hh"
 #include "MaxTimestep.hh"
 
@@ -38,6 +40,11 @@ namespace pism {
   records so that data corresponding to a grid point are stored in adjacent
   memory locations.
 
+  Records are stored in double precision (in a 3D PETSc Vec) by default. If
+  the configuration parameter `climate_forcing_buffer_precision` is set to
+  "single", they are stored as `float`s (using the same layout), halving the
+  memory footprint of long forcing time-series.
+
   IceModelVec2T is always global (%i.e. has no ghosts).
 
   Both versions of interp() use piecewise-constant interpolation and
@@ -141,7 +148,11 @@ protected:
   unsigned int m_period;        // in years
   double m_reference_time;      // in seconds
 
+  //! single-precision storage of records (used instead of m_v3 if not empty)
+  std::vector<float> m_single;
+
   double*** get_array3();
+  float* single_column(int i, int j);
   virtual void update(unsigned int start);
   virtual void discard(int N);
 };
@@ -80,9 +80,13 @@ static void subset_start_and_count(const std::vector<double> &x,
   processor.
 */
 LocalInterpCtx::LocalInterpCtx(const grid_info &input, const IceGrid &grid,
-                               double z_min, double z_max) {
+                               const std::vector<double> &zlevels_out) {
   const int T = 0, X = 1, Y = 2, Z = 3; // indices, just for clarity
 
+  const double
+    z_min = zlevels_out.front(),
+    z_max = zlevels_out.back();
+
   com = grid.com;
   rank = grid.rank();
   report_range = true;
@@ -172,6 +176,20 @@ LocalInterpCtx::LocalInterpCtx(const grid_info &input, const IceGrid &grid,
   y_left = y_interp.left();
   y_right = y_interp.right();
   y_alpha = y_interp.alpha();
+
+  // Compute indices of neighbors and interpolation coefficients in the vertical direction.
+  const unsigned int nlevels = zlevels_out.size();
+  if (nlevels > 1) {
+    LinearInterpolation z_interp(zlevels, zlevels_out);
+    z_below = z_interp.left();
+    z_above = z_interp.right();
+    z_alpha = z_interp.alpha();
+  } else {
+    // we don't need to interpolate vertically in the 2-D case
+    z_below.assign(nlevels, 0);
+    z_above.assign(nlevels, 0);
+    z_alpha.assign(nlevels, 0.0);
+  }
 }
 
 LocalInterpCtx::~LocalInterpCtx() {
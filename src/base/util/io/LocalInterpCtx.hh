@@ -40,14 +40,19 @@ class grid_info;
 
   The arrays `start` and `count` have 4 integer entries, corresponding to the dimensions
   \f$t, x, y, z(zb)\f$.
+
+  Interpolation indices and weights depend on the input and the target grids only, so a
+  context can be re-used to regrid all fields that share a grid (see PIO::get_interp_context()).
 */
 class LocalInterpCtx {
 public:
-  LocalInterpCtx(const grid_info &g, const IceGrid &grid, double z_min, double z_max);
+  LocalInterpCtx(const grid_info &g, const IceGrid &grid, const std::vector<double> &zlevels_out);
   ~LocalInterpCtx();
   unsigned int start[4], count[4]; // Indices in netCDF file.
   std::vector<int> x_left, x_right, y_left, y_right; // neighbors
   std::vector<double> x_alpha, y_alpha;
+  std::vector<int> z_below, z_above; //!< input levels below and above each target level
+  std::vector<double> z_alpha;       //!< vertical interpolation weights
   //! temporary buffer
   std::vector<double> buffer;
   std::vector<double> zlevels;     //!< input z levels
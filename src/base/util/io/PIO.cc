@@ -19,6 +19,7 @@
 #include <cassert>
 #include <cstdio>
 #include <deque>
+#include <map>
 #include <petscvec.h>
 
 #include "PIO.hh"
@@ -81,6 +82,7 @@ struct PIO::Impl {
   std::string backend_type;
   io::NCFile::Ptr nc;
   std::deque<WriteOperation> delayed_writes;
+  std::map<std::string, PISM_SHARED_PTR(LocalInterpCtx)> interp_contexts;
 };
 
 static void execute_ops(const PIO &nc, std::deque<WriteOperation> &ops) {
@@ -208,6 +210,20 @@ std::string PIO::backend_type() const {
   return m_impl->backend_type;
 }
 
+PISM_SHARED_PTR(LocalInterpCtx) PIO::get_interp_context(const std::string &key) const {
+  std::map<std::string, PISM_SHARED_PTR(LocalInterpCtx)>::const_iterator j
+    = m_impl->interp_contexts.find(key);
+  if (j != m_impl->interp_contexts.end()) {
+    return j->second;
+  }
+  return PISM_SHARED_PTR(LocalInterpCtx)();
+}
+
+void PIO::set_interp_context(const std::string &key,
+                             PISM_SHARED_PTR(LocalInterpCtx) context) const {
+  m_impl->interp_contexts[key] = context;
+}
+
 void PIO::open(const string &filename, IO_Mode mode) {
   try {
 
@@ -257,6 +273,7 @@ void PIO::open(const string &filename, IO_Mode mode) {
 
 void PIO::close() {
   try {
+    m_impl->interp_contexts.clear();
     execute_ops(*this, m_impl->delayed_writes);
     m_impl->nc->close();
   } catch (RuntimeError &e) {
@@ -24,12 +24,15 @@
 #include <mpi.h>
 
 #include "base/util/PISMUnits.hh"
+#include "base/util/pism_memory.hh"
 #include "base/util/io/IO_Flags.hh"
 
 namespace pism {
 
 enum AxisType {X_AXIS, Y_AXIS, Z_AXIS, T_AXIS, UNKNOWN_AXIS};
 
+class LocalInterpCtx;
+
 //! \brief High-level PISM I/O class.
 /*!
  * Hides the low-level NetCDF wrapper.
@@ -133,6 +136,12 @@ public:
                         unsigned int ys, unsigned int ym) const;
 
   std::string backend_type() const;
+
+  //! Interpolation contexts used to regrid variables from this file
+  //! (see io::regrid_spatial_variable()). They are released by close().
+  PISM_SHARED_PTR(LocalInterpCtx) get_interp_context(const std::string &key) const;
+  void set_interp_context(const std::string &key,
+                          PISM_SHARED_PTR(LocalInterpCtx) context) const;
 private:
   struct Impl;
   Impl *m_impl;
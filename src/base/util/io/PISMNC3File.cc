@@ -33,11 +33,16 @@ namespace io {
 #include "pism_type_conversion.hh" // This has to be included *after* netcdf.h.
 
 NC3File::NC3File(MPI_Comm c)
-  : NCFile(c), m_rank(0) {
+  : NCFile(c), m_rank(0), m_read_file_id(-1) {
   MPI_Comm_rank(m_com, &m_rank);
 }
 
 NC3File::~NC3File() {
+  if (m_read_file_id >= 0 and m_rank != 0) {
+    nc_close(m_read_file_id);
+    m_read_file_id = -1;
+  }
+
   if (m_file_id >= 0) {
     if (m_rank == 0) {
       nc_close(m_file_id);
@@ -58,6 +63,15 @@ int NC3File::integer_open_mode(IO_Mode input) const {
 }
 
 // open/create/close
+
+//! @brief Open a NetCDF file.
+/*!
+ * Processor 0 performs all metadata operations. If the file is opened
+ * for reading, all other processes open it too, so that each one can
+ * read its part of a variable (see get_var_double_local()). If some
+ * process fails to open the file, all of them fall back to reading
+ * through processor 0.
+ */
 int NC3File::open_impl(const std::string &fname, IO_Mode mode) {
   int stat = 0;
 
@@ -70,6 +84,27 @@ int NC3File::open_impl(const std::string &fname, IO_Mode mode) {
   MPI_Bcast(&m_file_id, 1, MPI_INT, 0, m_com);
   MPI_Bcast(&stat, 1, MPI_INT, 0, m_com);
 
+  m_read_file_id = -1;
+
+  int com_size = 1;
+  MPI_Comm_size(m_com, &com_size);
+
+  if (stat == NC_NOERR and mode == PISM_READONLY and com_size > 1) {
+    int local_id = m_file_id, local_stat = NC_NOERR;
+    if (m_rank != 0) {
+      local_stat = nc_open(fname.c_str(), NC_NOWRITE, &local_id);
+    }
+
+    int failed = local_stat != NC_NOERR, any_failed = 0;
+    MPI_Allreduce(&failed, &any_failed, 1, MPI_INT, MPI_MAX, m_com);
+
+    if (any_failed == 0) {
+      m_read_file_id = local_id;
+    } else if (m_rank != 0 and local_stat == NC_NOERR) {
+      nc_close(local_id);
+    }
+  }
+
   return stat;
 }
 
@@ -92,6 +127,11 @@ int NC3File::create_impl(const std::string &fname) {
 int NC3File::close_impl() {
   int stat = 0;
 
+  if (m_read_file_id >= 0 and m_rank != 0) {
+    nc_close(m_read_file_id);
+  }
+  m_read_file_id = -1;
+
   if (m_rank == 0) {
     stat = nc_close(m_file_id);
     m_file_id = -1;
@@ -336,6 +376,10 @@ int NC3File::get_var_double(const std::string &variable_name,
     imap.resize(ndims);
   }
 
+  if (m_read_file_id >= 0) {
+    return get_var_double_local(variable_name, start, count, imap, ip, mapped);
+  }
+
   // get the size of the communicator
   MPI_Comm_size(m_com, &com_size);
 
@@ -416,6 +460,49 @@ int NC3File::get_var_double(const std::string &variable_name,
   return stat;
 }
 
+//! @brief Get variable data, reading the part owned by this process
+//! directly from the file.
+/*!
+ * Used if all processes opened the file for reading (see open_impl()).
+ * All processes return the same status.
+ */
+int NC3File::get_var_double_local(const std::string &variable_name,
+                                  const std::vector<unsigned int> &start,
+                                  const std::vector<unsigned int> &count,
+                                  const std::vector<unsigned int> &imap, double *ip,
+                                  bool mapped) const {
+  const int ndims = static_cast<int>(start.size());
+
+  std::vector<size_t> nc_start(ndims), nc_count(ndims);
+  std::vector<ptrdiff_t> nc_imap(ndims), nc_stride(ndims);
+  for (int k = 0; k < ndims; ++k) {
+    nc_start[k]  = start[k];
+    nc_count[k]  = count[k];
+    nc_imap[k]   = imap[k];
+    nc_stride[k] = 1;
+  }
+
+  int varid = -1;
+  int stat = nc_inq_varid(m_read_file_id, variable_name.c_str(), &varid); check(stat);
+
+  if (stat == NC_NOERR) {
+    if (mapped) {
+      stat = nc_get_varm_double(m_read_file_id, varid, &nc_start[0], &nc_count[0],
+                                &nc_stride[0], &nc_imap[0], ip); check(stat);
+    } else {
+      stat = nc_get_vara_double(m_read_file_id, varid, &nc_start[0], &nc_count[0],
+                                ip); check(stat);
+    }
+  }
+
+  // NetCDF error codes are negative, so this picks an error if any
+  // process failed.
+  int result = NC_NOERR;
+  MPI_Allreduce(&stat, &result, 1, MPI_INT, MPI_MIN, m_com);
+
+  return result;
+}
+
 int NC3File::put_varm_double_impl(const std::string &variable_name,
                                  const std::vector<unsigned int> &start,
                                  const std::vector<unsigned int> &count,
@@ -113,8 +113,16 @@ protected:
   std::string get_format_impl() const;
 private:
   int m_rank;
+  //! ID of the file opened by this process for reading (see open_impl())
+  int m_read_file_id;
   int integer_open_mode(IO_Mode input) const;
 
+  int get_var_double_local(const std::string &variable_name,
+                           const std::vector<unsigned int> &start,
+                           const std::vector<unsigned int> &count,
+                           const std::vector<unsigned int> &imap, double *ip,
+                           bool mapped) const;
+
   int get_var_double(const std::string &variable_name,
                      const std::vector<unsigned int> &start,
                      const std::vector<unsigned int> &count,
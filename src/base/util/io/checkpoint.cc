@@ -0,0 +1,586 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+#include "checkpoint.hh"
+#include "io_helpers.hh"
+#include "PIO.hh"
+#include "base/util/IceGrid.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/VariableMetadata.hh"
+#include "base/util/error_handling.hh"
+#include "base/util/pism_const.hh"
+#include "base/util/pism_options.hh"
+#include "base/util/PISMConfigInterface.hh"
+#include "base/util/petscwrappers/Vec.hh"
+
+namespace pism {
+namespace io {
+
+static const char *checkpoint_format = "PISM-binary-checkpoint-1";
+
+//! Description of a binary checkpoint (contents of the manifest file).
+struct Manifest {
+  //! Part of the domain owned by a rank.
+  struct Patch {
+    int xs, xm, ys, ym;
+  };
+
+  struct Field {
+    std::string name;
+    unsigned int dof;
+    std::vector<std::string> components;
+    std::vector<double> levels;
+
+    //! Number of values stored per grid point.
+    unsigned int block() const {
+      return std::max((size_t)dof, levels.size());
+    }
+  };
+
+  std::string byte_order;
+  double time;
+  unsigned int Mx, My;
+  double Lx, Ly, x0, y0;
+  std::string periodicity;
+  std::vector<double> z;
+  std::vector<Patch> patches;
+  std::vector<Field> fields;
+};
+
+static std::string native_byte_order() {
+  const int one = 1;
+  return *reinterpret_cast<const char*>(&one) == 1 ? "little" : "big";
+}
+
+static std::string manifest_filename(const std::string &prefix) {
+  return prefix + ".manifest";
+}
+
+std::string checkpoint_state_file(const std::string &prefix) {
+  return prefix + "-state.nc";
+}
+
+static std::string rank_filename(const std::string &prefix, int rank) {
+  char buffer[TEMPORARY_STRING_LENGTH];
+  snprintf(buffer, TEMPORARY_STRING_LENGTH, "%s-%05d.bin", prefix.c_str(), rank);
+  return buffer;
+}
+
+static void write_manifest(const std::string &filename, const Manifest &m) {
+  std::ofstream out(filename.c_str());
+  if (not out.good()) {
+    throw RuntimeError::formatted("cannot open '%s' for writing", filename.c_str());
+  }
+
+  out.precision(17);
+
+  out << checkpoint_format << "\n"
+      << "double_size " << sizeof(double) << "\n"
+      << "byte_order " << m.byte_order << "\n"
+      << "time " << m.time << "\n"
+      << "grid " << m.Mx << " " << m.My << " "
+      << m.Lx << " " << m.Ly << " " << m.x0 << " " << m.y0 << " "
+      << m.periodicity << "\n";
+
+  out << "z " << m.z.size();
+  for (unsigned int k = 0; k < m.z.size(); ++k) {
+    out << " " << m.z[k];
+  }
+  out << "\n";
+
+  out << "ranks " << m.patches.size() << "\n";
+  for (unsigned int r = 0; r < m.patches.size(); ++r) {
+    const Manifest::Patch &p = m.patches[r];
+    out << p.xs << " " << p.xm << " " << p.ys << " " << p.ym << "\n";
+  }
+
+  out << "fields " << m.fields.size() << "\n";
+  for (unsigned int n = 0; n < m.fields.size(); ++n) {
+    const Manifest::Field &f = m.fields[n];
+    out << f.name << " " << f.dof;
+    for (unsigned int c = 0; c < f.dof; ++c) {
+      out << " " << f.components[c];
+    }
+    out << " " << f.levels.size();
+    for (unsigned int k = 0; k < f.levels.size(); ++k) {
+      out << " " << f.levels[k];
+    }
+    out << "\n";
+  }
+
+  if (not out.good()) {
+    throw RuntimeError::formatted("failed to write '%s'", filename.c_str());
+  }
+}
+
+static Manifest read_manifest(const std::string &filename) {
+  std::ifstream in(filename.c_str());
+  if (not in.good()) {
+    throw RuntimeError::formatted("cannot open binary checkpoint manifest '%s'",
+                                  filename.c_str());
+  }
+
+  Manifest m;
+  std::string format, keyword;
+  size_t double_size = 0, n = 0;
+
+  in >> format;
+  if (format != checkpoint_format) {
+    throw RuntimeError::formatted("'%s' is not a PISM binary checkpoint manifest",
+                                  filename.c_str());
+  }
+
+  in >> keyword >> double_size;
+  in >> keyword >> m.byte_order;
+  in >> keyword >> m.time;
+  in >> keyword >> m.Mx >> m.My >> m.Lx >> m.Ly >> m.x0 >> m.y0 >> m.periodicity;
+
+  in >> keyword >> n;
+  m.z.resize(n);
+  for (unsigned int k = 0; k < n; ++k) {
+    in >> m.z[k];
+  }
+
+  in >> keyword >> n;
+  m.patches.resize(n);
+  for (unsigned int r = 0; r < n; ++r) {
+    Manifest::Patch &p = m.patches[r];
+    in >> p.xs >> p.xm >> p.ys >> p.ym;
+  }
+
+  in >> keyword >> n;
+  m.fields.resize(n);
+  for (unsigned int k = 0; k < n; ++k) {
+    Manifest::Field &f = m.fields[k];
+    size_t n_levels = 0;
+
+    in >> f.name >> f.dof;
+    f.components.resize(f.dof);
+    for (unsigned int c = 0; c < f.dof; ++c) {
+      in >> f.components[c];
+    }
+
+    in >> n_levels;
+    f.levels.resize(n_levels);
+    for (unsigned int l = 0; l < n_levels; ++l) {
+      in >> f.levels[l];
+    }
+  }
+
+  if (in.fail()) {
+    throw RuntimeError::formatted("failed to parse binary checkpoint manifest '%s'",
+                                  filename.c_str());
+  }
+
+  if (double_size != sizeof(double) or m.byte_order != native_byte_order()) {
+    throw RuntimeError::formatted("binary checkpoint '%s' was written on an incompatible platform",
+                                  filename.c_str());
+  }
+
+  return m;
+}
+
+void write_checkpoint(const std::string &prefix, const IceGrid &grid, double time,
+                      const std::vector<const IceModelVec*> &fields) {
+  const Config &config = *grid.ctx()->config();
+
+  // collect the domain decomposition
+  std::vector<int> patches(4 * grid.size());
+  {
+    int patch[4] = {grid.xs(), grid.xm(), grid.ys(), grid.ym()};
+    int err = MPI_Gather(patch, 4, MPI_INT, &patches[0], 4, MPI_INT, 0, grid.com);
+    PISM_C_CHK(err, 0, "MPI_Gather");
+  }
+
+  // add definitions of fields stored in binary files to the state file
+  {
+    PIO nc(grid.com, "netcdf3");
+    const std::string order = config.get_string("output_variable_order");
+
+    nc.open(checkpoint_state_file(prefix), PISM_READWRITE);
+
+    for (unsigned int k = 0; k < fields.size(); ++k) {
+      for (unsigned int c = 0; c < fields[k]->get_ndof(); ++c) {
+        io::define_spatial_variable(fields[k]->metadata(c), grid, nc, PISM_DOUBLE,
+                                    order, false);
+      }
+    }
+    nc.close();
+  }
+
+  // write values owned by this rank
+  ParallelSection loop(grid.com);
+  try {
+    const std::string filename = rank_filename(prefix, grid.rank());
+
+    FILE *output = fopen(filename.c_str(), "wb");
+    if (output == NULL) {
+      throw RuntimeError::formatted("cannot open '%s' for writing", filename.c_str());
+    }
+
+    for (unsigned int k = 0; k < fields.size(); ++k) {
+      const IceModelVec &v = *fields[k];
+      const size_t N = std::max((size_t)v.get_ndof(), v.get_levels().size()) * grid.xm() * grid.ym();
+
+      petsc::TemporaryGlobalVec tmp(v.get_dm());
+      v.copy_to_vec(v.get_dm(), tmp);
+      petsc::VecArray tmp_array(tmp);
+
+      if (fwrite(tmp_array.get(), sizeof(double), N, output) != N) {
+        fclose(output);
+        throw RuntimeError::formatted("failed to write '%s' to '%s'",
+                                      v.get_name().c_str(), filename.c_str());
+      }
+    }
+
+    if (fclose(output) != 0) {
+      throw RuntimeError::formatted("failed to write '%s'", filename.c_str());
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  // write the manifest last, so that an incomplete checkpoint cannot be used
+  ParallelSection rank0(grid.com);
+  try {
+    if (grid.rank() == 0) {
+      Manifest m;
+      m.byte_order  = native_byte_order();
+      m.time        = time;
+      m.Mx          = grid.Mx();
+      m.My          = grid.My();
+      m.Lx          = grid.Lx();
+      m.Ly          = grid.Ly();
+      m.x0          = grid.x0();
+      m.y0          = grid.y0();
+      m.periodicity = periodicity_to_string(grid.periodicity());
+      m.z           = grid.z();
+
+      m.patches.resize(grid.size());
+      for (unsigned int r = 0; r < grid.size(); ++r) {
+        Manifest::Patch &p = m.patches[r];
+        p.xs = patches[4 * r + 0];
+        p.xm = patches[4 * r + 1];
+        p.ys = patches[4 * r + 2];
+        p.ym = patches[4 * r + 3];
+      }
+
+      m.fields.resize(fields.size());
+      for (unsigned int k = 0; k < fields.size(); ++k) {
+        Manifest::Field &f = m.fields[k];
+        f.name   = fields[k]->get_name();
+        f.dof    = fields[k]->get_ndof();
+        f.levels = fields[k]->get_levels();
+        for (unsigned int c = 0; c < f.dof; ++c) {
+          f.components.push_back(fields[k]->metadata(c).get_name());
+        }
+      }
+
+      write_manifest(manifest_filename(prefix), m);
+    }
+  } catch (...) {
+    rank0.failed();
+  }
+  rank0.check();
+}
+
+//! @brief Read values of the field `field_index` in the part of the domain owned
+//! by this rank into `output`, which uses the layout of a global Vec.
+static void read_patch(const std::string &prefix, const Manifest &m,
+                       const IceGrid &grid, unsigned int field_index,
+                       double *output) {
+  const int
+    xs = grid.xs(),
+    xm = grid.xm(),
+    ys = grid.ys(),
+    ym = grid.ym();
+
+  const size_t block = m.fields[field_index].block();
+
+  const bool same_decomposition = (m.patches.size() == grid.size() and
+                                   m.patches[grid.rank()].xs == xs and
+                                   m.patches[grid.rank()].xm == xm and
+                                   m.patches[grid.rank()].ys == ys and
+                                   m.patches[grid.rank()].ym == ym);
+
+  for (unsigned int r = 0; r < m.patches.size(); ++r) {
+    if (same_decomposition and (int)r != grid.rank()) {
+      continue;
+    }
+
+    const Manifest::Patch &p = m.patches[r];
+
+    // the intersection of the patch written by rank r and the patch owned by this rank
+    const int
+      i0 = std::max(xs, p.xs),
+      i1 = std::min(xs + xm, p.xs + p.xm),
+      j0 = std::max(ys, p.ys),
+      j1 = std::min(ys + ym, p.ys + p.ym);
+
+    if (i0 >= i1 or j0 >= j1) {
+      continue;
+    }
+
+    // offset of this field in the file written by rank r
+    long int offset = 0;
+    for (unsigned int k = 0; k < field_index; ++k) {
+      offset += m.fields[k].block() * p.xm * p.ym * sizeof(double);
+    }
+
+    const std::string filename = rank_filename(prefix, r);
+    FILE *input = fopen(filename.c_str(), "rb");
+    if (input == NULL) {
+      throw RuntimeError::formatted("cannot open '%s'", filename.c_str());
+    }
+
+    bool success = true;
+    if (same_decomposition) {
+      // read the whole patch at once
+      const size_t N = block * xm * ym;
+      success = (fseek(input, offset, SEEK_SET) == 0 and
+                 fread(output, sizeof(double), N, input) == N);
+    } else {
+      // the y index varies fastest (see the comment in IceGrid::get_dm())
+      const size_t N = block * (j1 - j0);
+      for (int i = i0; success and i < i1; ++i) {
+        const long int source = offset + block * ((i - p.xs) * p.ym + (j0 - p.ys)) * sizeof(double);
+        double *destination = output + block * ((i - xs) * ym + (j0 - ys));
+
+        success = (fseek(input, source, SEEK_SET) == 0 and
+                   fread(destination, sizeof(double), N, input) == N);
+      }
+    }
+
+    fclose(input);
+
+    if (not success) {
+      throw RuntimeError::formatted("failed to read '%s' from '%s'",
+                                    m.fields[field_index].name.c_str(), filename.c_str());
+    }
+  }
+}
+
+static unsigned int find_field(const Manifest &m, const std::string &name,
+                               const std::string &prefix) {
+  for (unsigned int k = 0; k < m.fields.size(); ++k) {
+    if (m.fields[k].name == name) {
+      return k;
+    }
+  }
+  throw RuntimeError::formatted("binary checkpoint '%s' does not contain '%s'",
+                                prefix.c_str(), name.c_str());
+}
+
+//! Returns true if `a` and `b` are equal up to round-off in the manifest.
+static bool same_value(double a, double b) {
+  return fabs(a - b) <= 1e-12 * std::max(1.0, std::max(fabs(a), fabs(b)));
+}
+
+static bool same_levels(const std::vector<double> &a, const std::vector<double> &b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (unsigned int k = 0; k < a.size(); ++k) {
+    if (not same_value(a[k], b[k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//! Stop if the grid used to write a checkpoint differs from `grid`.
+static void check_grid(const std::string &prefix, const Manifest &m, const IceGrid &grid) {
+  if (m.Mx != grid.Mx() or m.My != grid.My()) {
+    throw RuntimeError::formatted("binary checkpoint '%s' uses a %dx%d grid; the current grid is %dx%d",
+                                  prefix.c_str(), m.Mx, m.My, grid.Mx(), grid.My());
+  }
+
+  if (not (same_value(m.Lx, grid.Lx()) and same_value(m.Ly, grid.Ly()) and
+           same_value(m.x0, grid.x0()) and same_value(m.y0, grid.y0()))) {
+    throw RuntimeError::formatted("the domain of binary checkpoint '%s'"
+                                  " (Lx = %f, Ly = %f, x0 = %f, y0 = %f)"
+                                  " does not match the current grid"
+                                  " (Lx = %f, Ly = %f, x0 = %f, y0 = %f)",
+                                  prefix.c_str(), m.Lx, m.Ly, m.x0, m.y0,
+                                  grid.Lx(), grid.Ly(), grid.x0(), grid.y0());
+  }
+
+  if (m.periodicity != periodicity_to_string(grid.periodicity())) {
+    throw RuntimeError::formatted("binary checkpoint '%s' uses periodicity '%s';"
+                                  " the current grid uses '%s'",
+                                  prefix.c_str(), m.periodicity.c_str(),
+                                  periodicity_to_string(grid.periodicity()).c_str());
+  }
+
+  if (not same_levels(m.z, grid.z())) {
+    throw RuntimeError::formatted("vertical levels in binary checkpoint '%s'"
+                                  " do not match the current grid",
+                                  prefix.c_str());
+  }
+}
+
+double read_checkpoint(const std::string &prefix, const IceGrid &grid,
+                       const std::vector<IceModelVec*> &fields) {
+  Manifest m = read_manifest(manifest_filename(prefix));
+
+  check_grid(prefix, m, grid);
+
+  ParallelSection loop(grid.com);
+  try {
+    for (unsigned int k = 0; k < fields.size(); ++k) {
+      IceModelVec &v = *fields[k];
+
+      const unsigned int n = find_field(m, v.get_name(), prefix);
+
+      if (m.fields[n].dof != v.get_ndof() or
+          not same_levels(m.fields[n].levels, v.get_levels())) {
+        throw RuntimeError::formatted("the levels or components of '%s'"
+                                      " in binary checkpoint '%s' do not match",
+                                      v.get_name().c_str(), prefix.c_str());
+      }
+
+      if (v.get_stencil_width() == 0) {
+        // no ghosts: read directly into the storage of v
+        {
+          petsc::VecArray v_array(v.get_vec());
+          read_patch(prefix, m, grid, n, v_array.get());
+        }
+        v.inc_state_counter();
+      } else {
+        petsc::TemporaryGlobalVec tmp(v.get_dm());
+        {
+          petsc::VecArray tmp_array(tmp);
+          read_patch(prefix, m, grid, n, tmp_array.get());
+        }
+        v.copy_from_vec(tmp);
+      }
+    }
+  } catch (...) {
+    loop.failed();
+  }
+  loop.check();
+
+  return m.time;
+}
+
+void checkpoint_to_netcdf(Context::Ptr ctx, const std::string &prefix,
+                          const std::string &filename) {
+  Manifest m = read_manifest(manifest_filename(prefix));
+
+  GridParameters P(ctx->config());
+  P.Mx          = m.Mx;
+  P.My          = m.My;
+  P.Lx          = m.Lx;
+  P.Ly          = m.Ly;
+  P.x0          = m.x0;
+  P.y0          = m.y0;
+  P.periodicity = string_to_periodicity(m.periodicity);
+  P.z           = m.z;
+  P.ownership_ranges_from_options(ctx->size());
+
+  IceGrid grid(ctx, P);
+
+  // Start with a copy of the state file: it contains configuration
+  // parameters, the time record, sub-model state and definitions of
+  // fields stored in binary files.
+  ParallelSection rank0(grid.com);
+  try {
+    if (grid.rank() == 0) {
+      std::ifstream in(checkpoint_state_file(prefix).c_str(), std::ios::binary);
+      std::ofstream out(filename.c_str(), std::ios::binary);
+      out << in.rdbuf();
+      if (not in.good() or not out.good()) {
+        throw RuntimeError::formatted("failed to copy '%s' to '%s'",
+                                      checkpoint_state_file(prefix).c_str(), filename.c_str());
+      }
+    }
+  } catch (...) {
+    rank0.failed();
+  }
+  rank0.check();
+
+  PIO nc(grid.com, "netcdf3");
+  nc.open(filename, PISM_READWRITE);
+
+  const size_t n_points = grid.xm() * grid.ym();
+
+  for (unsigned int k = 0; k < m.fields.size(); ++k) {
+    const Manifest::Field &f = m.fields[k];
+
+    std::vector<double> values(f.block() * n_points), component(n_points);
+
+    ParallelSection loop(grid.com);
+    try {
+      read_patch(prefix, m, grid, k, &values[0]);
+    } catch (...) {
+      loop.failed();
+    }
+    loop.check();
+
+    for (unsigned int c = 0; c < f.dof; ++c) {
+      SpatialVariableMetadata var(ctx->unit_system(), f.components[c], f.levels);
+      io::read_attributes(nc, f.components[c], var);
+
+      const double *data = &values[0];
+      if (f.dof > 1) {
+        for (unsigned int p = 0; p < n_points; ++p) {
+          component[p] = values[p * f.dof + c];
+        }
+        data = &component[0];
+      }
+
+      io::write_spatial_variable(var, grid, nc, false, data);
+    }
+  }
+
+  nc.close();
+}
+
+void checkpoint_input_from_options() {
+  options::String prefix("-checkpoint",
+                         "Specifies the prefix of a binary checkpoint to restart from");
+  if (not prefix.is_set()) {
+    return;
+  }
+
+  if (options::Bool("-i", "input file name") or
+      options::Bool("-bootstrap", "enable bootstrapping heuristics")) {
+    throw RuntimeError("-checkpoint replaces -i; options -i and -bootstrap cannot be used with it");
+  }
+
+  // stop early if the checkpoint is incomplete
+  read_manifest(manifest_filename(prefix));
+
+#if PETSC_VERSION_LT(3,7,0)
+  PetscErrorCode ierr = PetscOptionsSetValue("-i", checkpoint_state_file(prefix).c_str());
+  PISM_CHK(ierr, "PetscOptionsSetValue");
+#else
+  PetscErrorCode ierr = PetscOptionsSetValue(NULL, "-i", checkpoint_state_file(prefix).c_str());
+  PISM_CHK(ierr, "PetscOptionsSetValue");
+#endif
+}
+
+} // end of namespace io
+} // end of namespace pism
@@ -0,0 +1,90 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _PISM_CHECKPOINT_H_
+#define _PISM_CHECKPOINT_H_
+
+#include <string>
+#include <vector>
+
+#include "base/util/Context.hh"
+
+namespace pism {
+
+class IceGrid;
+class IceModelVec;
+
+namespace io {
+
+//! @brief Write `fields` to a binary checkpoint with the prefix `prefix`.
+/*!
+ * A checkpoint consists of
+ *
+ * - `prefix.manifest`: a text file describing the grid, the domain
+ *   decomposition, the model time and the list of fields,
+ * - `prefix-state.nc`: a NetCDF file containing configuration
+ *   parameters, the time record, the state of sub-models and
+ *   definitions (attributes) of fields stored in binary files,
+ * - `prefix-NNNNN.bin`: one file per MPI rank containing values of
+ *   all fields owned by this rank, stored one field after another,
+ *   in the native byte order and in the order used by PISM's DMDAs.
+ *
+ * The caller has to write `prefix-state.nc` (see
+ * checkpoint_state_file()) first; this function adds definitions of
+ * `fields` to it.
+ *
+ * Each rank writes its own file, so writing is limited by the disk
+ * bandwidth.
+ */
+void write_checkpoint(const std::string &prefix, const IceGrid &grid, double time,
+                      const std::vector<const IceModelVec*> &fields);
+
+//! @brief Read `fields` from a binary checkpoint. Returns the model time stored in it.
+/*!
+ * If the domain decomposition matches the one used to write the
+ * checkpoint, each rank reads its own file (directly into the
+ * storage of fields without ghosts). Otherwise each rank reads the
+ * parts it owns from all the overlapping files.
+ *
+ * The grid (size, extent, periodicity and vertical levels) and the
+ * levels of each field have to match; this function stops with an
+ * error otherwise.
+ */
+double read_checkpoint(const std::string &prefix, const IceGrid &grid,
+                       const std::vector<IceModelVec*> &fields);
+
+//! Name of the NetCDF file holding the part of a checkpoint that is not stored in binary files.
+std::string checkpoint_state_file(const std::string &prefix);
+
+//! @brief Process `-checkpoint`: use the state file of a binary
+//! checkpoint as the input file (`-i`).
+/*!
+ * This makes the grid, the model time and all sub-models initialize
+ * from the checkpoint. Has to be called before the Context is created.
+ */
+void checkpoint_input_from_options();
+
+//! Convert a binary checkpoint to a NetCDF file.
+void checkpoint_to_netcdf(Context::Ptr ctx, const std::string &prefix,
+                          const std::string &filename);
+
+} // end of namespace io
+} // end of namespace pism
+
+#endif /* _PISM_CHECKPOINT_H_ */
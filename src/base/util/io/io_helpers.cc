@@ -17,7 +17,7 @@
  * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-#include <gsl/gsl_interp.h>
+#include <sstream>
 
 #include "io_helpers.hh"
 #include "PIO.hh"
@@ -47,8 +47,10 @@ namespace io {
  * The `output_array` is expected to be big enough to contain
  * `grid.xm()*`grid.ym()*length(zlevels_out)` numbers.
  *
- * We should be able to switch to using an external interpolation library
- * fairly easily...
+ * Interpolation is separable, so for each map-plane point we first combine the four
+ * neighboring input columns (a contiguous, vectorizable loop over input levels) and then
+ * interpolate the result in the vertical direction using indices and weights cached in
+ * `lic`.
  */
 static void regrid(const IceGrid& grid, const std::vector<double> &zlevels_out,
                    LocalInterpCtx *lic, double *output_array) {
@@ -57,101 +59,61 @@ static void regrid(const IceGrid& grid, const std::vector<double> &zlevels_out,
 
   const int Y = 2, Z = 3; // indices, just for clarity
 
-  std::vector<double> &zlevels_in = lic->zlevels;
-  unsigned int nlevels = zlevels_out.size();
-  double *input_array = &(lic->buffer[0]);
-
-  std::vector<unsigned int> kbelow(nlevels, 0);
-
-  if (nlevels > 1) {
-    gsl_interp_accel *accel = gsl_interp_accel_alloc();
-    if (accel == NULL) {
-      throw RuntimeError("Failed to allocate a GSL interpolation accelerator");
-    }
-    for (unsigned int k = 0; k < nlevels; ++k) {
-      kbelow[k] = gsl_interp_accel_find(accel, &zlevels_in[0], zlevels_in.size(), zlevels_out[k]);
-    }
-    gsl_interp_accel_free(accel);
-  }
+  const unsigned int nlevels = zlevels_out.size();
+  const double *input_array = &(lic->buffer[0]);
 
   // array sizes for mapping from logical to "flat" indices
-  int
+  const int
     y_count = lic->count[Y],
     z_count = lic->count[Z];
 
-  // NOTE: make sure that the traversal order is correct!
-  for (Points p(grid); p; p.next()) {
-    const int i = p.i(), j = p.j();
+  const int *z_below = &lic->z_below[0], *z_above = &lic->z_above[0];
+  const double *z_alpha = &lic->z_alpha[0];
+
+  // input column interpolated to the current map-plane location
+  std::vector<double> column_storage(z_count);
+  double *column = &column_storage[0];
 
-    const int i0 = i - grid.xs(), j0 = j - grid.ys();
+  const int xm = grid.xm(), ym = grid.ym();
 
-    for (unsigned int k = 0; k < nlevels; k++) {
-      // Indices of neighboring points.
+  // NOTE: make sure that the traversal order is correct!
+  for (int i0 = 0; i0 < xm; ++i0) {
+    const int
+      Im = lic->x_left[i0],
+      Ip = lic->x_right[i0];
+    // interpolation coefficient in the x direction
+    const double ii = lic->x_alpha[i0];
+
+    for (int j0 = 0; j0 < ym; ++j0) {
       const int
-        Im = lic->x_left[i0],
-        Ip = lic->x_right[i0],
         Jm = lic->y_left[j0],
         Jp = lic->y_right[j0];
-
-      double a_mm, a_mp, a_pm, a_pp;  // filled differently in 2d and 3d cases
-
-      if (nlevels > 1) {
-        // get the index into the source grid, for just below the level z
-        const int kc = kbelow[k];
-
-        // We pretend that there are always 8 neighbors (4 in the map plane,
-        // 2 vertical levels). And compute the indices into the input_array for
-        // those neighbors.
-        const int mmm = (Im * y_count + Jm) * z_count + kc;
-        const int mmp = (Im * y_count + Jm) * z_count + kc + 1;
-        const int mpm = (Im * y_count + Jp) * z_count + kc;
-        const int mpp = (Im * y_count + Jp) * z_count + kc + 1;
-        const int pmm = (Ip * y_count + Jm) * z_count + kc;
-        const int pmp = (Ip * y_count + Jm) * z_count + kc + 1;
-        const int ppm = (Ip * y_count + Jp) * z_count + kc;
-        const int ppp = (Ip * y_count + Jp) * z_count + kc + 1;
-
-        // We know how to index the neighbors, but we don't yet know where the
-        // point lies within this box.  This is represented by kk in [0,1].
-        const double zkc = zlevels_in[kc];
-        double dz;
-        if (kc == z_count - 1) {
-          dz = zlevels_in[kc] - zlevels_in[kc-1];
-        } else {
-          dz = zlevels_in[kc+1] - zlevels_in[kc];
-        }
-        // location (x,y,z) is in target computational domain
-        const double z = zlevels_out[k];
-        const double kk = (z - zkc) / dz;
-
-        // linear interpolation in the z-direction
-        a_mm = input_array[mmm] * (1.0 - kk) + input_array[mmp] * kk;
-        a_mp = input_array[mpm] * (1.0 - kk) + input_array[mpp] * kk;
-        a_pm = input_array[pmm] * (1.0 - kk) + input_array[pmp] * kk;
-        a_pp = input_array[ppm] * (1.0 - kk) + input_array[ppp] * kk;
-      } else {
-        // we don't need to interpolate vertically for the 2-D case
-        a_mm = input_array[Im * y_count + Jm];
-        a_mp = input_array[Im * y_count + Jp];
-        a_pm = input_array[Ip * y_count + Jm];
-        a_pp = input_array[Ip * y_count + Jp];
-      }
-
       // interpolation coefficient in the y direction
       const double jj = lic->y_alpha[j0];
 
-      // interpolate in y direction
-      const double a_m = a_mm * (1.0 - jj) + a_mp * jj;
-      const double a_p = a_pm * (1.0 - jj) + a_pp * jj;
-
-      // interpolation coefficient in the x direction
-      const double ii = lic->x_alpha[i0];
+      // columns of the four neighbors and their weights
+      const double
+        *a_mm = input_array + (Im * y_count + Jm) * z_count,
+        *a_mp = input_array + (Im * y_count + Jp) * z_count,
+        *a_pm = input_array + (Ip * y_count + Jm) * z_count,
+        *a_pp = input_array + (Ip * y_count + Jp) * z_count;
+      const double
+        w_mm = (1.0 - ii) * (1.0 - jj),
+        w_mp = (1.0 - ii) * jj,
+        w_pm = ii * (1.0 - jj),
+        w_pp = ii * jj;
+
+      for (int k = 0; k < z_count; ++k) {
+        column[k] = w_mm * a_mm[k] + w_mp * a_mp[k] + w_pm * a_pm[k] + w_pp * a_pp[k];
+      }
 
-      int index = (i0 * grid.ym() + j0) * nlevels + k;
+      double *result = output_array + (i0 * ym + j0) * nlevels;
 
-      // index into the new array and interpolate in x direction
-      output_array[index] = a_m * (1.0 - ii) + a_p * ii;
-      // done with the point at (x,y,z)
+      // linear interpolation in the z-direction
+      for (unsigned int k = 0; k < nlevels; ++k) {
+        const double kk = z_alpha[k];
+        result[k] = column[z_below[k]] * (1.0 - kk) + column[z_above[k]] * kk;
+      }
     }
   }
 }
@@ -414,15 +376,46 @@ static void put_vec(const PIO &nc, const IceGrid &grid, const std::string &var_n
 
 //! @brief Get the interpolation context (grid information) for an input file.
 /*!
- * @note The *caller* is in charge of destroying lic
+ * Contexts are stored in `file` until it is closed, so regridding many
+ * fields from the same file computes interpolation indices and weights
+ * (and allocates the input buffer) once per input grid. Variables that
+ * share dimensions in a file share the input grid, so the key uses
+ * dimension names and the target grid; grid_info is read only if the
+ * context has to be built.
  */
-static LocalInterpCtx* get_interp_context(const PIO& file,
-                                          const std::string &variable_name,
-                                          const IceGrid &grid,
-                                          const std::vector<double> &zlevels) {
-  grid_info gi(file, variable_name, grid.ctx()->unit_system(), grid.periodicity());
+static PISM_SHARED_PTR(LocalInterpCtx) get_interp_context(const PIO& file,
+                                                          const std::string &variable_name,
+                                                          const IceGrid &grid,
+                                                          const std::vector<double> &zlevels) {
+  std::ostringstream key;
+  key.precision(17);
+
+  const std::vector<std::string> dims = file.inq_vardims(variable_name);
+  for (unsigned int k = 0; k < dims.size(); ++k) {
+    key << dims[k] << " ";
+  }
+
+  key << "| " << grid.Mx() << " " << grid.My() << " "
+      << grid.x0() << " " << grid.y0() << " " << grid.Lx() << " " << grid.Ly() << " "
+      << grid.xs() << " " << grid.xm() << " " << grid.ys() << " " << grid.ym() << " |";
+  for (unsigned int k = 0; k < zlevels.size(); ++k) {
+    key << " " << zlevels[k];
+  }
+
+  PISM_SHARED_PTR(LocalInterpCtx) result = file.get_interp_context(key.str());
+
+  // All ranks have to agree: the constructor of LocalInterpCtx is collective.
+  int reuse = (bool)result ? 1 : 0;
+  reuse = (int)GlobalMin(grid.com, reuse);
+
+  if (not reuse) {
+    grid_info gi(file, variable_name, grid.ctx()->unit_system(), grid.periodicity());
+
+    result.reset(new LocalInterpCtx(gi, grid, zlevels));
+    file.set_interp_context(key.str(), result);
+  }
 
-  return new LocalInterpCtx(gi, grid, zlevels.front(), zlevels.back());
+  return result;
 }
 
 //! \brief Read a PETSc Vec from a file, using bilinear (or trilinear)
@@ -434,7 +427,7 @@ static void regrid_vec(const PIO &nc, const IceGrid &grid, const std::string &va
     const int X = 1, Y = 2, Z = 3; // indices, just for clarity
     std::vector<unsigned int> start, count, imap;
 
-    PISM_SHARED_PTR(LocalInterpCtx) lic(get_interp_context(nc, var_name, grid, zlevels_out));
+    PISM_SHARED_PTR(LocalInterpCtx) lic = get_interp_context(nc, var_name, grid, zlevels_out);
     assert((bool)lic);
 
     double *buffer = &(lic->buffer[0]);
@@ -484,7 +477,7 @@ static void regrid_vec_fill_missing(const PIO &nc, const IceGrid &grid,
     const int X = 1, Y = 2, Z = 3; // indices, just for clarity
     std::vector<unsigned int> start, count, imap;
 
-    PISM_SHARED_PTR(LocalInterpCtx) lic(get_interp_context(nc, var_name, grid, zlevels_out));
+    PISM_SHARED_PTR(LocalInterpCtx) lic = get_interp_context(nc, var_name, grid, zlevels_out);
     assert((bool)lic);
 
     double *buffer = &(lic->buffer[0]);
@@ -26,6 +26,23 @@
 namespace pism {
 namespace options {
 
+//! True if option queries should be reported; see report_option_queries().
+static bool report_queries = false;
+
+//! Report (in debugging builds) options processed while `flag` is true.
+/*!
+ * Processing an option involves parsing the PETSc options database, so
+ * code that runs every time step should not do it. Run-time options
+ * should be processed once (usually by storing their values in the
+ * configuration database) during the initialization.
+ *
+ * IceModel::run() sets this flag during time-stepping to catch code
+ * that does not follow this rule.
+ */
+void report_option_queries(bool flag) {
+  report_queries = flag;
+}
+
 String::String(const std::string& option,
                const std::string& description) {
   int errcode = process(option, description, "", DONT_ALLOW_EMPTY);
@@ -49,6 +66,15 @@ int String::process(const std::string& option,
                     const std::string& default_value,
                     ArgumentFlag argument_flag) {
 
+#if (PISM_DEBUG==1)
+  if (report_queries) {
+    PetscErrorCode ierr = PetscPrintf(PETSC_COMM_WORLD,
+                                      "PISM WARNING: option %s is processed during time-stepping.\n",
+                                      option.c_str());
+    PISM_CHK(ierr, "PetscPrintf");
+  }
+#endif
+
   char tmp[TEMPORARY_STRING_LENGTH];
   PetscBool flag = PETSC_FALSE;
 
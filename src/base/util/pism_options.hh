@@ -119,6 +119,8 @@ public:
 bool Bool(const std::string& option,
           const std::string& description);
 
+void report_option_queries(bool flag);
+
 void deprecated(const std::string &old_name, const std::string &new_name);
 void ignored(const Logger &log, const std::string &name);
 void forbidden(const std::string &name);
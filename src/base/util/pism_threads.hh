@@ -0,0 +1,182 @@
+/* Copyright (C) 2015 PISM Authors
+ *
+ * This file is part of PISM.
+ *
+ * PISM is free software; you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PISM; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef _PISM_THREADS_H_
+#define _PISM_THREADS_H_
+
+/** @file pism_threads.hh Threading within the sub-domain owned by an MPI rank.
+ *
+ * PISM uses OpenMP if it is built with `-DPism_USE_OPENMP=ON`.
+ * Otherwise all macros below expand to nothing and all loops are run
+ * by one thread.
+ *
+ * A threaded loop looks like this:
+ *
+ *     IceModelVec::AccessList list(...); // outside of the parallel region
+ *
+ *     ParallelSection loop(grid->com);
+ *     PISM_OMP_PARALLEL
+ *     {
+ *       try {
+ *         for (ThreadPoints p(*grid); p; p.next()) {
+ *           const int i = p.i(), j = p.j();
+ *           ...
+ *         }
+ *       } catch (...) {
+ *         loop.failed();
+ *       }
+ *     }
+ *     loop.check();             // outside of the parallel region
+ *
+ * Notes:
+ *
+ * - begin_access() and end_access() are not thread-safe, so all
+ *   fields have to be added to an AccessList *before* entering a
+ *   parallel region.
+ * - An exception must not leave a parallel region: catch it in each
+ *   thread and call ParallelSection::failed() (which is thread-safe).
+ * - Temporary storage (columns, etc) has to be thread-private, i.e.
+ *   allocated *inside* the parallel region.
+ * - Reductions are done by computing a thread-local result and
+ *   combining results of all threads in a PISM_OMP_CRITICAL block.
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/util/IceGrid.hh"
+
+#ifdef _OPENMP
+#include <omp.h>
+#define PISM_OMP_PARALLEL _Pragma("omp parallel")
+#define PISM_OMP_CRITICAL _Pragma("omp critical (pism_critical)")
+#else
+#define PISM_OMP_PARALLEL
+#define PISM_OMP_CRITICAL
+#endif
+
+namespace pism {
+namespace threads {
+
+//! Number of threads in the current team (1 outside of a parallel region).
+inline int count() {
+#ifdef _OPENMP
+  return omp_get_num_threads();
+#else
+  return 1;
+#endif
+}
+
+//! Index of the calling thread in the current team (0 outside of a parallel region).
+inline int index() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+//! Maximum number of threads a parallel region may use.
+inline int max_count() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+//! @brief Start of the block `k` when `size` items are split into
+//! `count()` contiguous blocks of (almost) equal size.
+inline int block_start(int size, int k) {
+  const int N = count();
+  return k * (size / N) + std::min(k, size % N);
+}
+
+//! @brief Splits `[first, first + size)` into `count()` contiguous blocks and
+//! returns the one of the calling thread.
+inline void partition(int first, int size, int &my_first, int &my_size) {
+  const int k = index();
+
+  my_first = first + block_start(size, k);
+  my_size  = block_start(size, k + 1) - block_start(size, k);
+}
+
+} // end of namespace threads
+
+/** Iterator class for traversing the part of the grid owned by the
+ * calling thread (optionally including ghost points).
+ *
+ * Rows (`i` indexes) of the sub-domain are split into contiguous
+ * blocks, one per thread, so each thread works on a tile spanning all
+ * `j` indexes of the sub-domain. Outside of a parallel region this is
+ * equivalent to PointsWithGhosts.
+ *
+ * Usage:
+ *
+ * `for (ThreadPoints p(grid, stencil_width); p; p.next()) { ... }`
+ */
+class ThreadPoints {
+public:
+  ThreadPoints(const IceGrid &g, unsigned int stencil_width = 0) {
+    int i_first = 0, i_size = 0;
+    threads::partition(g.xs() - (int)stencil_width, g.xm() + 2 * stencil_width,
+                       i_first, i_size);
+
+    m_i_first = i_first;
+    m_i_last  = i_first + i_size - 1;
+    m_j_first = g.ys() - stencil_width;
+    m_j_last  = g.ys() + g.ym() + stencil_width - 1;
+
+    m_i = m_i_first;
+    m_j = m_j_first;
+    m_done = (i_size == 0);
+  }
+
+  int i() const {
+    return m_i;
+  }
+  int j() const {
+    return m_j;
+  }
+
+  void next() {
+    assert(m_done == false);
+    m_j += 1;
+    if (m_j > m_j_last) {
+      m_j = m_j_first;        // wrap around
+      m_i += 1;
+    }
+    if (m_i > m_i_last) {
+      m_i = m_i_first;        // ensure that indexes are valid
+      m_done = true;
+    }
+  }
+
+  operator bool() const {
+    return m_done == false;
+  }
+private:
+  int m_i, m_j;
+  int m_i_first, m_i_last, m_j_first, m_j_last;
+  bool m_done;
+};
+
+} // end of namespace pism
+
+#endif /* _PISM_THREADS_H_ */
@@ -152,4 +152,73 @@ double varcEnthalpyConverter::enthalpy_impl(double T, double omega, double p) co
 }
 
 
+void varcEnthalpyConverter::enthalpy_cts_n_impl(const double *P, double *E_s,
+                                                unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    E_s[k] = EfromT(m_T_melting - m_beta * P[k]);
+  }
+}
+
+//! Column-batched version of temperature_impl().
+/*!
+  Computes both the cold-ice temperature (see TfromE()) and the
+  pressure-melting temperature at every level and selects one, which
+  keeps the loop free of branches.
+ */
+void varcEnthalpyConverter::temperature_n_impl(const double *E, const double *P, double *T,
+                                               unsigned int n) const {
+#if (PISM_DEBUG==1)
+  check_not_liquid_n(E, P, n);
+#endif
+
+  double E_min = 0.0;
+  for (unsigned int k = 0; k < n; ++k) {
+    E_min = std::min(E_min, E[k]);
+  }
+  if (E_min < 0.0) {
+    throw RuntimeError("E < 0 in varcEnthalpyConverter is not allowed.");
+  }
+
+  const double
+    ALPHA = 2.0 / m_c_gradient,
+    BETA  = ALPHA * m_c_i + 2.0 * (m_T_0 - m_T_r);
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double
+      T_m  = m_T_melting - m_beta * P[k],
+      tmp  = 2.0 * ALPHA * E[k],
+      dT   = tmp / (sqrt(BETA*BETA + 2.0*tmp) + BETA);
+    T[k] = E[k] < EfromT(T_m) ? m_T_0 + dT : T_m;
+  }
+}
+
+void varcEnthalpyConverter::water_fraction_n_impl(const double *E, const double *P,
+                                                  double *omega, unsigned int n) const {
+#if (PISM_DEBUG==1)
+  check_not_liquid_n(E, P, n);
+#endif
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double E_s = EfromT(m_T_melting - m_beta * P[k]);
+    omega[k] = std::max(E[k] - E_s, 0.0) / m_L;
+  }
+}
+
+void varcEnthalpyConverter::enthalpy_permissive_n_impl(const double *T, const double *omega,
+                                                       const double *P, double *E,
+                                                       unsigned int n) const {
+  for (unsigned int k = 0; k < n; ++k) {
+    if (T[k] <= 0.0) {
+      throw RuntimeError::formatted("T = %f <= 0 is not a valid absolute temperature", T[k]);
+    }
+  }
+
+  for (unsigned int k = 0; k < n; ++k) {
+    const double T_m = m_T_melting - m_beta * P[k];
+    E[k] = (T[k] < T_m ?
+            EfromT(T[k]) :
+            EfromT(T_m) + std::max(0.0, std::min(omega[k], 1.0)) * m_L);
+  }
+}
+
 } // end of namespace pism
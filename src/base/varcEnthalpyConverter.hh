@@ -43,6 +43,13 @@ protected:
   double enthalpy_impl(double T, double omega, double p) const;
   double temperature_impl(double E, double p) const;
 
+  void temperature_n_impl(const double *E, const double *P, double *T, unsigned int n) const;
+  void water_fraction_n_impl(const double *E, const double *P, double *omega,
+                             unsigned int n) const;
+  void enthalpy_cts_n_impl(const double *P, double *E_s, unsigned int n) const;
+  void enthalpy_permissive_n_impl(const double *T, const double *omega, const double *P,
+                                  double *E, unsigned int n) const;
+
   //!< reference temperature in the parameterization of C(T)
   const double m_T_r;
   //!< \brief the rate of change of C with respect to T in the
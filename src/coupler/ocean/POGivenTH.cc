@@ -17,13 +17,15 @@
 // Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #include <gsl/gsl_math.h>
-#include <gsl/gsl_poly.h>
 #include <cassert>
+#include <cmath>
+#include <algorithm>
 
 #include "POGivenTH.hh"
 #include "base/util/IceGrid.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/PISMConfigInterface.hh"
+#include "base/util/Mask.hh"
 
 namespace pism {
 namespace ocean {
@@ -170,6 +172,59 @@ void GivenTH::melange_back_pressure_fraction_impl(IceModelVec2S &result) {
   result.set(0.0);
 }
 
+//! Number of grid points processed together by GivenTH::update_impl().
+static const unsigned int batch_capacity = 64;
+
+//! A batch of sub-shelf grid points stored in contiguous arrays.
+struct SubShelfBatch {
+  SubShelfBatch() : size(0) {}
+
+  unsigned int size;
+  int i[batch_capacity], j[batch_capacity];
+  double salinity[batch_capacity], theta[batch_capacity], thickness[batch_capacity];
+  double temperature[batch_capacity], melt_rate[batch_capacity];
+};
+
+static void process_batch(const GivenTH::Constants &c, SubShelfBatch &batch,
+                          IceModelVec2S &shelf_base_temperature,
+                          IceModelVec2S &shelf_base_mass_flux);
+
+//! This model works for sea water salinity in the range of [4, 40] psu.
+static const double min_salinity = 4.0, max_salinity = 40.0;
+
+static inline double clip_salinity(const GivenTH::Constants &c, double salinity) {
+  if (c.limit_salinity_range) {
+    return std::min(std::max(salinity, min_salinity), max_salinity);
+  }
+  return salinity;
+}
+
+//! Returns true if the shelf base temperature and mass flux at (i,j) are used by the ice model.
+/*!
+ * These are floating cells and icy cells next to the ocean (the latter
+ * are needed for the sub-grid grounding line treatment). If the cell
+ * type mask is not available, all icy cells are included.
+ */
+static inline bool sub_shelf(const IceModelVec2Int *cell_type,
+                             const IceModelVec2S &ice_thickness,
+                             int i, int j) {
+  if (not (ice_thickness(i, j) > 0.0)) {
+    return false;
+  }
+
+  if (cell_type == NULL) {
+    return true;
+  }
+
+  const IceModelVec2Int &M = *cell_type;
+  return (mask::ocean(M.as_int(i, j)) or
+          mask::ocean(M.as_int(i + 1, j)) or mask::ocean(M.as_int(i - 1, j)) or
+          mask::ocean(M.as_int(i, j + 1)) or mask::ocean(M.as_int(i, j - 1)));
+}
+
+static inline double melting_point_temperature(const GivenTH::Constants &c,
+                                               double salinity, double ice_thickness);
+
 void GivenTH::update_impl(double my_t, double my_dt) {
 
   // Make sure that sea water salinity and sea water potential
@@ -183,44 +238,62 @@ void GivenTH::update_impl(double my_t, double my_dt) {
 
   const IceModelVec2S *ice_thickness = m_grid->variables().get_2d_scalar("land_ice_thickness");
 
+  const IceModelVec2Int *cell_type = NULL;
+  if (m_grid->variables().is_available("mask")) {
+    cell_type = m_grid->variables().get_2d_mask("mask");
+  }
+
   IceModelVec::AccessList list;
   list.add(*ice_thickness);
   list.add(*m_theta_ocean);
   list.add(*m_salinity_ocean);
   list.add(m_shelfbtemp);
   list.add(m_shelfbmassflux);
+  if (cell_type != NULL) {
+    list.add(*cell_type);
+  }
+
+  // The three-equation model is solved in sub-shelf cells only; they
+  // are collected into batches and processed together. Elsewhere the
+  // shelf base temperature is set to the melting point temperature
+  // of the adjacent ocean and the mass flux is set to zero.
+  SubShelfBatch batch;
 
   for (Points p(*m_grid); p; p.next()) {
     const int i = p.i(), j = p.j();
 
-    double potential_temperature_celsius = (*m_theta_ocean)(i,j) - 273.15;
-
-    double
-      shelf_base_temp_celsius = 0.0,
-      shelf_base_massflux     = 0.0;
-
-    pointwise_update(c,
-                     (*m_salinity_ocean)(i,j),
-                     potential_temperature_celsius,
-                     (*ice_thickness)(i,j),
-                     &shelf_base_temp_celsius,
-                     &shelf_base_massflux);
-
-    // Convert from Celsius to Kelvin:
-    m_shelfbtemp(i,j)     = shelf_base_temp_celsius + 273.15;
-    m_shelfbmassflux(i,j) = shelf_base_massflux;
+    const double
+      S_W     = clip_salinity(c, (*m_salinity_ocean)(i,j)),
+      Theta_W = (*m_theta_ocean)(i,j) - 273.15,
+      H       = (*ice_thickness)(i,j);
+
+    if (sub_shelf(cell_type, *ice_thickness, i, j)) {
+      const unsigned int k = batch.size;
+      batch.i[k]         = i;
+      batch.j[k]         = j;
+      batch.salinity[k]  = S_W;
+      batch.theta[k]     = Theta_W;
+      batch.thickness[k] = H;
+      batch.size += 1;
+
+      if (batch.size == batch_capacity) {
+        process_batch(c, batch, m_shelfbtemp, m_shelfbmassflux);
+      }
+    } else {
+      // Convert from Celsius to Kelvin:
+      m_shelfbtemp(i,j)     = melting_point_temperature(c, S_W, H) + 273.15;
+      m_shelfbmassflux(i,j) = 0.0;
+    }
   }
-
-  // convert mass flux from [m s-1] to [kg m-2 s-1]:
-  m_shelfbmassflux.scale(m_config->get_double("ice_density"));
+  process_batch(c, batch, m_shelfbtemp, m_shelfbmassflux);
 }
 
 
 //* Evaluate the parameterization of the melting point temperature.
 /** The value returned is in degrees Celsius.
  */
-static double melting_point_temperature(GivenTH::Constants c,
-                                        double salinity, double ice_thickness) {
+static inline double melting_point_temperature(const GivenTH::Constants &c,
+                                               double salinity, double ice_thickness) {
   return c.a[0] * salinity + c.a[1] + c.a[2] * ice_thickness;
 }
 
@@ -232,12 +305,184 @@ static double melting_point_temperature(GivenTH::Constants c,
  *
  * @return shelf base melt rate, in [m/s]
  */
-static double shelf_base_melt_rate(GivenTH::Constants c,
-                                   double sea_water_salinity, double basal_salinity) {
+static inline double shelf_base_melt_rate(const GivenTH::Constants &c,
+                                          double sea_water_salinity, double basal_salinity) {
 
   return c.gamma_S * c.sea_water_density * (sea_water_salinity - basal_salinity) / (c.ice_density * basal_salinity);
 }
 
+/** The bigger root of @f$ A\cdot x^2 + B\cdot x + C = 0 @f$.
+ *
+ * Uses the same (numerically stable) formula as
+ * `gsl_poly_solve_quadratic()`, without branches and error checking.
+ * All three cases below have @f$ A > 0 @f$ and @f$ C < 0 @f$, so
+ * there are two real roots of opposite signs.
+ */
+static inline double bigger_root(double A, double B, double C) {
+  const double
+    r    = sqrt(B * B - 4.0 * A * C),
+    sgnB = B > 0.0 ? 1.0 : -1.0,
+    q    = -0.5 * (B + sgnB * r);
+
+  return std::max(q / A, C / q);
+}
+
+/** Compute basal salinity in the basal melt case.
+ *
+ * We use the parameterization of the temperature gradient from [@ref
+ * Hellmeretal1998], equation 13:
+ *
+ * @f[ T_{\text{grad}} = -\Delta T\, \frac{\frac{\partial h}{\partial t}}{\kappa}, @f]
+ *
+ * where @f$ \Delta T @f$ is the difference between the ice
+ * temperature at the top of the ice column and its bottom:
+ * @f$ \Delta T = T^S - T^B. @f$ With this parameterization, we have
+ *
+ * @f[ Q_T^I = \rho_I\, c_{pI}\, {\frac{\partial h}{\partial t}}\, (T^S - T^B). @f]
+ *
+ * Then the coefficients of the quadratic equation for basal salinity
+ * (see shelf_base_batch()) are
+ *
+ * @f{align*}{
+ * A &= a_{0}\,\gamma_S\,c_{pI}-b_{0}\,\gamma_T\,c_{pW}\\
+ * B &= \gamma_S\,\left(L-c_{pI}\,\left(T^S+a_{0}\,S^W-a_{2}\,h-a_{1}\right)\right)+
+ *      \gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
+ * C &= -\gamma_S\,S^W\,\left(L-c_{pI}\,\left(T^S-a_{2}\,h-a_{1}\right)\right)
+ * @f}
+ *
+ * @param[in] c physical constants, stored here to avoid looking them up in a double for loop
+ * @param[in] sea_water_salinity salinity of the ocean immediately adjacent to the shelf, [g/kg]
+ * @param[in] sea_water_potential_temperature potential temperature of the sea water, [degrees Celsius]
+ * @param[in] thickness thickness of the ice shelf, [meters]
+ * @return shelf base salinity
+ */
+static inline double subshelf_salinity_melt(const GivenTH::Constants &c,
+                                            double sea_water_salinity,
+                                            double sea_water_potential_temperature,
+                                            double thickness) {
+
+  const double
+    c_pI    = c.ice_specific_heat_capacity,
+    c_pW    = c.sea_water_specific_heat_capacity,
+    L       = c.water_latent_heat_fusion,
+    T_S     = c.shelf_top_surface_temperature,
+    S_W     = sea_water_salinity,
+    Theta_W = sea_water_potential_temperature;
+
+  // We solve a quadratic equation for Sb, the salinity at the shelf
+  // base.
+  //
+  // A*Sb^2 + B*Sb + C = 0
+  const double A = c.a[0] * c.gamma_S * c_pI - c.b[0] * c.gamma_T * c_pW;
+  const double B = (c.gamma_S * (L - c_pI * (T_S + c.a[0] * S_W - c.a[2] * thickness - c.a[1])) +
+                    c.gamma_T * c_pW * (Theta_W - c.b[2] * thickness - c.b[1]));
+  const double C = -c.gamma_S * S_W * (L - c_pI * (T_S - c.a[2] * thickness - c.a[1]));
+
+  return bigger_root(A, B, C);
+}
+
+/** Compute basal salinity in the basal freeze-on case.
+ *
+ * In this case we assume that the temperature gradient at the shelf base is zero:
+ *
+ * @f[ T_{\text{grad}} = 0. @f]
+ *
+ * Please see shelf_base_batch() for details.
+ *
+ * In this case the coefficients of the quadratic equation for the
+ * basal salinity are:
+ *
+ * @f{align*}{
+ * A &= -b_{0}\,\gamma_T\,c_{pW} \\
+ * B &= \gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right) \\
+ * C &= -\gamma_S\,S^W\,L\\
+ * @f}
+ *
+ * @param[in] c model constants
+ * @param[in] sea_water_salinity sea water salinity
+ * @param[in] sea_water_potential_temperature sea water temperature
+ * @param[in] thickness ice shelf thickness
+ * @return shelf base salinity
+ */
+static inline double subshelf_salinity_freeze_on(const GivenTH::Constants &c,
+                                                 double sea_water_salinity,
+                                                 double sea_water_potential_temperature,
+                                                 double thickness) {
+
+  const double
+    c_pW    = c.sea_water_specific_heat_capacity,
+    L       = c.water_latent_heat_fusion,
+    S_W     = sea_water_salinity,
+    Theta_W = sea_water_potential_temperature,
+    h       = thickness;
+
+  // We solve a quadratic equation for Sb, the salinity at the shelf
+  // base.
+  //
+  // A*Sb^2 + B*Sb + C = 0
+  const double A = -c.b[0] * c.gamma_T * c_pW;
+  const double B = c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]);
+  const double C = -c.gamma_S * S_W * L;
+
+  return bigger_root(A, B, C);
+}
+
+/** @brief Compute basal salinity in the case of no basal melt and no
+ * freeze-on, with the diffusion-only temperature distribution in the
+ * ice column.
+ *
+ * In this case the temperature gradient at the base ([@ref
+ * HollandJenkins1999], equation 21) is
+ *
+ * @f[ T_{\text{grad}} = \frac{\Delta T}{h}, @f]
+ *
+ * where @f$ h @f$ is the ice shelf thickness and @f$ \Delta T = T^S -
+ * T^B @f$ is the difference between the temperature at the top and
+ * the bottom of the shelf.
+ *
+ * In this case the coefficients of the quadratic equation for the basal salinity are:
+ *
+ * @f{align*}{
+ * A &= - \frac{b_{0}\,\gamma_T\,h\,\rho_W\,c_{pW}-a_{0}\,\rho_I\,c_{pI}\,\kappa}{h\,\rho_W}\\
+ * B &= \frac{\rho_I\,c_{pI}\,\kappa\,\left(T^S-a_{2}\,h-a_{1}\right)}{h\,\rho_W}
+ +\gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
+ * C &= -\gamma_S\,S^W\,L\\
+ * @f}
+ *
+ * @param[in] c model constants
+ * @param[in] sea_water_salinity sea water salinity
+ * @param[in] sea_water_potential_temperature sea water potential temperature
+ * @param[in] thickness ice shelf thickness
+ * @return shelf base salinity
+ */
+static inline double subshelf_salinity_diffusion_only(const GivenTH::Constants &c,
+                                                      double sea_water_salinity,
+                                                      double sea_water_potential_temperature,
+                                                      double thickness) {
+  const double
+    c_pI    = c.ice_specific_heat_capacity,
+    c_pW    = c.sea_water_specific_heat_capacity,
+    L       = c.water_latent_heat_fusion,
+    T_S     = c.shelf_top_surface_temperature,
+    S_W     = sea_water_salinity,
+    Theta_W = sea_water_potential_temperature,
+    h       = thickness,
+    rho_W   = c.sea_water_density,
+    rho_I   = c.ice_density,
+    kappa   = c.ice_thermal_diffusivity;
+
+  // We solve a quadratic equation for Sb, the salinity at the shelf
+  // base.
+  //
+  // A*Sb^2 + B*Sb + C = 0
+  const double A = -(c.b[0] * c.gamma_T * h * rho_W * c_pW - c.a[0] * rho_I * c_pI * kappa) / (h * rho_W);
+  const double B = ((rho_I * c_pI * kappa * (T_S - c.a[2] * h - c.a[1])) / (h * rho_W) +
+                    c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]));
+  const double C = -c.gamma_S * S_W * L;
+
+  return bigger_root(A, B, C);
+}
+
 /** @brief Compute temperature and melt rate at the base of the shelf.
  * Based on [@ref HellmerOlbers1989] and [@ref HollandJenkins1999].
  *
@@ -363,8 +608,9 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  * not, and cannot pick one of the three cases without computing the
  * basal melt rate first.
  *
- * This method tries to compute basal salinity that is consistent with
- * the corresponding basal melt rate. See the code for details.
+ * We compute basal salinity for all three cases and use the first
+ * one (melt, freeze-on, diffusion-only) that is consistent with the
+ * sign of the corresponding basal melt rate.
  *
  * Once @f$ S_B @f$ is found by solving this quadratic equation, we can
  * compute the basal temperature using the parameterization for @f$
@@ -376,304 +622,72 @@ static double shelf_base_melt_rate(GivenTH::Constants c,
  * @f[ w_b = -\frac{\partial h}{\partial t} = \frac{\gamma_S\, \rho_W\, (S^W - S^B)}{\rho_I\, S^B}. @f]
  *
  *
- * @param[in] constants model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_temperature_out resulting basal temperature
- * @param[out] shelf_base_melt_rate_out resulting basal melt rate
+ * This function processes a batch of grid points at once: the loop
+ * body is branch-free (apart from conditional moves) and works on
+ * contiguous arrays, so the compiler can vectorize it.
  *
- * @return 0 on success
+ * @param[in] c model constants
+ * @param[in] n number of points in the batch
+ * @param[in] S_W sea water salinity (already clipped, if requested)
+ * @param[in] Theta_W sea water potential temperature, [degrees Celsius]
+ * @param[in] H ice shelf thickness (has to be positive)
+ * @param[out] T_b resulting basal temperature, [degrees Celsius]
+ * @param[out] w_b resulting basal melt rate, [m/s]
  */
-void GivenTH::pointwise_update(const Constants &constants,
-                                 double sea_water_salinity,
-                                 double sea_water_potential_temperature,
-                                 double thickness,
-                                 double *shelf_base_temperature_out,
-                                 double *shelf_base_melt_rate_out) {
-
-  assert(thickness >= 0.0);
-
-  // This model works for sea water salinity in the range of [4, 40]
-  // psu. Ensure that input salinity is in this range.
-  const double
-    min_salinity = 4.0,
-    max_salinity = 40.0;
-
-  if (constants.limit_salinity_range == true) {
-    if (sea_water_salinity < min_salinity) {
-      sea_water_salinity = min_salinity;
-    } else if (sea_water_salinity > max_salinity) {
-      sea_water_salinity = max_salinity;
+static void shelf_base_batch(const GivenTH::Constants &c,
+                             unsigned int n,
+                             const double *S_W,
+                             const double *Theta_W,
+                             const double *H,
+                             double *T_b,
+                             double *w_b) {
+
+  for (unsigned int k = 0; k < n; ++k) {
+    assert(H[k] > 0.0);
+
+    const double
+      S_melt      = subshelf_salinity_melt(c, S_W[k], Theta_W[k], H[k]),
+      S_freeze_on = subshelf_salinity_freeze_on(c, S_W[k], Theta_W[k], H[k]),
+      S_diffusion = subshelf_salinity_diffusion_only(c, S_W[k], Theta_W[k], H[k]);
+
+    // Use the first basal salinity that is consistent with the
+    // assumption used to compute it. The "diffusion-only" case may be
+    // less accurate, but is generic and is always consistent.
+    double basal_salinity = S_diffusion;
+    if (shelf_base_melt_rate(c, S_W[k], S_freeze_on) < 0.0) {
+      basal_salinity = S_freeze_on;
     }
-  }
-
-  double basal_salinity = sea_water_salinity;
-  subshelf_salinity(constants, sea_water_salinity, sea_water_potential_temperature,
-                    thickness, &basal_salinity);
-
-  // Clip basal salinity so that we can use the freezing point
-  // temperature parameterization to recover shelf base temperature.
-  if (constants.limit_salinity_range == true) {
-    if (basal_salinity <= min_salinity) {
-      basal_salinity = min_salinity;
-    } else if (basal_salinity >= max_salinity) {
-      basal_salinity = max_salinity;
+    if (shelf_base_melt_rate(c, S_W[k], S_melt) > 0.0) {
+      basal_salinity = S_melt;
     }
-  }
 
-  *shelf_base_temperature_out = melting_point_temperature(constants, basal_salinity, thickness);
+    // Clip basal salinity so that we can use the freezing point
+    // temperature parameterization to recover shelf base temperature.
+    basal_salinity = clip_salinity(c, basal_salinity);
 
-  *shelf_base_melt_rate_out = shelf_base_melt_rate(constants, sea_water_salinity, basal_salinity);
-
-  // no melt if there is no ice
-  if (thickness == 0.0) {
-    *shelf_base_melt_rate_out = 0.0;
+    T_b[k] = melting_point_temperature(c, basal_salinity, H[k]);
+    w_b[k] = shelf_base_melt_rate(c, S_W[k], basal_salinity);
   }
 }
 
+//! Process a batch of sub-shelf points, store results, and empty the batch.
+static void process_batch(const GivenTH::Constants &c, SubShelfBatch &batch,
+                          IceModelVec2S &shelf_base_temperature,
+                          IceModelVec2S &shelf_base_mass_flux) {
+  const unsigned int n = batch.size;
 
-/** @brief Compute the basal salinity and make sure that it is
- * consistent with the basal melt rate.
- *
- * @param[in] c constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting shelf base salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity(const Constants &c,
-                                            double sea_water_salinity,
-                                            double sea_water_potential_temperature,
-                                            double thickness,
-                                            double *shelf_base_salinity) {
-  double basal_salinity = sea_water_salinity;
-
-  // first, assume that there is melt at the shelf base:
-  {
-    subshelf_salinity_melt(c, sea_water_salinity, sea_water_potential_temperature,
-                           thickness, &basal_salinity);
-
-    double basal_melt_rate = shelf_base_melt_rate(c, sea_water_salinity, basal_salinity);
-
-    if (basal_melt_rate > 0.0) {
-      // computed basal melt rate is consistent with the assumption used
-      // to compute basal salinity
-      *shelf_base_salinity = basal_salinity;
-      return;
-    }
-  }
-
-  // Assuming that there is melt resulted in an inconsistent
-  // (salinity, melt_rate) pair. Assume that there is freeze-on at the base.
-  {
-    subshelf_salinity_freeze_on(c, sea_water_salinity, sea_water_potential_temperature,
-                                thickness, &basal_salinity);
-
-    double basal_melt_rate = shelf_base_melt_rate(c, sea_water_salinity, basal_salinity);
+  shelf_base_batch(c, n, batch.salinity, batch.theta, batch.thickness,
+                   batch.temperature, batch.melt_rate);
 
-    if (basal_melt_rate < 0.0) {
-      // computed basal melt rate is consistent with the assumption
-      // used to compute basal salinity
-      *shelf_base_salinity = basal_salinity;
-      return;
-    }
-  }
-
-  // Both assumptions (above) resulted in inconsistencies. Revert to
-  // the "diffusion-only" case, which may be less accurate, but is
-  // generic and is always consistent.
-  {
-    subshelf_salinity_diffusion_only(c, sea_water_salinity, sea_water_potential_temperature,
-                                     thickness, &basal_salinity);
-
-    *shelf_base_salinity = basal_salinity;
+  for (unsigned int k = 0; k < n; ++k) {
+    const int i = batch.i[k], j = batch.j[k];
+    // Convert from Celsius to Kelvin:
+    shelf_base_temperature(i, j) = batch.temperature[k] + 273.15;
+    // convert mass flux from [m s-1] to [kg m-2 s-1]:
+    shelf_base_mass_flux(i, j)   = batch.melt_rate[k] * c.ice_density;
   }
-}
-
-/** Compute basal salinity in the basal melt case.
- *
- * We use the parameterization of the temperature gradient from [@ref
- * Hellmeretal1998], equation 13:
- *
- * @f[ T_{\text{grad}} = -\Delta T\, \frac{\frac{\partial h}{\partial t}}{\kappa}, @f]
- *
- * where @f$ \Delta T @f$ is the difference between the ice
- * temperature at the top of the ice column and its bottom:
- * @f$ \Delta T = T^S - T^B. @f$ With this parameterization, we have
- *
- * @f[ Q_T^I = \rho_I\, c_{pI}\, {\frac{\partial h}{\partial t}}\, (T^S - T^B). @f]
- *
- * Then the coefficients of the quadratic equation for basal salinity
- * (see pointwise_update()) are
- *
- * @f{align*}{
- * A &= a_{0}\,\gamma_S\,c_{pI}-b_{0}\,\gamma_T\,c_{pW}\\
- * B &= \gamma_S\,\left(L-c_{pI}\,\left(T^S+a_{0}\,S^W-a_{2}\,h-a_{1}\right)\right)+
- *      \gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
- * C &= -\gamma_S\,S^W\,\left(L-c_{pI}\,\left(T^S-a_{2}\,h-a_{1}\right)\right)
- * @f}
- *
- * @param[in] c physical constants, stored here to avoid looking them up in a double for loop
- * @param[in] sea_water_salinity salinity of the ocean immediately adjacent to the shelf, [g/kg]
- * @param[in] sea_water_potential_temperature potential temperature of the sea water, [degrees Celsius]
- * @param[in] thickness thickness of the ice shelf, [meters]
- * @param[out] shelf_base_salinity resulting shelf base salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity_melt(const Constants &c,
-                                                 double sea_water_salinity,
-                                                 double sea_water_potential_temperature,
-                                                 double thickness,
-                                                 double *shelf_base_salinity) {
-
-  const double
-    c_pI    = c.ice_specific_heat_capacity,
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    T_S     = c.shelf_top_surface_temperature,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature;
-
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = c.a[0] * c.gamma_S * c_pI - c.b[0] * c.gamma_T * c_pW;
-  const double B = (c.gamma_S * (L - c_pI * (T_S + c.a[0] * S_W - c.a[2] * thickness - c.a[1])) +
-                    c.gamma_T * c_pW * (Theta_W - c.b[2] * thickness - c.b[1]));
-  const double C = -c.gamma_S * S_W * (L - c_pI * (T_S - c.a[2] * thickness - c.a[1]));
-
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
-
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
-
-  *shelf_base_salinity = S2;
-}
-
-/** Compute basal salinity in the basal freeze-on case.
- *
- * In this case we assume that the temperature gradient at the shelf base is zero:
- *
- * @f[ T_{\text{grad}} = 0. @f]
- *
- * Please see pointwise_update() for details.
- *
- * In this case the coefficients of the quadratic equation for the
- * basal salinity are:
- *
- * @f{align*}{
- * A &= -b_{0}\,\gamma_T\,c_{pW} \\
- * B &= \gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right) \\
- * C &= -\gamma_S\,S^W\,L\\
- * @f}
- *
- * @param[in] c model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting basal salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity_freeze_on(const Constants &c,
-                                                      double sea_water_salinity,
-                                                      double sea_water_potential_temperature,
-                                                      double thickness,
-                                                      double *shelf_base_salinity) {
-
-  const double
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature,
-    h       = thickness;
-
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = -c.b[0] * c.gamma_T * c_pW;
-  const double B = c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]);
-  const double C = -c.gamma_S * S_W * L;
-
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
-
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
-
-  *shelf_base_salinity = S2;
-}
-
-/** @brief Compute basal salinity in the case of no basal melt and no
- * freeze-on, with the diffusion-only temperature distribution in the
- * ice column.
- *
- * In this case the temperature gradient at the base ([@ref
- * HollandJenkins1999], equation 21) is
- *
- * @f[ T_{\text{grad}} = \frac{\Delta T}{h}, @f]
- *
- * where @f$ h @f$ is the ice shelf thickness and @f$ \Delta T = T^S -
- * T^B @f$ is the difference between the temperature at the top and
- * the bottom of the shelf.
- *
- * In this case the coefficients of the quadratic equation for the basal salinity are:
- *
- * @f{align*}{
- * A &= - \frac{b_{0}\,\gamma_T\,h\,\rho_W\,c_{pW}-a_{0}\,\rho_I\,c_{pI}\,\kappa}{h\,\rho_W}\\
- * B &= \frac{\rho_I\,c_{pI}\,\kappa\,\left(T^S-a_{2}\,h-a_{1}\right)}{h\,\rho_W}
- +\gamma_S\,L+\gamma_T\,c_{pW}\,\left(\Theta^W-b_{2}\,h-b_{1}\right)\\
- * C &= -\gamma_S\,S^W\,L\\
- * @f}
- *
- * @param[in] c model constants
- * @param[in] sea_water_salinity sea water salinity
- * @param[in] sea_water_potential_temperature sea water potential temperature
- * @param[in] thickness ice shelf thickness
- * @param[out] shelf_base_salinity resulting basal salinity
- *
- * @return 0 on success
- */
-void GivenTH::subshelf_salinity_diffusion_only(const Constants &c,
-                                                           double sea_water_salinity,
-                                                           double sea_water_potential_temperature,
-                                                           double thickness,
-                                                           double *shelf_base_salinity) {
-  const double
-    c_pI    = c.ice_specific_heat_capacity,
-    c_pW    = c.sea_water_specific_heat_capacity,
-    L       = c.water_latent_heat_fusion,
-    T_S     = c.shelf_top_surface_temperature,
-    S_W     = sea_water_salinity,
-    Theta_W = sea_water_potential_temperature,
-    h       = thickness,
-    rho_W   = c.sea_water_density,
-    rho_I   = c.ice_density,
-    kappa   = c.ice_thermal_diffusivity;
-
-  // We solve a quadratic equation for Sb, the salinity at the shelf
-  // base.
-  //
-  // A*Sb^2 + B*Sb + C = 0
-  const double A = -(c.b[0] * c.gamma_T * h * rho_W * c_pW - c.a[0] * rho_I * c_pI * kappa) / (h * rho_W);
-  const double B = ((rho_I * c_pI * kappa * (T_S - c.a[2] * h - c.a[1])) / (h * rho_W) +
-                    c.gamma_S * L + c.gamma_T * c_pW * (Theta_W - c.b[2] * h - c.b[1]));
-  const double C = -c.gamma_S * S_W * L;
-
-  double S1 = 0.0, S2 = 0.0;
-  const int n_roots = gsl_poly_solve_quadratic(A, B, C, &S1, &S2);
-
-  assert(n_roots > 0);
-  assert(S2 > 0.0);             // The bigger root should be positive.
 
-  *shelf_base_salinity = S2;
+  batch.size = 0;
 }
 
 } // end of namespace ocean
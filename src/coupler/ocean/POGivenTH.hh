@@ -72,37 +72,6 @@ protected:
 private:
   IceModelVec2S m_shelfbtemp, m_shelfbmassflux;
   IceModelVec2T *m_theta_ocean, *m_salinity_ocean;
-
-  void pointwise_update(const Constants &constants,
-                        double sea_water_salinity,
-                        double sea_water_potential_temperature,
-                        double ice_thickness,
-                        double *shelf_base_temperature_out,
-                        double *shelf_base_melt_rate_out);
-
-  void subshelf_salinity(const Constants &constants,
-                         double sea_water_salinity,
-                         double sea_water_potential_temperature,
-                         double ice_thickness,
-                         double *shelf_base_salinity);
-
-  void subshelf_salinity_melt(const Constants &constants,
-                              double sea_water_salinity,
-                              double sea_water_potential_temperature,
-                              double ice_thickness,
-                              double *shelf_base_salinity);
-
-  void subshelf_salinity_freeze_on(const Constants &constants,
-                                   double sea_water_salinity,
-                                   double sea_water_potential_temperature,
-                                   double ice_thickness,
-                                   double *shelf_base_salinity);
-
-  void subshelf_salinity_diffusion_only(const Constants &constants,
-                                        double sea_water_salinity,
-                                        double sea_water_potential_temperature,
-                                        double ice_thickness,
-                                        double *shelf_base_salinity);
 };
 
 } // end of namespace ocean
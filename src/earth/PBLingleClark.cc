@@ -45,7 +45,7 @@ PBLingleClark::PBLingleClark(IceGrid::ConstPtr g)
   ParallelSection rank0(m_grid->com);
   try {
     if (m_grid->rank() == 0) {
-      m_bdLC = new BedDeformLC(*m_config, use_elastic_model,
+      m_bdLC = new BedDeformLC(*m_config, m_grid->ctx()->shared_arrays(), use_elastic_model,
                                m_grid->Mx(), m_grid->My(), m_grid->dx(), m_grid->dy(),
                                4,     // use Z = 4 for now; to reduce global drift?
                                *m_Hstartp0, *m_bedstartp0, *m_upliftp0, *m_Hp0, *m_bedp0);
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <fftw3.h>
 #include <cassert>
+#include <cstdio>
 
 #include "base/util/pism_const.hh"
 #include "matlablike.hh"
@@ -50,12 +51,15 @@ private:
 };
 
 BedDeformLC::BedDeformLC(const Config &config,
+                         const SharedArrays &shared,
                          bool myinclude_elastic,
                          int myMx, int myMy,
                          double mydx, double mydy,
                          int myZ,
                          Vec myHstart, Vec mybedstart, Vec myuplift,
-                         Vec myH, Vec mybed) {
+                         Vec myH, Vec mybed)
+  : m_shared(shared),
+    m_load_response(mydx, mydy, myZ * (myMy - 1) + 1) {
 
   // set parameters
   m_include_elastic = myinclude_elastic;
@@ -114,9 +118,6 @@ BedDeformLC::BedDeformLC(const Config &config,
   ierr = VecDuplicate(m_U, m_vright.rawptr());
   PISM_CHK(ierr, "VecDuplicate");
 
-  ierr = VecCreateSeq(PETSC_COMM_SELF, m_Nxge * m_Nyge, m_lrmE.rawptr());
-  PISM_CHK(ierr, "VecCreateSeq");
-
   // setup fftw stuff: FFTW builds "plans" based on observed performance
 
   m_fftw_input  = (fftw_complex*) fftw_malloc(sizeof(fftw_complex) * m_Nx * m_Ny);
@@ -189,28 +190,57 @@ void BedDeformLC::precompute_coefficients() {
 
   // compare geforconv.m
   if (m_include_elastic == true) {
+    char key[TEMPORARY_STRING_LENGTH];
+    snprintf(key, TEMPORARY_STRING_LENGTH,
+             "Lingle-Clark elastic load response %d %d %.17g %.17g",
+             m_Nxge, m_Nyge, m_dx, m_dy);
+    m_load_response_key = key;
+
     ierr = PetscPrintf(PETSC_COMM_SELF,
                        "     computing spherical elastic load response matrix ...");
     PISM_CHK(ierr, "PetscPrintf");
 
-    petsc::VecArray2D II(m_lrmE, m_Nxge, m_Nyge);
-    ge_params ge_data;
-    ge_data.dx = m_dx;
-    ge_data.dy = m_dy;
-    for (int i = 0; i < m_Nxge; i++) {
-      for (int j = 0; j < m_Nyge; j++) {
-        ge_data.p = i;
-        ge_data.q = j;
-        II(i, j) = dblquad_cubature(ge_integrand, -m_dx/2, m_dx/2, -m_dy/2, m_dy/2,
-                                    1.0e-8, &ge_data);
-      }
-    }
+    // this may be deferred (see SharedArrays)
+    m_shared.request(m_load_response_key, m_Nxge * m_Nyge, m_load_response);
 
     ierr = PetscPrintf(PETSC_COMM_SELF, " done\n");
     PISM_CHK(ierr, "PetscPrintf");
   }
 }
 
+BedDeformLC::LoadResponse::LoadResponse(double dx, double dy, int Nyge)
+  : m_dx(dx), m_dy(dy), m_Nyge(Nyge) {
+  // empty
+}
+
+void BedDeformLC::LoadResponse::compute(unsigned int begin, unsigned int end,
+                                        double *array) const {
+  ge_params ge_data;
+  ge_data.dx = m_dx;
+  ge_data.dy = m_dy;
+  for (unsigned int k = begin; k < end; ++k) {
+    // the load response matrix is stored in the row-major order (see VecArray2D)
+    ge_data.p = k / m_Nyge;
+    ge_data.q = k % m_Nyge;
+    array[k] = dblquad_cubature(ge_integrand, -m_dx/2, m_dx/2, -m_dy/2, m_dy/2,
+                                1.0e-8, &ge_data);
+  }
+}
+
+//! Returns the elastic load response matrix (sequential and fat *with* boundary).
+/*!
+ * The Vec uses the storage owned by SharedArrays.
+ */
+Vec BedDeformLC::load_response() {
+  if (m_lrmE.get() == NULL) {
+    PetscErrorCode ierr = VecCreateSeqWithArray(PETSC_COMM_SELF, 1, m_Nxge * m_Nyge,
+                                                m_shared.get(m_load_response_key),
+                                                m_lrmE.rawptr());
+    PISM_CHK(ierr, "VecCreateSeqWithArray");
+  }
+  return m_lrmE;
+}
+
 void BedDeformLC::uplift_init() {
   // to initialize we solve:
   //   rho_r g U + D grad^4 U = 0 - 2 eta |grad| uplift
@@ -347,7 +377,7 @@ void BedDeformLC::step(double dt_seconds, double seconds_from_start) {
   // now compute elastic response if desired; bed = ue at end of this block
   if (m_include_elastic == true) {
     // Matlab:     ue=rhoi*conv2(H-H_start, II, 'same')
-    conv2_same(m_Hdiff, m_Mx, m_My, m_lrmE, m_Nxge, m_Nyge, m_dbedElastic);
+    conv2_same(m_Hdiff, m_Mx, m_My, load_response(), m_Nxge, m_Nyge, m_dbedElastic);
 
     ierr = VecScale(m_dbedElastic, m_icerho);
     PISM_CHK(ierr, "VecScale");
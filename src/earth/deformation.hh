@@ -22,7 +22,10 @@
 #include <petscvec.h>
 #include <fftw3.h>
 
+#include <string>
+
 #include "base/util/petscwrappers/Vec.hh"
+#include "base/util/SharedArrays.hh"
 
 namespace pism {
 
@@ -47,10 +50,15 @@ namespace bed {
   owns the entire 2D gridded ice thicknesses and bed elevations.)
 
   A test program for this class is pism/src/verif/tryLCbd.cc.
+
+  The elastic load response matrix depends on the grid only, so it is
+  requested from SharedArrays: it is computed once and shared by all
+  ensemble members using the same grid on a node (see pism_ensemble).
 */
 class BedDeformLC {
 public:
   BedDeformLC(const Config &config,
+                const SharedArrays &shared,
                 bool myinclude_elastic,
                 int myMx, int myMy, double mydx, double mydy,
                 int myZ,
@@ -97,6 +105,22 @@ private:
   fftw_complex *m_fftw_input, *m_fftw_output, *m_loadhat; // 2D sequential
   fftw_plan m_dft_forward, m_dft_inverse;
 
+  //! Computes entries of the elastic load response matrix.
+  class LoadResponse : public SharedArrays::Provider {
+  public:
+    LoadResponse(double dx, double dy, int Nyge);
+    void compute(unsigned int begin, unsigned int end, double *array) const;
+  private:
+    double m_dx, m_dy;
+    int m_Nyge;
+  };
+
+  const SharedArrays &m_shared;
+  LoadResponse m_load_response;
+  std::string m_load_response_key;
+
+  Vec load_response();
+
   void tweak(double seconds_from_start);
 
   void clear_fftw_input();
@@ -230,7 +230,7 @@ int main(int argc, char *argv[]) {
       ierr = PetscPrintf(PETSC_COMM_SELF,"setting BedDeformLC\n");
       PISM_CHK(ierr, "PetscPrintf");
 
-      pism::bed::BedDeformLC bdlc(*config,
+      pism::bed::BedDeformLC bdlc(*config, ctx->shared_arrays(),
                                   include_elastic, Mx, My, dx, dy, Z,
                                   Hstart, bedstart, uplift, H, bed);
 
@@ -39,7 +39,8 @@ IP_SSAHardavForwardProblem::IP_SSAHardavForwardProblem(IceGrid::ConstPtr g, Enth
     m_design_param(tp),
     m_element_index(*m_grid),
     m_quadrature(*m_grid, 1.0),
-    m_rebuild_J_state(true) {
+    m_rebuild_J_state(true),
+    m_linearization_ksp_iterations(0) {
   this->construct();
 }
 
@@ -78,6 +79,10 @@ void IP_SSAHardavForwardProblem::construct() {
   ierr = KSPCreate(m_grid->com, m_ksp.rawptr());
   PISM_CHK(ierr, "KSPCreate");
 
+  // Use "-inv_state_pc_type lu" (for example) to use a direct solver.
+  ierr = KSPSetOptionsPrefix(m_ksp, "inv_state_");
+  PISM_CHK(ierr, "KSPSetOptionsPrefix");
+
   double ksp_rtol = 1e-12;
   ierr = KSPSetTolerances(m_ksp, ksp_rtol, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT);
   PISM_CHK(ierr, "KSPSetTolerances");
@@ -128,6 +133,9 @@ void IP_SSAHardavForwardProblem::set_design(IceModelVec2S &new_zeta) {
     }
   }
 
+  // Viscosity and basal drag saved by compute_local_function() are out of date.
+  invalidate_nuH_and_beta();
+
   // Flag the state jacobian as needing rebuilding.
   m_rebuild_J_state = true;
 }
@@ -541,32 +549,18 @@ void IP_SSAHardavForwardProblem::apply_jacobian_design_transpose(IceModelVec2V &
   }
 }
 
-/*!\brief Applies the linearization of the forward map (i.e. the reduced gradient \f$DF\f$ described in
-the class-level documentation.) */
-/*! As described previously,
-\f[
-Df = J_{\rm State}^{-1} J_{\rm Design}.
-\f]
-Applying the linearization then involves the solution of a linear equation.
-The matrices \f$J_{\rm State}\f$ and \f$J_{\rm Design}\f$ both depend on the value of the
-design variable \f$\zeta\f$ and the value of the corresponding state variable \f$u=F(\zeta)\f$.
-These are established by first calling linearize_at.
-  @param[in]   dzeta     Perturbation of the design variable
-  @param[out]  du        Computed corresponding perturbation of the state variable; ghosts (if present) are updated.
-*/
-void IP_SSAHardavForwardProblem::apply_linearization(IceModelVec2S &dzeta, IceModelVec2V &du) {
-
-  PetscErrorCode ierr;
-
-  if (m_rebuild_J_state) {
-    this->assemble_jacobian_state(m_velocity, m_J_state);
-    m_rebuild_J_state = false;
+//! Assembles \f$J_{\rm State}\f$ and passes it to the KSP if the linearization point changed.
+/*! The preconditioner (or a factorization, if a direct solver is selected) is built during the
+  first solve and re-used by both apply_linearization() and apply_linearization_transpose()
+  until the next call to linearize_at(). */
+void IP_SSAHardavForwardProblem::setup_linearization_solver() {
+  if (not m_rebuild_J_state) {
+    return;
   }
 
-  this->apply_jacobian_design(m_velocity, dzeta, m_du_global);
-  m_du_global.scale(-1);
+  this->assemble_jacobian_state(m_velocity, m_J_state);
 
-  // call PETSc to solve linear system by iterative method.
+  PetscErrorCode ierr;
 #if PETSC_VERSION_LT(3,5,0)
   ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state, SAME_NONZERO_PATTERN);
   PISM_CHK(ierr, "KSPSetOperators");
@@ -574,10 +568,24 @@ void IP_SSAHardavForwardProblem::apply_linearization(IceModelVec2S &dzeta, IceMo
   ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
   PISM_CHK(ierr, "KSPSetOperators");
 #endif
+
+  m_rebuild_J_state = false;
+}
+
+//! Solves \f$J_{\rm State}\, x = b\f$ in place, with \f$b\f$ stored in `m_du_global`.
+void IP_SSAHardavForwardProblem::solve_linearization() {
+  PetscErrorCode ierr;
+
+  // call PETSc to solve linear system by iterative method.
   ierr = KSPSolve(m_ksp, m_du_global.get_vec(), m_du_global.get_vec());
   PISM_CHK(ierr, "KSPSolve"); // SOLVE
 
-  KSPConvergedReason reason;
+  PetscInt ksp_iterations = 0;
+  ierr = KSPGetIterationNumber(m_ksp, &ksp_iterations);
+  PISM_CHK(ierr, "KSPGetIterationNumber");
+  m_linearization_ksp_iterations += ksp_iterations;
+
+  KSPConvergedReason  reason;
   ierr = KSPGetConvergedReason(m_ksp, &reason);
   PISM_CHK(ierr, "KSPGetConvergedReason");
 
@@ -591,6 +599,34 @@ void IP_SSAHardavForwardProblem::apply_linearization(IceModelVec2S &dzeta, IceMo
                " (KSP reason %s)\n",
                KSPConvergedReasons[reason]);
   }
+}
+
+//! Returns the total number of KSP iterations used to apply the linearization and its transpose.
+unsigned int IP_SSAHardavForwardProblem::linearization_ksp_iterations() const {
+  return m_linearization_ksp_iterations;
+}
+
+/*!\brief Applies the linearization of the forward map (i.e. the reduced gradient \f$DF\f$ described in
+the class-level documentation.) */
+/*! As described previously,
+\f[
+Df = J_{\rm State}^{-1} J_{\rm Design}.
+\f]
+Applying the linearization then involves the solution of a linear equation.
+The matrices \f$J_{\rm State}\f$ and \f$J_{\rm Design}\f$ both depend on the value of the
+design variable \f$\zeta\f$ and the value of the corresponding state variable \f$u=F(\zeta)\f$.
+These are established by first calling linearize_at.
+  @param[in]   dzeta     Perturbation of the design variable
+  @param[out]  du        Computed corresponding perturbation of the state variable; ghosts (if present) are updated.
+*/
+void IP_SSAHardavForwardProblem::apply_linearization(IceModelVec2S &dzeta, IceModelVec2V &du) {
+
+  this->setup_linearization_solver();
+
+  this->apply_jacobian_design(m_velocity, dzeta, m_du_global);
+  m_du_global.scale(-1);
+
+  this->solve_linearization();
 
   du.copy_from(m_du_global);
 }
@@ -615,12 +651,7 @@ These are established by first calling linearize_at.
 void IP_SSAHardavForwardProblem::apply_linearization_transpose(IceModelVec2V &du,
                                                                IceModelVec2S &dzeta) {
 
-  PetscErrorCode ierr;
-
-  if (m_rebuild_J_state) {
-    this->assemble_jacobian_state(m_velocity, m_J_state);
-    m_rebuild_J_state = false;
-  }
+  this->setup_linearization_solver();
 
   // Aliases to help with notation consistency below.
   const IceModelVec2Int *m_dirichletLocations = m_bc_mask;
@@ -637,29 +668,7 @@ void IP_SSAHardavForwardProblem::apply_linearization_transpose(IceModelVec2V &du
   dirichletBC.finish();
   m_du_global.end_access();
 
-  // call PETSc to solve linear system by iterative method.
-#if PETSC_VERSION_LT(3,5,0)
-  ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state, SAME_NONZERO_PATTERN);
-  PISM_CHK(ierr, "KSPSetOperators");
-#else
-  ierr = KSPSetOperators(m_ksp, m_J_state, m_J_state);
-  PISM_CHK(ierr, "KSPSetOperators");
-#endif
-  ierr = KSPSolve(m_ksp, m_du_global.get_vec(), m_du_global.get_vec());
-  PISM_CHK(ierr, "KSPSolve"); // SOLVE
-
-  KSPConvergedReason  reason;
-  ierr = KSPGetConvergedReason(m_ksp, &reason);
-  PISM_CHK(ierr, "KSPGetConvergedReason");
-
-  if (reason < 0) {
-    throw RuntimeError::formatted("IP_SSAHardavForwardProblem::apply_linearization solve failed to converge (KSP reason %s)",
-                                  KSPConvergedReasons[reason]);
-  } else {
-    verbPrintf(4, m_grid->com,
-               "IP_SSAHardavForwardProblem::apply_linearization converged (KSP reason %s)\n",
-               KSPConvergedReasons[reason]);
-  }
+  this->solve_linearization();
 
   this->apply_jacobian_design_transpose(m_velocity, m_du_global, dzeta);
   dzeta.scale(-1);
@@ -669,5 +678,51 @@ void IP_SSAHardavForwardProblem::apply_linearization_transpose(IceModelVec2V &du
   }
 }
 
+//! Applies the linearization of the forward map to several perturbations of the design variable.
+/*! Equivalent to calling apply_linearization(IceModelVec2S&, IceModelVec2V&) for each pair
+  `(*dzeta[k], *du[k])`, but \f$J_{\rm State}\f$ is assembled and its preconditioner (or
+  factorization) is built once and shared by all right-hand sides.
+  @param[in]   dzeta     Perturbations of the design variable
+  @param[out]  du        Corresponding perturbations of the state variable
+*/
+void IP_SSAHardavForwardProblem::apply_linearization(std::vector<IceModelVec2S*> &dzeta,
+                                                     std::vector<IceModelVec2V*> &du) {
+  if (dzeta.size() != du.size()) {
+    throw RuntimeError::formatted("IP_SSAHardavForwardProblem::apply_linearization: got %d design"
+                                  " and %d state vectors",
+                                  (int)dzeta.size(), (int)du.size());
+  }
+
+  // J_state is set up here; setup_linearization_solver() is a no-op in the calls below.
+  this->setup_linearization_solver();
+
+  for (unsigned int k = 0; k < dzeta.size(); ++k) {
+    this->apply_linearization(*dzeta[k], *du[k]);
+  }
+}
+
+//! Applies the transpose of the linearization of the forward map to several perturbations of the state variable.
+/*! Equivalent to calling apply_linearization_transpose(IceModelVec2V&, IceModelVec2S&) for
+  each pair `(*du[k], *dzeta[k])`, sharing the setup of \f$J_{\rm State}\f$ as in
+  apply_linearization(std::vector<IceModelVec2S*>&, std::vector<IceModelVec2V*>&).
+  @param[in]   du        Perturbations of the state variable
+  @param[out]  dzeta     Corresponding perturbations of the design variable
+*/
+void IP_SSAHardavForwardProblem::apply_linearization_transpose(std::vector<IceModelVec2V*> &du,
+                                                               std::vector<IceModelVec2S*> &dzeta) {
+  if (dzeta.size() != du.size()) {
+    throw RuntimeError::formatted("IP_SSAHardavForwardProblem::apply_linearization_transpose: got %d state"
+                                  " and %d design vectors",
+                                  (int)du.size(), (int)dzeta.size());
+  }
+
+  // J_state is set up here; setup_linearization_solver() is a no-op in the calls below.
+  this->setup_linearization_solver();
+
+  for (unsigned int k = 0; k < du.size(); ++k) {
+    this->apply_linearization_transpose(*du[k], *dzeta[k]);
+  }
+}
+
 } // end of namespace inverse
 } // end of namespace pism
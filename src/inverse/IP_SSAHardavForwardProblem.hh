@@ -19,6 +19,8 @@
 #ifndef IP_SSAHARDAVFORWARDPROBLEM_HH_HAD68BK7
 #define IP_SSAHARDAVFORWARDPROBLEM_HH_HAD68BK7
 
+#include <vector>
+
 #include "base/stressbalance/ssa/SSAFEM.hh"
 #include "IPDesignVariableParameterization.hh"
 #include "base/util/petscwrappers/KSP.hh"
@@ -160,6 +162,13 @@ public:
   virtual void apply_linearization(IceModelVec2S &dzeta, IceModelVec2V &du);
   virtual void apply_linearization_transpose(IceModelVec2V &du, IceModelVec2S &dzeta);
 
+  void apply_linearization(std::vector<IceModelVec2S*> &dzeta,
+                           std::vector<IceModelVec2V*> &du);
+  void apply_linearization_transpose(std::vector<IceModelVec2V*> &du,
+                                     std::vector<IceModelVec2S*> &dzeta);
+
+  unsigned int linearization_ksp_iterations() const;
+
   //! Exposes the DMDA of the underlying grid for the benefit of TAO.
   virtual void get_da(DM *da) {
     *da = *m_da;
@@ -169,6 +178,9 @@ protected:
 
   void construct();
 
+  void setup_linearization_solver();
+  void solve_linearization();
+
   IceModelVec2S   *m_zeta;                   ///< Current value of zeta, provided from caller.
   IceModelVec2S   m_dzeta_local;             ///< Storage for d_zeta with ghosts, if needed when an argument d_zeta is ghost-less.
 
@@ -192,6 +204,7 @@ protected:
   SNESConvergedReason m_reason;
 
   bool m_rebuild_J_state;                    ///< Flag indicating that the state jacobian matrix needs rebuilding.
+  unsigned int m_linearization_ksp_iterations; ///< KSP iterations used by linearization solves.
 };
 
 } // end of namespace inverse
@@ -19,6 +19,8 @@
 #ifndef IP_SSATAUCFORWARDPROBLEM_HH_4AEVR4Z
 #define IP_SSATAUCFORWARDPROBLEM_HH_4AEVR4Z
 
+#include <vector>
+
 #include "base/stressbalance/ssa/SSAFEM.hh"
 #include "IPDesignVariableParameterization.hh"
 #include "base/util/petscwrappers/KSP.hh"
@@ -162,6 +164,13 @@ public:
   virtual void apply_linearization(IceModelVec2S &dzeta, IceModelVec2V &du);
   virtual void apply_linearization_transpose(IceModelVec2V &du, IceModelVec2S &dzeta);
 
+  void apply_linearization(std::vector<IceModelVec2S*> &dzeta,
+                           std::vector<IceModelVec2V*> &du);
+  void apply_linearization_transpose(std::vector<IceModelVec2V*> &du,
+                                     std::vector<IceModelVec2S*> &dzeta);
+
+  unsigned int linearization_ksp_iterations() const;
+
   //! Exposes the DMDA of the underlying grid for the benefit of TAO.
   virtual void get_da(DM *da) {
     *da = *m_da;
@@ -171,6 +180,9 @@ protected:
 
   void construct();
 
+  void setup_linearization_solver();
+  void solve_linearization();
+
   /// Current value of zeta, provided from caller.
   IceModelVec2S   *m_zeta;
   /// Storage for d_zeta with ghosts, if needed when an argument d_zeta is ghost-less.
@@ -206,6 +218,9 @@ protected:
 
   /// Flag indicating that the state jacobian matrix needs rebuilding.
   bool m_rebuild_J_state;
+
+  //! Number of KSP iterations used by solves involving the linearization.
+  unsigned int m_linearization_ksp_iterations;
 };
 
 } // end of namespace inverse
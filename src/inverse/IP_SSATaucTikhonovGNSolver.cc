@@ -23,6 +23,7 @@
 #include "base/util/pism_options.hh"
 #include "base/util/PISMConfigInterface.hh"
 #include "base/util/IceGrid.hh"
+#include "base/util/pism_const.hh"
 
 namespace pism {
 namespace inverse {
@@ -380,6 +381,9 @@ TerminationReason::Ptr IP_SSATaucTikhonovGNSolver::solve() {
       m_alpha = exp(m_logalpha);
     }
 
+    const double step_start = GetTime();
+    const unsigned int state_iterations_start = m_ssaforward.linearization_ksp_iterations();
+
     step_reason = this->solve_linearized();
     if (step_reason->failed()) {
       reason.reset(new GenericTerminationReason(-1,"Gauss Newton solve"));
@@ -387,6 +391,10 @@ TerminationReason::Ptr IP_SSATaucTikhonovGNSolver::solve() {
       return reason;
     }
 
+    PetscInt cg_iterations = 0;
+    PetscErrorCode ierr = KSPGetIterationNumber(m_ksp, &cg_iterations);
+    PISM_CHK(ierr, "KSPGetIterationNumber");
+
     step_reason = this->linesearch();
     if (step_reason->failed()) {
       TerminationReason::Ptr cause = reason;
@@ -405,6 +413,12 @@ TerminationReason::Ptr IP_SSATaucTikhonovGNSolver::solve() {
       }
     }
 
+    verbPrintf(2, PETSC_COMM_WORLD,
+               "GN step %d: %d CG iterations, %d linearized SSA iterations, %.2f seconds\n",
+               m_iter, (int)cg_iterations,
+               (int)(m_ssaforward.linearization_ksp_iterations() - state_iterations_start),
+               GetTime() - step_start);
+
     m_iter++;
   }
 
@@ -0,0 +1,74 @@
+// Copyright (C) 2015 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Converts a binary checkpoint written using '-backup_format binary' to NetCDF.\n";
+
+#include <petscsys.h>
+
+#include "base/util/pism_const.hh"
+#include "base/util/pism_options.hh"
+#include "base/util/Context.hh"
+#include "base/util/io/checkpoint.hh"
+#include "base/util/petscwrappers/PetscInitializer.hh"
+#include "base/util/error_handling.hh"
+
+using namespace pism;
+
+int main(int argc, char *argv[]) {
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  com = PETSC_COMM_WORLD;
+
+  try {
+    verbosityLevelFromOptions();
+
+    std::string usage =
+      "  pism_checkpoint2nc -checkpoint PREFIX -o OUT.nc\n"
+      "where:\n"
+      "  -checkpoint  PREFIX is the checkpoint prefix (PREFIX.manifest must exist)\n"
+      "  -o           OUT.nc is the output file name\n"
+      "notes:\n"
+      "  * the output file uses the NetCDF-3 format (the format of PREFIX-state.nc)\n"
+      "  * the number of MPI processes does not have to match the one used to write\n"
+      "    the checkpoint\n";
+
+    std::vector<std::string> required;
+    required.push_back("-checkpoint");
+    required.push_back("-o");
+
+    bool done = show_usage_check_req_opts(com, "pism_checkpoint2nc", required, usage);
+    if (done) {
+      return 0;
+    }
+
+    Context::Ptr ctx = context_from_options(com, "pism_checkpoint2nc");
+
+    options::String prefix("-checkpoint", "Binary checkpoint prefix");
+    options::String output("-o", "Output file name");
+
+    io::checkpoint_to_netcdf(ctx, prefix, output);
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+  }
+
+  return 0;
+}
@@ -0,0 +1,302 @@
+// Copyright (C) 2015 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "Ensemble driver: runs several PISM evolution runs (members) in one MPI job.\n"
+  "Each member uses its own sub-communicator and member-specific options.\n"
+  "Members running on the same node share the Lingle-Clark load response matrix\n"
+  "(see SharedArrays); other inputs are read by each member.\n";
+
+#include <petscsys.h>
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "base/util/IceGrid.hh"
+#include "base/iceModel.hh"
+#include "base/util/PISMConfig.hh"
+#include "base/util/PISMTime.hh"
+
+#include "base/util/pism_options.hh"
+#include "base/util/petscwrappers/PetscInitializer.hh"
+#include "base/util/error_handling.hh"
+#include "base/util/Context.hh"
+#include "base/util/SharedArrays.hh"
+
+using namespace pism;
+
+//! Returns options of the member `member` read from `filename` (one line per member).
+/*!
+ * Empty lines and lines starting with '#' are ignored.
+ */
+static std::string member_options(const std::string &filename, unsigned int member) {
+  std::ifstream input(filename.c_str());
+  if (not input.good()) {
+    throw RuntimeError::formatted("failed to open '%s'", filename.c_str());
+  }
+
+  unsigned int counter = 0;
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() or line[0] == '#') {
+      continue;
+    }
+
+    if (counter == member) {
+      return line;
+    }
+    counter += 1;
+  }
+
+  throw RuntimeError::formatted("'%s' contains options for %d members, but member %d was requested",
+                                filename.c_str(), counter, member);
+}
+
+//! Adds a member-specific suffix to names of output files set using command-line options.
+static void set_member_output_names(const std::string &suffix) {
+  const char* file_options[] = {"-o", "-extra_file", "-ts_file", "-save_file", NULL};
+
+  for (unsigned int k = 0; file_options[k] != NULL; ++k) {
+    options::String filename(file_options[k], "Output file name");
+
+    if (filename.is_set()) {
+      std::string name = pism_filename_add_suffix(filename, "_member", suffix);
+
+#if PETSC_VERSION_LT(3,7,0)
+      PetscErrorCode ierr = PetscOptionsSetValue(file_options[k], name.c_str());
+      PISM_CHK(ierr, "PetscOptionsSetValue");
+#else
+      PetscErrorCode ierr = PetscOptionsSetValue(NULL, file_options[k], name.c_str());
+      PISM_CHK(ierr, "PetscOptionsSetValue");
+#endif
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  PetscErrorCode ierr;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+
+  com = PETSC_COMM_WORLD;
+
+  try {
+    verbosityLevelFromOptions();
+
+    verbPrintf(2, com, "PISM_ENSEMBLE %s (ensemble of evolution runs)\n",
+               PISM_Revision);
+
+    std::string usage =
+      "  pism_ensemble -ensemble_size N [-ensemble_options FILE] [OTHER PISM & PETSc OPTIONS]\n"
+      "where:\n"
+      "  -ensemble_size     N is the number of ensemble members\n"
+      "  -ensemble_options  FILE contains options of member k on line k (counting from 0)\n"
+      "notes:\n"
+      "  * the number of MPI processes has to be divisible by N\n"
+      "  * names of output files (-o, -extra_file, -ts_file, -save_file) get the suffix _memberK\n"
+      "  * options in FILE override options common to all members\n"
+      "  * members on the same node that use the Lingle-Clark model on the same grid\n"
+      "    compute its elastic load response matrix together and store one copy\n";
+
+    std::vector<std::string> required;
+    required.push_back("-ensemble_size");
+
+    bool done = show_usage_check_req_opts(com, "pism_ensemble", required, usage);
+    if (done) {
+      return 0;
+    }
+
+    int size = 0, rank = 0;
+    MPI_Comm_size(com, &size);
+    MPI_Comm_rank(com, &rank);
+
+    options::Integer N("-ensemble_size", "Number of ensemble members", 1);
+    options::String options_file("-ensemble_options",
+                                 "Name of the file containing member-specific options");
+
+    if (N < 1 or size % N != 0) {
+      throw RuntimeError::formatted("the number of MPI processes (%d) has to be divisible"
+                                    " by the number of ensemble members (%d)",
+                                    size, (int)N);
+    }
+
+    const int
+      member_size = size / N,
+      member      = rank / member_size;
+
+    // Options are stored separately by each process, so member-specific
+    // options set here affect this member only.
+    if (options_file.is_set()) {
+      std::string member_opts = member_options(options_file, member);
+
+#if PETSC_VERSION_LT(3,7,0)
+      ierr = PetscOptionsInsertString(member_opts.c_str());
+      PISM_CHK(ierr, "PetscOptionsInsertString");
+#else
+      ierr = PetscOptionsInsertString(NULL, member_opts.c_str());
+      PISM_CHK(ierr, "PetscOptionsInsertString");
+#endif
+    }
+
+    char suffix[TEMPORARY_STRING_LENGTH];
+    snprintf(suffix, TEMPORARY_STRING_LENGTH, "%03d", member);
+    set_member_output_names(suffix);
+
+    MPI_Comm member_com;
+    MPI_Comm_split(com, member, rank, &member_com);
+
+    int member_rank = 0;
+    MPI_Comm_rank(member_com, &member_rank);
+
+    // Rank 0 of each member computes the bed deformation (see
+    // PBLingleClark), so these processes share read-only data.
+    MPI_Comm roots_com = MPI_COMM_NULL;
+    MPI_Comm_split(com, member_rank == 0 ? 0 : MPI_UNDEFINED, rank, &roots_com);
+
+    // model years and wall-clock hours of this member; negative if failed
+    double stats[2] = {-1.0, -1.0};
+
+    {
+      Context::Ptr ctx;
+      PISM_SHARED_PTR(IceModel) m;
+      int initialized = 0;
+
+      try {
+        ctx = context_from_options(member_com, "pism_ensemble");
+
+        // defer computing shared arrays until all members are initialized
+        ctx->shared_arrays().enable_sharing();
+
+        ctx->log()->message(3, "* Setting the computational grid...\n");
+        IceGrid::Ptr g = IceGrid::FromOptions(ctx);
+
+        m.reset(new IceModel(g, ctx));
+
+        m->init();
+
+        initialized = 1;
+      }
+      catch (...) {
+        handle_fatal_errors(member_com);
+      }
+
+      // This is collective on roots_com, so it has to be called by all
+      // members, including ones that failed to initialize.
+      if (roots_com != MPI_COMM_NULL) {
+        try {
+          if (initialized) {
+            ctx->shared_arrays().fulfill(roots_com);
+          } else {
+            SharedArrays none;
+            none.fulfill(roots_com);
+          }
+        }
+        catch (...) {
+          initialized = 0;
+          handle_fatal_errors(MPI_COMM_SELF);
+        }
+      }
+
+      // all processes of a member have to agree
+      int member_initialized = 0;
+      MPI_Allreduce(&initialized, &member_initialized, 1, MPI_INT, MPI_MIN, member_com);
+
+      if (member_initialized) {
+        try {
+          const double
+            wall_clock_start = GetTime(),
+            model_start      = ctx->time()->current();
+
+          m->run();
+
+          stats[0] = units::convert(ctx->unit_system(),
+                                    ctx->time()->current() - model_start, "seconds", "years");
+          stats[1] = (GetTime() - wall_clock_start) / 3600.0;
+
+          verbPrintf(2, member_com, "... done with run (ensemble member %d)\n", member);
+          m->writeFiles(pism_filename_add_suffix("unnamed.nc", "_member", suffix));
+
+          print_unused_parameters(*ctx->log(), 3, *ctx->config());
+        }
+        catch (...) {
+          handle_fatal_errors(member_com);
+        }
+      }
+
+      // Free shared memory windows. This is collective on groups of
+      // processes in roots_com, so (like fulfill() above) it is called by
+      // all of them, whether or not their member ran successfully. The
+      // model uses shared arrays, so it has to be destroyed first.
+      m.reset();
+      if (roots_com != MPI_COMM_NULL and ctx) {
+        ctx->shared_arrays().release();
+      }
+    }
+
+    if (roots_com != MPI_COMM_NULL) {
+      MPI_Comm_free(&roots_com);
+    }
+    MPI_Comm_free(&member_com);
+
+    // Collect and report per-member and aggregate throughput.
+    std::vector<double> all_stats(2 * size);
+    MPI_Gather(stats, 2, MPI_DOUBLE, &all_stats[0], 2, MPI_DOUBLE, 0, com);
+
+    if (rank == 0) {
+      double total_years = 0.0, max_hours = 0.0;
+      int n_failed = 0;
+
+      verbPrintf(1, MPI_COMM_SELF,
+                 "\nEnsemble summary (%d members, %d processes each):\n"
+                 "  member  model years  wall-clock hours  model years/hour\n",
+                 (int)N, member_size);
+
+      for (int k = 0; k < N; ++k) {
+        const double
+          years = all_stats[2 * k * member_size + 0],
+          hours = all_stats[2 * k * member_size + 1];
+
+        if (hours < 0.0) {
+          verbPrintf(1, MPI_COMM_SELF, "  %6d  FAILED\n", k);
+          n_failed += 1;
+          continue;
+        }
+
+        verbPrintf(1, MPI_COMM_SELF, "  %6d  %11.3f  %16.4f  %16.3f\n",
+                   k, years, hours, hours > 0.0 ? years / hours : 0.0);
+
+        total_years += years;
+        max_hours = std::max(max_hours, hours);
+      }
+
+      verbPrintf(1, MPI_COMM_SELF, "  aggregate: %.3f model years in %.4f hours (%.3f model years/hour)",
+                 total_years, max_hours, max_hours > 0.0 ? total_years / max_hours : 0.0);
+      if (n_failed > 0) {
+        verbPrintf(1, MPI_COMM_SELF, ", %d member(s) failed", n_failed);
+      }
+      verbPrintf(1, MPI_COMM_SELF, "\n");
+    }
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+  }
+
+  return 0;
+}
@@ -31,7 +31,7 @@ static char help[] =
 using pism::io::NC4_Serial;
 
 int process_one_variable(std::string var_name, std::string input_file, std::string output_file,
-                         unsigned int compression_level) {
+                         unsigned int compression_level, MPI_Comm com) {
   NC4_Serial input(MPI_COMM_SELF, 0),
     output(MPI_COMM_SELF, compression_level);
   bool exists;
@@ -93,7 +93,7 @@ int process_one_variable(std::string var_name, std::string input_file, std::stri
 
   input.close();
 
-  copy_all_variables(input_file, output);
+  copy_all_variables(input_file, output, com);
 
   output.close();
 
@@ -103,7 +103,7 @@ int process_one_variable(std::string var_name, std::string input_file, std::stri
 }
 
 int process_all_variables(std::string input_file, std::string output_file,
-                          unsigned int compression_level) {
+                          unsigned int compression_level, MPI_Comm com) {
   NC4_Serial input(MPI_COMM_SELF, 0),
     output(MPI_COMM_SELF, compression_level);
 
@@ -135,7 +135,7 @@ int process_all_variables(std::string input_file, std::string output_file,
     define_variable(input, output, var_name);
   }
 
-  copy_all_variables(input_file, output);
+  copy_all_variables(input_file, output, com);
 
   output.close();
 
@@ -178,7 +178,8 @@ int main(int argc, char *argv[]) {
       "  -v var_name name of the variable to merge\n"
       "  -L <number> output compression level (from 0 to 9)\n"
       "notes:\n"
-      "  * -o is optional\n";
+      "  * -o is optional\n"
+      "  * when run on N > 1 processes, rank 0 writes and ranks 1..N-1 read patches\n";
 
     std::vector<std::string> required;
     required.push_back("-i");
@@ -208,16 +209,27 @@ int main(int argc, char *argv[]) {
       }
     }
 
+    // Rank 0 writes the output file; all other ranks (if any) read
+    // patches and send them to rank 0.
     if (rank == 0) {
       if (var_name.is_set()) {
-        process_one_variable(var_name, input_file, o_name, compression_level);
+        process_one_variable(var_name, input_file, o_name, compression_level, com);
       } else {
-        process_all_variables(input_file, o_name, compression_level);
+        process_all_variables(input_file, o_name, compression_level, com);
       }
+    } else {
+      read_patches(input_file, com);
     }
   }
   catch (...) {
     handle_fatal_errors(com);
+
+    // other ranks may be waiting for messages from this one
+    int size = 1;
+    MPI_Comm_size(com, &size);
+    if (size > 1) {
+      MPI_Abort(com, 1);
+    }
   }
 
 
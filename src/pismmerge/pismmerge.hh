@@ -49,7 +49,9 @@ void copy_coordinate_variable(const pism::io::NC4_Serial &input, const std::stri
                               const pism::io::NC4_Serial &output);
 void copy_spatial_variable(const std::string &filename, const std::string &var_name,
                            const pism::io::NC4_Serial &output);
-void copy_all_variables(const std::string &filename, const pism::io::NC4_Serial &output);
+void copy_all_variables(const std::string &filename, const pism::io::NC4_Serial &output,
+                        MPI_Comm com);
+void read_patches(const std::string &filename, MPI_Comm com);
 
 // util.cc
 std::string patch_filename(const std::string &input, int mpi_rank);
@@ -69,6 +69,78 @@ void copy_coordinate_variable(const NC4_Serial &input,
   }
 }
 
+//! \brief Computes start and count arrays used to copy one time record of a patch.
+/*!
+ * `dim_lengths` has to contain lengths of all dimensions except for x and y.
+ *
+ * Returns the number of time records in `n_records` and the index of the time
+ * dimension in `time_idx` (-1 if the variable does not depend on time).
+ */
+static void patch_start_and_count(const std::vector<std::string> &dims,
+                                  std::map<std::string, int> &dim_lengths,
+                                  int xs, int ys, unsigned int xm, unsigned int ym,
+                                  std::vector<unsigned int> &in_start,
+                                  std::vector<unsigned int> &out_start,
+                                  std::vector<unsigned int> &count,
+                                  int &time_idx, int &n_records) {
+  n_records = dim_lengths["time"] > 0 ? dim_lengths["time"] : 1;
+
+  in_start.clear();
+  count.clear();
+  out_start.clear();
+  time_idx = -1;
+  for (unsigned int d = 0; d < dims.size(); ++d) {
+    // start
+    if (dims[d] == "time") {
+      time_idx = d;
+      in_start.push_back(0);
+      out_start.push_back(0);
+    } else if (dims[d] == "x") {
+      in_start.push_back(0);
+      out_start.push_back(xs);
+    } else if (dims[d] == "y") {
+      in_start.push_back(0);
+      out_start.push_back(ys);
+    } else {
+      in_start.push_back(0);
+      out_start.push_back(0);
+    }
+
+    // count
+    if (dims[d] == "time") {
+      count.push_back(1);
+    } else if (dims[d] == "x") {
+      count.push_back(xm);
+    } else if (dims[d] == "y") {
+      count.push_back(ym);
+    } else {
+      count.push_back(dim_lengths[dims[d]]);
+    }
+  }
+}
+
+//! Returns the number of values in a hyperslab with dimensions `count`.
+static size_t buffer_size(const std::vector<unsigned int> &count) {
+  size_t result = 1;
+  for (unsigned int k = 0; k < count.size(); ++k) {
+    result *= count[k];
+  }
+  return result;
+}
+
+//! Reads lengths of dimensions of `var_name` from `file`.
+static void get_dim_lengths(const NC4_Serial &file, const std::string &var_name,
+                            std::vector<std::string> &dims,
+                            std::map<std::string, int> &dim_lengths) {
+  file.inq_vardimid(var_name, dims);
+
+  for (unsigned int d = 0; d < dims.size(); ++d) {
+    unsigned int tmp;
+    file.inq_dimlen(dims[d], tmp);
+    dim_lengths[dims[d]] = tmp;
+  }
+}
+
 //! \brief Copies 2D and 3D variables.
 /*!
  * This is where most of the time is spent.
@@ -79,10 +151,8 @@ void copy_coordinate_variable(const NC4_Serial &input,
  * variables in the first file, then all variables in the second file, etc, but
  * it is not clear it this access pattern of the output file is better or not.
  *
- * Note that patches may have different sizes. This code allocates and frees
- * the buffer each time it goes to the next patch. It might be better to compute the
- * maximum buffer size and allocate once, although it is also not clear if this
- * would give any performance benefit.
+ * The buffer is re-used for all patches and time records, so the memory use
+ * is bounded by the size of one time record of the largest patch.
  */
 void copy_spatial_variable(const std::string &filename,
                            const std::string &var_name,
@@ -91,105 +161,180 @@ void copy_spatial_variable(const std::string &filename,
   NC4_Serial input(MPI_COMM_SELF, 0);
   std::vector<std::string> dims;
   std::vector<unsigned int> in_start, out_start, count;
+  std::vector<double> data;
 
-  output.inq_vardimid(var_name, dims);
-
-  for (unsigned int d = 0; d < dims.size(); ++d) {
-    unsigned int tmp;
-    output.inq_dimlen(dims[d], tmp);
-    dim_lengths[dims[d]] = tmp;
-  }
+  get_dim_lengths(output, var_name, dims, dim_lengths);
 
   input.open(patch_filename(filename, 0), pism::PISM_READONLY);
   int mpi_size = get_quilt_size(input);
   input.close();
 
   for (int r = 0; r < mpi_size; ++r) { // for each patch...
-    int xs, ys;
+    int xs, ys, time_idx, n_records;
     unsigned int xm, ym;
 
     input.open(patch_filename(filename, r), pism::PISM_READONLY);
 
     patch_geometry(input, xs, ys, xm, ym);
 
-    int max_time_start = dim_lengths["time"] > 0 ? dim_lengths["time"] : 1;
-
-    in_start.clear();
-    count.clear();
-    out_start.clear();
-    // prepare start and count
-    int time_idx = -1;
-    for (unsigned int d = 0; d < dims.size(); ++d) {
-      // start
-      if (dims[d] == "time") {
-        time_idx = d;
-        in_start.push_back(0);
-        out_start.push_back(0);
-      } else if (dims[d] == "x") {
-        in_start.push_back(0);
-        out_start.push_back(xs);
-      } else if (dims[d] == "y") {
-        in_start.push_back(0);
-        out_start.push_back(ys);
-      } else {
-        in_start.push_back(0);
-        out_start.push_back(0);
-      }
+    patch_start_and_count(dims, dim_lengths, xs, ys, xm, ym,
+                          in_start, out_start, count, time_idx, n_records);
+
+    data.resize(buffer_size(count));
+
+    // for each time record...
+    for (int time_start = 0; time_start < n_records; ++time_start) {
 
-      // count
-      if (dims[d] == "time") {
-        count.push_back(1);
-      } else if (dims[d] == "x") {
-        count.push_back(xm);
-      } else if (dims[d] == "y") {
-        count.push_back(ym);
-      } else {
-        count.push_back(dim_lengths[dims[d]]);
+      if (time_idx >= 0) {
+        in_start[time_idx] = time_start;
+        out_start[time_idx] = time_start;
       }
-    }
 
-    // allocate a buffer...
-    unsigned long long int buffer_size = 1;
-    for (unsigned int k = 0; k < count.size(); ++k) {
-      buffer_size *= count[k];
-    }
+      input.get_vara_double(var_name, in_start, count, &data[0]);
 
-    double *data = (double*)malloc(sizeof(double) * buffer_size);
-    if (data == NULL) {
-      throw std::runtime_error("memory allocation failed while processing variable " +
-                               var_name);
+      output.put_vara_double(var_name, out_start, count, &data[0]);
     }
 
-    // for each time record...
-    for (int time_start = 0; time_start < max_time_start; ++time_start) {
+    input.close();
+  } // end of "for each patch..."
+}
+
+static const int geometry_tag = 1, data_tag = 2;
+
+//! Returns the rank of the process reading the patch `patch` when `size` processes are used.
+static int reader_rank(int patch, int size) {
+  return 1 + patch % (size - 1);
+}
+
+//! \brief Receives patches of a 2D or 3D variable from readers and writes them to `output`.
+/*!
+ * Patches are received in order, one time record at a time, so while rank 0
+ * compresses and writes one patch other ranks are reading (and
+ * uncompressing) the following ones.
+ */
+static void receive_spatial_variable(const std::string &var_name,
+                                     const NC4_Serial &output,
+                                     int n_patches, MPI_Comm com) {
+  std::map<std::string, int> dim_lengths;
+  std::vector<std::string> dims;
+  std::vector<unsigned int> in_start, out_start, count;
+  std::vector<double> data;
+  int size;
+  MPI_Status status;
+
+  MPI_Comm_size(com, &size);
+
+  get_dim_lengths(output, var_name, dims, dim_lengths);
+
+  for (int r = 0; r < n_patches; ++r) {
+    const int source = reader_rank(r, size);
+    int geometry[4], time_idx, n_records;
+
+    MPI_Recv(geometry, 4, MPI_INT, source, geometry_tag, com, &status);
+
+    patch_start_and_count(dims, dim_lengths, geometry[0], geometry[1], geometry[2], geometry[3],
+                          in_start, out_start, count, time_idx, n_records);
 
+    data.resize(buffer_size(count));
+
+    for (int time_start = 0; time_start < n_records; ++time_start) {
       if (time_idx >= 0) {
-        in_start[time_idx] = time_start;
         out_start[time_idx] = time_start;
       }
 
-      input.get_vara_double(var_name, in_start, count, data);
+      MPI_Recv(&data[0], data.size(), MPI_DOUBLE, source, data_tag, com, &status);
 
-      output.put_vara_double(var_name, out_start, count, data);
+      output.put_vara_double(var_name, out_start, count, &data[0]);
     }
+  }
+}
+
+//! \brief Reads patches of a 2D or 3D variable owned by this rank and sends them to rank 0.
+static void send_spatial_variable(const std::string &filename,
+                                  const std::string &var_name,
+                                  int n_patches, MPI_Comm com) {
+  std::map<std::string, int> dim_lengths;
+  NC4_Serial input(MPI_COMM_SELF, 0);
+  std::vector<std::string> dims;
+  std::vector<unsigned int> in_start, out_start, count;
+  std::vector<double> data;
+  int size, rank;
+
+  MPI_Comm_size(com, &size);
+  MPI_Comm_rank(com, &rank);
+
+  for (int r = rank - 1; r < n_patches; r += size - 1) {
+    int xs, ys, time_idx, n_records;
+    unsigned int xm, ym;
+
+    input.open(patch_filename(filename, r), pism::PISM_READONLY);
+
+    patch_geometry(input, xs, ys, xm, ym);
+
+    get_dim_lengths(input, var_name, dims, dim_lengths);
+
+    patch_start_and_count(dims, dim_lengths, xs, ys, xm, ym,
+                          in_start, out_start, count, time_idx, n_records);
+
+    int geometry[4] = {xs, ys, (int)xm, (int)ym};
+    MPI_Send(geometry, 4, MPI_INT, 0, geometry_tag, com);
+
+    data.resize(buffer_size(count));
 
-    free(data);
+    for (int time_start = 0; time_start < n_records; ++time_start) {
+      if (time_idx >= 0) {
+        in_start[time_idx] = time_start;
+      }
+
+      input.get_vara_double(var_name, in_start, count, &data[0]);
+
+      MPI_Send(&data[0], data.size(), MPI_DOUBLE, 0, data_tag, com);
+    }
 
     input.close();
-  } // end of "for each patch..."
+  }
+}
+
+//! Broadcasts a list of names from rank 0.
+static void broadcast_names(std::vector<std::string> &names, MPI_Comm com) {
+  int rank, n = names.size();
+  MPI_Comm_rank(com, &rank);
+
+  MPI_Bcast(&n, 1, MPI_INT, 0, com);
+  names.resize(n);
+
+  for (int k = 0; k < n; ++k) {
+    int length = names[k].size();
+    MPI_Bcast(&length, 1, MPI_INT, 0, com);
+
+    std::vector<char> buffer(names[k].begin(), names[k].end());
+    buffer.resize(length + 1, '\0');
+    MPI_Bcast(&buffer[0], length, MPI_CHAR, 0, com);
+
+    if (rank != 0) {
+      names[k] = std::string(&buffer[0], length);
+    }
+  }
 }
 
 //! \brief Copies all variables.
 /*!
  * Loops over variables present in an output file. This allows us to process
  * both cases ("-v foo" and without "-v").
+ *
+ * If `com` has more than one process, rank 0 writes and all other ranks read
+ * patches (see read_patches()).
  */
-void copy_all_variables(const std::string &filename, const NC4_Serial &output) {
-  int n_vars;
+void copy_all_variables(const std::string &filename, const NC4_Serial &output,
+                        MPI_Comm com) {
+  int n_vars, size;
   NC4_Serial input(MPI_COMM_SELF, 0);
   std::vector<std::string> dimensions, spatial_vars;
 
+  MPI_Comm_size(com, &size);
+
   input.open(patch_filename(filename, 0), pism::PISM_READONLY);
+  int n_patches = get_quilt_size(input);
 
   output.inq_nvars(n_vars);
 
@@ -209,10 +354,38 @@ void copy_all_variables(const std::string &filename, const NC4_Serial &output) {
 
   input.close();
 
+  if (size > 1) {
+    broadcast_names(spatial_vars, com);
+  }
+
   for (unsigned int k = 0; k < spatial_vars.size(); ++k) {
     // 2D or 3D variables
     fprintf(stderr, "Copying %s... ", spatial_vars[k].c_str());
-    copy_spatial_variable(filename, spatial_vars[k], output);
+    if (size > 1) {
+      receive_spatial_variable(spatial_vars[k], output, n_patches, com);
+    } else {
+      copy_spatial_variable(filename, spatial_vars[k], output);
+    }
     fprintf(stderr, "done.\n");
   }
 }
+
+//! \brief Reads patches and sends them to rank 0 (see copy_all_variables()).
+/*!
+ * Called on ranks other than 0. Patches are distributed among readers in a
+ * round-robin fashion.
+ */
+void read_patches(const std::string &filename, MPI_Comm com) {
+  NC4_Serial input(MPI_COMM_SELF, 0);
+  std::vector<std::string> spatial_vars;
+
+  input.open(patch_filename(filename, 0), pism::PISM_READONLY);
+  int n_patches = get_quilt_size(input);
+  input.close();
+
+  broadcast_names(spatial_vars, com);
+
+  for (unsigned int k = 0; k < spatial_vars.size(); ++k) {
+    send_spatial_variable(filename, spatial_vars[k], n_patches, com);
+  }
+}
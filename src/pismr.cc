@@ -30,6 +30,7 @@ static char help[] =
 #include "base/util/petscwrappers/PetscInitializer.hh"
 #include "base/util/error_handling.hh"
 #include "base/util/Context.hh"
+#include "base/util/io/checkpoint.hh"
 
 using namespace pism;
 
@@ -51,14 +52,15 @@ int main(int argc, char *argv[]) {
       return 0;
     }
 
-    bool input_file_set = options::Bool("-i", "input file name");
+    bool input_file_set = (options::Bool("-i", "input file name") or
+                           options::Bool("-checkpoint", "binary checkpoint prefix"));
     std::string usage =
       "  pismr -i IN.nc [-bootstrap] [OTHER PISM & PETSc OPTIONS]\n"
       "where:\n"
       "  -i          IN.nc is input file in NetCDF format: contains PISM-written model state\n"
       "  -bootstrap  enable heuristics to produce an initial state from an incomplete input\n"
       "notes:\n"
-      "  * option -i is required\n"
+      "  * option -i is required (or -checkpoint PREFIX to restart from a binary checkpoint)\n"
       "  * if -bootstrap is used then also '-Mx A -My B -Mz C -Lz D' are required\n";
     if (not input_file_set) {
       ierr = PetscPrintf(com, "\nPISM ERROR: option -i is required\n\n");
@@ -75,6 +77,9 @@ int main(int argc, char *argv[]) {
       }
     }
 
+    // -checkpoint replaces -i; this has to go before the Context is created
+    io::checkpoint_input_from_options();
+
     Context::Ptr ctx = context_from_options(com, "pismr");
     Config::Ptr config = ctx->config();
 
@@ -53,6 +53,10 @@
 %include "inverse/functional/IPLogRatioFunctional.hh"
 %include "inverse/functional/IPLogRelativeFunctional.hh"
 %include "inverse/IPDesignVariableParameterization.hh"
+/* Used by the multiple-right-hand-side versions of apply_linearization() and
+   apply_linearization_transpose(). */
+%template(IceModelVec2SPtrVector) std::vector<pism::IceModelVec2S*>;
+%template(IceModelVec2VPtrVector) std::vector<pism::IceModelVec2V*>;
 %include "inverse/IP_SSATaucForwardProblem.hh"
 %include "inverse/IP_SSATaucTikhonovGNSolver.hh"
 
@@ -39,6 +39,7 @@ static char help[] =
 #include "regional.hh"
 #include "base/util/PISMVars.hh"
 #include "base/util/Context.hh"
+#include "base/util/io/checkpoint.hh"
 
 namespace pism {
 
@@ -440,7 +441,8 @@ int main(int argc, char *argv[]) {
       return 0;
     }
 
-    bool input_file_set = options::Bool("-i", "input file name");
+    bool input_file_set = (options::Bool("-i", "input file name") or
+                           options::Bool("-checkpoint", "binary checkpoint prefix"));
     std::string usage =
       "  pismo -i IN.nc [-bootstrap] [-no_model_strip X] [OTHER PISM & PETSc OPTIONS]\n"
       "where:\n"
@@ -449,7 +451,7 @@ int main(int argc, char *argv[]) {
       "  -no_model_strip X (re-)set width of no-model strip along edge of\n"
       "              computational domain to X km\n"
       "notes:\n"
-      "  * option -i is required\n"
+      "  * option -i is required (or -checkpoint PREFIX to restart from a binary checkpoint)\n"
       "  * if -bootstrap is used then also '-Mx A -My B -Mz C -Lz D' are required\n";
     if (not input_file_set) {
       ierr = PetscPrintf(com,
@@ -467,6 +469,9 @@ int main(int argc, char *argv[]) {
       }
     }
 
+    // -checkpoint replaces -i; this has to go before the Context is created
+    io::checkpoint_input_from_options();
+
     Context::Ptr ctx = context_from_options(com, "pismo");
     Config::Ptr config = ctx->config();
 
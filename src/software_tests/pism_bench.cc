@@ -0,0 +1,766 @@
+// Copyright (C) 2015 PISM Authors
+//
+// This file is part of PISM.
+//
+// PISM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// PISM is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+// details.
+//
+// You should have received a copy of the GNU General Public License
+// along with PISM; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+static char help[] =
+  "\nPISM_BENCH\n"
+  "  Times core PISM kernels on a synthetic ice sheet and reports throughput\n"
+  "  in JSON. Run with different numbers of MPI processes to get strong\n"
+  "  (default) or weak (-weak_scaling) scaling sweeps.\n\n";
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include "base/enthalpyConverter.hh"
+#include "base/energy/enthSystem.hh"
+#include "base/hydrology/PISMHydrology.hh"
+#include "base/stressbalance/PISMStressBalance.hh"
+#include "base/stressbalance/SSB_Modifier.hh"
+#include "base/stressbalance/ShallowStressBalance.hh"
+#include "base/stressbalance/sia/SIAFD.hh"
+#include "base/stressbalance/ssa/SSAFD.hh"
+#include "base/stressbalance/ssa/SSAFEM.hh"
+#include "base/stressbalance/ssa/SSATestCase.hh"
+#include "base/util/Context.hh"
+#include "base/util/IceGrid.hh"
+#include "base/util/Mask.hh"
+#include "base/util/PISMConfigInterface.hh"
+#include "base/util/PISMTime.hh"
+#include "base/util/PISMVars.hh"
+#include "base/util/error_handling.hh"
+#include "base/util/iceModelVec.hh"
+#include "base/util/io/PIO.hh"
+#include "base/util/io/io_helpers.hh"
+#include "base/util/petscwrappers/PetscInitializer.hh"
+#include "base/util/pism_const.hh"
+#include "base/util/pism_options.hh"
+#include "earth/PBLingleClark.hh"
+#include "verif/tests/exactTestsIJ.h"
+
+namespace pism {
+
+//! Timing of one kernel.
+struct BenchmarkResult {
+  BenchmarkResult(const std::string &name)
+    : kernel(name), repetitions(0), wall_time(0.0), columns(0.0), bytes(0.0) {
+    // empty
+  }
+
+  std::string kernel;
+  //! number of times the kernel was run
+  int repetitions;
+  //! total wall-clock time (maximum over all processes), in seconds
+  double wall_time;
+  //! number of grid columns processed per repetition (icy columns for
+  //! kernels that skip ice-free ones, all columns otherwise)
+  double columns;
+  //! number of bytes read or written per repetition (I/O kernels only)
+  double bytes;
+};
+
+//! Start timing: synchronize processes and return the current time.
+static double timer_start(MPI_Comm com) {
+  MPI_Barrier(com);
+  return GetTime();
+}
+
+//! Stop timing and return the elapsed time (maximum over all processes).
+static double timer_stop(MPI_Comm com, double start) {
+  return GlobalMax(com, GetTime() - start);
+}
+
+//! Fields describing the synthetic ice sheet used by most kernels.
+/*!
+ * A Vialov-profile dome on a flat bed with constant sub-freezing ice
+ * temperature, surrounded by ice-free land.
+ */
+class SyntheticIceSheet {
+public:
+  SyntheticIceSheet(IceGrid::Ptr grid, EnthalpyConverter::Ptr EC);
+
+  IceGrid::Ptr grid;
+  IceModelVec2S bed, surface, thickness, bmelt, cell_area;
+  IceModelVec2Int mask;
+  IceModelVec3 enthalpy;
+};
+
+SyntheticIceSheet::SyntheticIceSheet(IceGrid::Ptr g, EnthalpyConverter::Ptr EC)
+  : grid(g) {
+  const Config &config = *grid->ctx()->config();
+  const unsigned int WIDE_STENCIL = config.get_double("grid_max_stencil_width");
+
+  Vars &vars = grid->variables();
+
+  bed.create(grid, "topg", WITH_GHOSTS, WIDE_STENCIL);
+  bed.set_attrs("model_state", "bedrock surface elevation",
+                "m", "bedrock_altitude");
+  vars.add(bed);
+
+  surface.create(grid, "usurf", WITH_GHOSTS, WIDE_STENCIL);
+  surface.set_attrs("diagnostic", "ice upper surface elevation",
+                    "m", "surface_altitude");
+  vars.add(surface);
+
+  thickness.create(grid, "thk", WITH_GHOSTS, WIDE_STENCIL);
+  thickness.set_attrs("model_state", "land ice thickness",
+                      "m", "land_ice_thickness");
+  thickness.metadata().set_double("valid_min", 0.0);
+  vars.add(thickness);
+
+  bmelt.create(grid, "bmelt", WITHOUT_GHOSTS);
+  bmelt.set_attrs("model_state", "ice basal melt rate in ice thickness per time",
+                  "m s-1", "land_ice_basal_melt_rate");
+  vars.add(bmelt);
+
+  cell_area.create(grid, "cell_area", WITHOUT_GHOSTS);
+  cell_area.set_attrs("diagnostic", "cell areas", "m2", "");
+  vars.add(cell_area);
+
+  mask.create(grid, "mask", WITH_GHOSTS, WIDE_STENCIL);
+  mask.set_attrs("model_state", "grounded_dragging_floating integer mask",
+                 "", "");
+  vars.add(mask);
+
+  enthalpy.create(grid, "enthalpy", WITH_GHOSTS, WIDE_STENCIL);
+  enthalpy.set_attrs("model_state",
+                     "ice enthalpy (includes sensible heat, latent heat, pressure)",
+                     "J kg-1", "");
+  vars.add(enthalpy);
+
+  const double
+    H0 = 3000.0,                // dome thickness, in meters
+    R  = 0.75 * grid->Lx(),     // dome radius, in meters
+    T0 = 263.15,                // ice temperature, in Kelvin
+    melt_rate = units::convert(grid->ctx()->unit_system(), 1e-3, "m year-1", "m s-1");
+
+  bed.set(0.0);
+  cell_area.set(grid->dx() * grid->dy());
+
+  const unsigned int Mz = grid->Mz();
+  std::vector<double> E(Mz);
+
+  IceModelVec::AccessList list;
+  list.add(thickness);
+  list.add(mask);
+  list.add(bmelt);
+  list.add(enthalpy);
+
+  for (Points p(*grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    const double
+      x = grid->x(i) - grid->x0(),
+      y = grid->y(j) - grid->y0(),
+      r = sqrt(x * x + y * y);
+
+    double H = 0.0;
+    if (r < R) {
+      H = H0 * pow(1.0 - pow(r / R, 4.0 / 3.0), 3.0 / 8.0);
+    }
+
+    thickness(i, j) = H;
+    mask(i, j)      = H > 0.0 ? MASK_GROUNDED : MASK_ICE_FREE_BEDROCK;
+    bmelt(i, j)     = H > 0.0 ? melt_rate : 0.0;
+
+    for (unsigned int k = 0; k < Mz; ++k) {
+      const double depth = std::max(H - grid->z(k), 0.0);
+      E[k] = EC->enthalpy(T0, 0.0, EC->pressure(depth));
+    }
+    enthalpy.set_column(i, j, &E[0]);
+  }
+
+  thickness.update_ghosts();
+  mask.update_ghosts();
+  enthalpy.update_ghosts();
+
+  surface.copy_from(thickness);
+}
+
+//! Number of grid columns containing ice (over all processes).
+static double icy_columns(const SyntheticIceSheet &state) {
+  const IceGrid &grid = *state.grid;
+
+  IceModelVec::AccessList list(state.thickness);
+
+  double result = 0.0;
+  for (Points p(grid); p; p.next()) {
+    if (state.thickness(p.i(), p.j()) > 0.0) {
+      result += 1.0;
+    }
+  }
+
+  return GlobalSum(grid.com, result);
+}
+
+//! Time the SIA (including 3D velocities and strain heating).
+static BenchmarkResult bench_sia(stressbalance::StressBalance &stress_balance,
+                                 SyntheticIceSheet &state, int repetitions) {
+  IceGrid::ConstPtr grid = state.grid;
+
+  BenchmarkResult result("sia");
+
+  IceModelVec2S melange_back_pressure;
+  melange_back_pressure.create(grid, "melange_back_pressure", WITHOUT_GHOSTS);
+  melange_back_pressure.set_attrs("boundary_condition",
+                                  "melange back pressure fraction", "", "");
+  melange_back_pressure.set(0.0);
+
+  const double start = timer_start(grid->com);
+  for (int k = 0; k < repetitions; ++k) {
+    stress_balance.update(false, 0.0, melange_back_pressure);
+  }
+  result.wall_time   = timer_stop(grid->com, start);
+  result.repetitions = repetitions;
+  result.columns     = icy_columns(state);
+
+  return result;
+}
+
+//! Time enthalpy column solves, using velocities and strain heating from the SIA.
+static BenchmarkResult bench_enthalpy(stressbalance::StressBalance &stress_balance,
+                                      SyntheticIceSheet &state,
+                                      EnthalpyConverter::Ptr EC,
+                                      int repetitions) {
+  BenchmarkResult result("enthalpy");
+
+  const IceGrid &grid = *state.grid;
+  const Config &config = *grid.ctx()->config();
+
+  const IceModelVec3
+    &u3 = stress_balance.velocity_u(),
+    &v3 = stress_balance.velocity_v(),
+    &w3 = stress_balance.velocity_w(),
+    &strain_heating3 = stress_balance.volumetric_strain_heating();
+
+  const double
+    dt               = units::convert(grid.ctx()->unit_system(), 1.0, "year", "seconds"),
+    T_surface        = 253.15,
+    geothermal_flux  = 0.042;
+
+  const IceModelVec2S &H = state.thickness;
+
+  const double start = timer_start(grid.com);
+  for (int n = 0; n < repetitions; ++n) {
+    energy::enthSystemCtx system(grid.z(), "enth", grid.dx(), grid.dy(), dt,
+                                 config, state.enthalpy, u3, v3, w3, strain_heating3, EC);
+
+    std::vector<double> E_new(system.z().size());
+
+    IceModelVec::AccessList list;
+    list.add(H);
+    list.add(u3);
+    list.add(v3);
+    list.add(w3);
+    list.add(strain_heating3);
+    list.add(state.enthalpy);
+
+    ParallelSection loop(grid.com);
+    try {
+      for (Points p(grid); p; p.next()) {
+        const int i = p.i(), j = p.j();
+
+        system.initThisColumn(i, j, false, H(i, j));
+
+        if (system.ks() == 0) {
+          continue;
+        }
+
+        const double depth_ks = H(i, j) - system.ks() * system.dz();
+        system.setDirichletSurface(EC->enthalpy_permissive(T_surface, 0.0,
+                                                           EC->pressure(depth_ks)));
+        system.setBasalHeatFlux(geothermal_flux);
+        system.solveThisColumn(E_new);
+      }
+    } catch (...) {
+      loop.failed();
+    }
+    loop.check();
+  }
+  result.wall_time   = timer_stop(grid.com, start);
+  result.repetitions = repetitions;
+  result.columns     = icy_columns(state);
+
+  return result;
+}
+
+//! Time the routing subglacial hydrology model (one year, with adaptive substeps).
+static BenchmarkResult bench_hydrology(SyntheticIceSheet &state, int repetitions) {
+  BenchmarkResult result("hydrology");
+
+  IceGrid::ConstPtr grid = state.grid;
+
+  hydrology::Routing model(grid);
+  model.init();
+
+  const double
+    t0 = grid->ctx()->time()->start(),
+    dt = units::convert(grid->ctx()->unit_system(), 1.0, "year", "seconds");
+
+  const double start = timer_start(grid->com);
+  for (int k = 0; k < repetitions; ++k) {
+    model.update(t0 + k * dt, dt);
+  }
+  result.wall_time   = timer_stop(grid->com, start);
+  result.repetitions = repetitions;
+  result.columns     = icy_columns(state);
+
+  return result;
+}
+
+//! Time the Lingle-Clark bed deformation model (one step per repetition).
+static BenchmarkResult bench_bed_def_lc(SyntheticIceSheet &state, int repetitions) {
+  BenchmarkResult result("bed_def_lc");
+
+  const IceGrid &grid = *state.grid;
+
+  bed::PBLingleClark model(state.grid);
+  model.init();
+
+  const double
+    t0 = grid.ctx()->time()->start(),
+    dt = std::max(grid.ctx()->config()->get_double("bed_def_interval_years", "seconds"),
+                  units::convert(grid.ctx()->unit_system(), 1.0, "year", "seconds"));
+
+  const double start = timer_start(grid.com);
+  for (int k = 0; k < repetitions; ++k) {
+    model.update(state.thickness, t0 + k * dt, dt);
+  }
+  result.wall_time   = timer_stop(grid.com, start);
+  result.repetitions = repetitions;
+  result.columns     = icy_columns(state);
+
+  return result;
+}
+
+//! Time writing and reading a 3D field using a given I/O backend.
+/*!
+ * The "quilt" backend writes one patch per process; these patches are
+ * merged by pismmerge and are not read by PISM, so only writing is timed.
+ */
+static void bench_io(SyntheticIceSheet &state, const std::string &backend,
+                     int repetitions, std::vector<BenchmarkResult> &results) {
+  const IceGrid &grid = *state.grid;
+  const Config &config = *grid.ctx()->config();
+
+  const std::string filename = "pism_bench_" + backend + ".nc";
+  const double bytes = grid.Mx() * grid.My() * grid.Mz() * sizeof(double);
+  const bool quilt = backend.find("quilt") == 0;
+
+  BenchmarkResult write_result("write_" + backend), read_result("read_" + backend);
+
+  {
+    const double start = timer_start(grid.com);
+    for (int k = 0; k < repetitions; ++k) {
+      PIO file(grid.com, backend);
+      file.open(filename, PISM_READWRITE_MOVE);
+      io::define_time(file, config.get_string("time_dimension_name"),
+                      grid.ctx()->time()->calendar(),
+                      grid.ctx()->time()->CF_units_string(),
+                      grid.ctx()->unit_system());
+      io::append_time(file, config.get_string("time_dimension_name"), 0.0);
+      state.enthalpy.write(file);
+      file.close();
+    }
+    write_result.wall_time = timer_stop(grid.com, start);
+  }
+
+  if (not quilt) {
+    const double start = timer_start(grid.com);
+    for (int k = 0; k < repetitions; ++k) {
+      PIO file(grid.com, backend);
+      file.open(filename, PISM_READONLY);
+      state.enthalpy.read(file, 0);
+      file.close();
+    }
+    read_result.wall_time = timer_stop(grid.com, start);
+  }
+
+  if (quilt) {
+    // each process removes its own patch (see NC4_Quilt)
+    char suffix[TEMPORARY_STRING_LENGTH];
+    snprintf(suffix, TEMPORARY_STRING_LENGTH, "-rank%04d", grid.rank());
+    remove(pism_filename_add_suffix(filename, suffix, "").c_str());
+  } else if (grid.rank() == 0) {
+    remove(filename.c_str());
+  }
+
+  write_result.repetitions = read_result.repetitions = repetitions;
+  write_result.columns     = read_result.columns     = grid.Mx() * grid.My();
+  write_result.bytes       = read_result.bytes       = bytes;
+
+  results.push_back(write_result);
+  if (not quilt) {
+    results.push_back(read_result);
+  }
+}
+
+//! Time regridding a 3D field to a grid refined by a factor of two.
+static BenchmarkResult bench_regrid(Context::Ptr ctx, SyntheticIceSheet &state, int repetitions) {
+  BenchmarkResult result("regrid");
+
+  const IceGrid &grid = *state.grid;
+  const Config &config = *grid.ctx()->config();
+  const std::string filename = "pism_bench_regrid.nc";
+
+  {
+    PIO file(grid.com, "netcdf3");
+    file.open(filename, PISM_READWRITE_MOVE);
+    io::define_time(file, config.get_string("time_dimension_name"),
+                    grid.ctx()->time()->calendar(),
+                    grid.ctx()->time()->CF_units_string(),
+                    grid.ctx()->unit_system());
+    io::append_time(file, config.get_string("time_dimension_name"), 0.0);
+    state.enthalpy.write(file);
+    file.close();
+  }
+
+  GridParameters P(grid.ctx()->config());
+  P.Lx          = grid.Lx();
+  P.Ly          = grid.Ly();
+  P.x0          = grid.x0();
+  P.y0          = grid.y0();
+  P.Mx          = 2 * grid.Mx() - 1;
+  P.My          = 2 * grid.My() - 1;
+  P.periodicity = grid.periodicity();
+  P.z           = grid.z();
+  P.ownership_ranges_from_options(grid.size());
+
+  IceGrid::Ptr fine_grid(new IceGrid(ctx, P));
+
+  IceModelVec3 enthalpy;
+  enthalpy.create(fine_grid, "enthalpy", WITHOUT_GHOSTS);
+  enthalpy.set_attrs("model_state",
+                     "ice enthalpy (includes sensible heat, latent heat, pressure)",
+                     "J kg-1", "");
+
+  const double start = timer_start(grid.com);
+  for (int k = 0; k < repetitions; ++k) {
+    enthalpy.regrid(filename, CRITICAL);
+  }
+  result.wall_time   = timer_stop(grid.com, start);
+  result.repetitions = repetitions;
+  result.columns     = fine_grid->Mx() * fine_grid->My();
+  result.bytes       = grid.Mx() * grid.My() * grid.Mz() * sizeof(double);
+
+  if (grid.rank() == 0) {
+    remove(filename.c_str());
+  }
+
+  return result;
+}
+
+namespace stressbalance {
+
+//! An SSA test case (a floating ice shelf, as in verification test J) used for timing.
+class SSABenchmark : public SSATestCase {
+public:
+  SSABenchmark(Context::Ptr ctx)
+    : SSATestCase(ctx) {
+    // empty
+  }
+
+  IceGrid::ConstPtr grid() const {
+    return m_grid;
+  }
+protected:
+  virtual void initializeGrid(int Mx, int My);
+
+  virtual void initializeSSAModel();
+
+  virtual void initializeSSACoefficients();
+};
+
+void SSABenchmark::initializeGrid(int Mx, int My) {
+  double halfWidth = 300.0e3;  // 300.0 km half-width
+  m_grid = IceGrid::Shallow(m_ctx, halfWidth, halfWidth,
+                            0.0, 0.0, // center: (x0,y0)
+                            Mx, My, XY_PERIODIC);
+}
+
+void SSABenchmark::initializeSSAModel() {
+  m_config->set_boolean("do_pseudo_plastic_till", false);
+
+  m_enthalpyconverter = EnthalpyConverter::Ptr(new EnthalpyConverter(*m_config));
+  m_config->set_string("ssa_flow_law", "isothermal_glen");
+}
+
+void SSABenchmark::initializeSSACoefficients() {
+  m_tauc.set(0.0);
+  m_bed.set(0.0);
+  m_ice_mask.set(MASK_FLOATING);
+
+  m_enthalpy.set(m_enthalpyconverter->enthalpy(273.15, 0.01, 0.0));
+
+  double ocean_rho = m_config->get_double("sea_water_density"),
+    ice_rho = m_config->get_double("ice_density");
+  const double nu0 = units::convert(m_sys, 30.0, "MPa year", "Pa s");
+  const double H0 = 500.0;
+
+  m_ssa->strength_extension->set_notional_strength(nu0 * H0);
+  m_ssa->strength_extension->set_min_thickness(800);
+
+  IceModelVec::AccessList list;
+  list.add(m_thickness);
+  list.add(m_surface);
+  list.add(m_bc_mask);
+  list.add(m_bc_values);
+
+  for (Points p(*m_grid); p; p.next()) {
+    const int i = p.i(), j = p.j();
+
+    struct TestJParameters J = exactJ(m_grid->x(i), m_grid->y(j));
+
+    m_thickness(i, j) = J.H;
+    m_surface(i, j)   = (1.0 - ice_rho / ocean_rho) * J.H;
+
+    if ((i == ((int)m_grid->Mx()) / 2) and
+        (j == ((int)m_grid->My()) / 2)) {
+      m_bc_mask(i, j) = 1;
+      m_bc_values(i, j).u = J.u;
+      m_bc_values(i, j).v = J.v;
+    }
+  }
+
+  m_surface.update_ghosts();
+  m_thickness.update_ghosts();
+  m_bc_mask.update_ghosts();
+  m_bc_values.update_ghosts();
+
+  m_ssa->set_boundary_conditions(m_bc_mask, m_bc_values);
+}
+
+//! Time SSA solves (assembly and solve) using a given implementation.
+static BenchmarkResult bench_ssa(Context::Ptr ctx, const std::string &name,
+                                 SSAFactory factory,
+                                 int Mx, int My, int repetitions) {
+  BenchmarkResult result(name);
+
+  // SSABenchmark changes these parameters; restore them so that other
+  // kernels are not affected
+  Config::Ptr config = ctx->config();
+  const bool pseudo_plastic = config->get_boolean("do_pseudo_plastic_till");
+  const std::string flow_law = config->get_string("ssa_flow_law");
+
+  try {
+    SSABenchmark testcase(ctx);
+    testcase.init(Mx, My, factory);
+
+    const double start = timer_start(ctx->com());
+    for (int k = 0; k < repetitions; ++k) {
+      testcase.run();
+    }
+    result.wall_time   = timer_stop(ctx->com(), start);
+    result.repetitions = repetitions;
+    // the ice shelf covers the whole domain
+    result.columns     = testcase.grid()->Mx() * testcase.grid()->My();
+  } catch (...) {
+    config->set_boolean("do_pseudo_plastic_till", pseudo_plastic);
+    config->set_string("ssa_flow_law", flow_law);
+    throw;
+  }
+
+  config->set_boolean("do_pseudo_plastic_till", pseudo_plastic);
+  config->set_string("ssa_flow_law", flow_law);
+
+  return result;
+}
+
+} // end of namespace stressbalance
+
+//! Format benchmark results as a JSON object.
+static std::string to_json(const std::vector<BenchmarkResult> &results,
+                           int size, int Mx, int My, int Mz, bool weak_scaling) {
+  std::ostringstream json;
+
+  json.precision(8);
+
+  json << "{\n"
+       << "  \"processes\": " << size << ",\n"
+       << "  \"Mx\": " << Mx << ",\n"
+       << "  \"My\": " << My << ",\n"
+       << "  \"Mz\": " << Mz << ",\n"
+       << "  \"scaling\": \"" << (weak_scaling ? "weak" : "strong") << "\",\n"
+       << "  \"kernels\": [\n";
+
+  for (unsigned int k = 0; k < results.size(); ++k) {
+    const BenchmarkResult &r = results[k];
+    const double t = r.wall_time / std::max(r.repetitions, 1);
+
+    json << "    {\"name\": \"" << r.kernel << "\""
+         << ", \"repetitions\": " << r.repetitions
+         << ", \"seconds\": " << t
+         << ", \"columns_per_second\": " << (t > 0.0 ? r.columns / t : 0.0);
+
+    if (r.bytes > 0.0) {
+      json << ", \"GB_per_second\": " << (t > 0.0 ? r.bytes / t * 1e-9 : 0.0);
+    }
+
+    json << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+  }
+
+  json << "  ]\n"
+       << "}\n";
+
+  return json.str();
+}
+
+} // end of namespace pism
+
+int main(int argc, char *argv[]) {
+
+  using namespace pism;
+  using namespace pism::stressbalance;
+
+  MPI_Comm com = MPI_COMM_WORLD;
+  petsc::Initializer petsc(argc, argv, help);
+  PetscErrorCode ierr;
+
+  com = PETSC_COMM_WORLD;
+
+  /* This explicit scoping forces destructors to be called before PetscFinalize() */
+  try {
+    Context::Ptr ctx = context_from_options(com, "pism_bench");
+    Config::Ptr config = ctx->config();
+
+    config->set_boolean("compute_grain_size_using_age", false);
+
+    bool
+      usage_set = options::Bool("-usage", "print usage info"),
+      help_set  = options::Bool("-help", "print help info");
+    if (usage_set or help_set) {
+      ierr = PetscPrintf(com,
+                         "\n"
+                         "usage of PISM_BENCH:\n"
+                         "  run pism_bench -Mx <number> -My <number> -Mz <number>\n"
+                         "                 [-kernels sia,enthalpy,...] [-repeat N]\n"
+                         "                 [-io_formats netcdf3,quilt,...] [-weak_scaling] [-o foo.json]\n"
+                         "\n"
+                         "  With -weak_scaling the grid size is multiplied by sqrt(N)\n"
+                         "  in each direction, where N is the number of processes.\n"
+                         "\n");
+      PISM_CHK(ierr, "PetscPrintf");
+      return 0;
+    }
+
+    options::Integer Mx_option("-Mx", "Number of grid points in the X direction", 101);
+    options::Integer My_option("-My", "Number of grid points in the Y direction", 101);
+    options::Integer Mz("-Mz", "Number of vertical grid levels", 41);
+    options::Integer repetitions("-repeat", "Number of times to run each kernel", 3);
+    bool weak_scaling = options::Bool("-weak_scaling",
+                                      "Scale the grid size with the number of processes");
+    options::StringSet kernels("-kernels", "Kernels to time",
+                               "sia,enthalpy,ssafd,ssafem,hydrology,bed_def_lc,io,regrid");
+    options::StringList io_formats("-io_formats", "I/O backends to time",
+                                   "netcdf3,quilt,netcdf4_parallel,pnetcdf");
+    options::String output_file("-o", "Set the JSON output file name", "");
+    options::Integer verbose("-verbose", "Verbosity level", 1);
+    setVerbosityLevel(verbose);
+
+    int Mx = Mx_option, My = My_option;
+    if (weak_scaling) {
+      const double factor = sqrt((double)ctx->size());
+      Mx = (int)((Mx - 1) * factor) + 1;
+      My = (int)((My - 1) * factor) + 1;
+    }
+
+    GridParameters P(config);
+    P.Lx = 900e3;
+    P.Ly = P.Lx;
+    P.Mx = Mx;
+    P.My = My;
+    P.z = IceGrid::compute_vertical_levels(4000.0, Mz, EQUAL);
+    P.ownership_ranges_from_options(ctx->size());
+
+    IceGrid::Ptr grid(new IceGrid(ctx, P));
+
+    EnthalpyConverter::Ptr EC(new EnthalpyConverter(*config));
+
+    SyntheticIceSheet state(grid, EC);
+
+    std::vector<BenchmarkResult> results;
+
+    if (set_contains(kernels, "sia") or set_contains(kernels, "enthalpy")) {
+      SIAFD *sia = new SIAFD(grid, EC);
+      ZeroSliding *no_sliding = new ZeroSliding(grid, EC);
+      StressBalance stress_balance(grid, no_sliding, sia);
+      stress_balance.init();
+
+      // the SIA kernel provides velocities and strain heating for the enthalpy kernel
+      BenchmarkResult sia_result = bench_sia(stress_balance, state, repetitions);
+      if (set_contains(kernels, "sia")) {
+        results.push_back(sia_result);
+      }
+
+      if (set_contains(kernels, "enthalpy")) {
+        results.push_back(bench_enthalpy(stress_balance, state, EC, repetitions));
+      }
+    }
+
+    if (set_contains(kernels, "ssafd")) {
+      results.push_back(bench_ssa(ctx, "ssafd", SSAFDFactory, Mx, My, repetitions));
+    }
+
+    if (set_contains(kernels, "ssafem")) {
+      results.push_back(bench_ssa(ctx, "ssafem", SSAFEMFactory, Mx, My, repetitions));
+    }
+
+    if (set_contains(kernels, "hydrology")) {
+      results.push_back(bench_hydrology(state, repetitions));
+    }
+
+    if (set_contains(kernels, "bed_def_lc")) {
+      results.push_back(bench_bed_def_lc(state, repetitions));
+    }
+
+    if (set_contains(kernels, "io")) {
+      for (unsigned int k = 0; k < io_formats->size(); ++k) {
+        const std::string &backend = io_formats[k];
+        try {
+          bench_io(state, backend, repetitions, results);
+        } catch (RuntimeError &e) {
+          verbPrintf(1, com, "PISM_BENCH: skipping the '%s' I/O backend: %s\n",
+                     backend.c_str(), e.what());
+        }
+      }
+    }
+
+    if (set_contains(kernels, "regrid")) {
+      results.push_back(bench_regrid(ctx, state, repetitions));
+    }
+
+    const std::string json = to_json(results, ctx->size(), Mx, My, Mz, weak_scaling);
+
+    ierr = PetscPrintf(com, "%s", json.c_str());
+    PISM_CHK(ierr, "PetscPrintf");
+
+    if (output_file.is_set() and ctx->rank() == 0) {
+      FILE *f = fopen(output_file->c_str(), "w");
+      if (f == NULL) {
+        throw RuntimeError::formatted("failed to open '%s' for writing",
+                                      output_file->c_str());
+      }
+      fprintf(f, "%s", json.c_str());
+      fclose(f);
+    }
+  }
+  catch (...) {
+    handle_fatal_errors(com);
+  }
+
+  return 0;
+}
@@ -149,6 +149,123 @@ def toproczero_test():
         pass
 
 
+def local_array_test():
+    "Test shapes and offsets of PISM.vec.local_array views, with and without ghosts"
+    grid = create_dummy_grid()
+
+    xs, xm, ys, ym = grid.xs(), grid.xm(), grid.ys(), grid.ym()
+
+    for width in [0, 2]:
+        ghosts = PISM.WITH_GHOSTS if width > 0 else PISM.WITHOUT_GHOSTS
+
+        v = PISM.IceModelVec2S()
+        v.create(grid, "v", ghosts, width)
+
+        w = PISM.IceModelVec2V()
+        w.create(grid, "w", ghosts, width)
+
+        with PISM.vec.Access(nocomm=[v, w]):
+            for (i, j) in grid.points():
+                v[i, j] = i + 1000.0 * j
+                w[i, j] = [i, j]
+        if width > 0:
+            v.update_ghosts()
+            w.update_ghosts()
+
+        # values at all points of the local part, including ghosts
+        expected_v = {}
+        expected_w = {}
+        with PISM.vec.Access(nocomm=[v, w]):
+            for (i, j) in grid.points_with_ghosts(width):
+                expected_v[(i, j)] = v[i, j]
+                expected_w[(i, j)] = (w[i, j].u, w[i, j].v)
+
+        a = PISM.vec.local_array(v)
+        assert a.shape == (xm, ym)
+        for (i, j) in grid.points():
+            assert a[i - xs, j - ys] == i + 1000.0 * j
+
+        a = PISM.vec.local_array(v, ghosts=True)
+        assert a.shape == (xm + 2 * width, ym + 2 * width)
+        for (i, j) in grid.points_with_ghosts(width):
+            assert a[i - xs + width, j - ys + width] == expected_v[(i, j)]
+
+        b = PISM.vec.local_array(w)
+        assert b.shape == (xm, ym, 2)
+        for (i, j) in grid.points():
+            assert b[i - xs, j - ys, 0] == i
+            assert b[i - xs, j - ys, 1] == j
+
+        b = PISM.vec.local_array(w, ghosts=True)
+        assert b.shape == (xm + 2 * width, ym + 2 * width, 2)
+        for (i, j) in grid.points_with_ghosts(width):
+            assert tuple(b[i - xs + width, j - ys + width, :]) == expected_w[(i, j)]
+
+
+def local_array_write_test():
+    "Test that writes through PISM.vec.LocalArray are visible in the IceModelVec"
+    grid = create_dummy_grid()
+
+    xs, ys = grid.xs(), grid.ys()
+    Mx, My = grid.Mx(), grid.My()
+
+    for width in [0, 1]:
+        ghosts = PISM.WITH_GHOSTS if width > 0 else PISM.WITHOUT_GHOSTS
+
+        v = PISM.IceModelVec2S()
+        v.create(grid, "v", ghosts, width)
+        v.set(0.0)
+
+        counter = v.get_state_counter()
+
+        with PISM.vec.LocalArray(v) as a:
+            for (i, j) in grid.points():
+                a[i - xs, j - ys] = i + 1000.0 * j
+
+        assert v.get_state_counter() > counter
+
+        # ghosts are updated on exit; check them at points that are in the domain
+        with PISM.vec.Access(nocomm=v):
+            for (i, j) in grid.points_with_ghosts(width):
+                if 0 <= i < Mx and 0 <= j < My:
+                    assert v[i, j] == i + 1000.0 * j
+
+        counter = v.get_state_counter()
+
+        with PISM.vec.LocalArray(v, readonly=True) as a:
+            pass
+
+        assert v.get_state_counter() == counter
+
+
+def toproczero_round_trip_test():
+    "Test that ToProcZero.communicate followed by distribute reproduces the field"
+    grid = create_dummy_grid()
+
+    for (dof, vec) in [(1, PISM.vec.randVectorS(grid, 1.0)),
+                       (2, PISM.vec.randVectorV(grid, 1.0))]:
+        tz = PISM.vec.ToProcZero(grid, dof=dof)
+
+        array = tz.communicate(vec)
+        if grid.rank() == 0:
+            if dof == 1:
+                assert array.shape == (grid.Mx(), grid.My())
+            else:
+                assert array.shape == (2, grid.Mx(), grid.My())
+
+        if dof == 1:
+            result = PISM.IceModelVec2S()
+        else:
+            result = PISM.IceModelVec2V()
+        result.create(grid, "result", PISM.WITHOUT_GHOSTS)
+        result.set(0.0)
+
+        tz.distribute(array, result)
+
+        result.add(-1.0, vec)
+        assert result.norm(PISM.PETSc.NormType.NORM_INFINITY) == 0.0
+
+
 def create_modeldata_test():
     "Test creating the ModelData class"
     grid = create_dummy_grid()
@@ -749,6 +866,85 @@ def ssa_trivial_test():
     test_case = TrivialSSARun(Mx, My)
     test_case.run("ssa_trivial.nc")
 
+def ssafem_hardness_update_test():
+    """Test that SSAFEM re-computes ice hardness after enthalpy is
+    changed using IceModelVec::update_ghosts(destination)."""
+
+    context = PISM.Context()
+    config = context.config
+    EC = context.enthalpy_converter
+
+    L = 50.e3  # 50km half-width
+    H0 = 500.0  # m
+    dhdx = 0.005  # pure number, slope of the surface and the bed
+    tauc0 = 1.e4  # 10 kPa
+
+    ssa_method = config.get_string("ssa_method")
+    config.set_string("ssa_method", "fem")
+
+    class SlabRun(PISM.ssa.SSAExactTestCase):
+        def _initGrid(self):
+            self.grid = PISM.IceGrid.Shallow(context.ctx, L, L, 0, 0,
+                                             self.Mx, self.My, PISM.NONE)
+
+        def _initPhysics(self):
+            self.modeldata.setPhysics(EC)
+
+        def _initSSACoefficients(self):
+            self._allocStdSSACoefficients()
+            self._allocateBCs()
+
+            grid = self.grid
+            vecs = self.modeldata.vecs
+
+            vecs.land_ice_thickness.set(H0)
+            vecs.tauc.set(tauc0)
+            vecs.mask.set(PISM.MASK_GROUNDED)
+            vecs.enthalpy.set(EC.enthalpy(243.15, 0.0, 0.0))
+            vecs.vel_bc.set(0.0)
+
+            # a slab on a slope with zero velocity at domain boundaries
+            with PISM.vec.Access(comm=[vecs.surface_altitude, vecs.bedrock_altitude,
+                                       vecs.bc_mask]):
+                for (i, j) in grid.points():
+                    x = grid.x(i)
+                    vecs.bedrock_altitude[i, j] = dhdx * (L - x)
+                    vecs.surface_altitude[i, j] = dhdx * (L - x) + H0
+                    edge = (i == 0 or j == 0 or
+                            i == grid.Mx() - 1 or j == grid.My() - 1)
+                    vecs.bc_mask[i, j] = 1 if edge else 0
+
+        def exactSolution(self, i, j, x, y):
+            return [0, 0]
+
+    try:
+        run = SlabRun(11, 11)
+        run.setup()
+
+        norm = PISM.PETSc.NormType.NORM_INFINITY
+
+        v_cold = max(run.solve().norm_all(norm))
+
+        # Warm the ice up the way IceModel updates enthalpy: compute the
+        # new field in a ghost-less work vector and copy it using
+        # update_ghosts(destination).
+        enthalpy = run.modeldata.vecs.enthalpy
+        counter = enthalpy.get_state_counter()
+
+        new_enthalpy = PISM.model.createEnthalpyVec(run.grid, name="new_enthalpy",
+                                                    ghost_type=PISM.WITHOUT_GHOSTS)
+        new_enthalpy.set(EC.enthalpy(268.15, 0.0, 0.0))
+        new_enthalpy.update_ghosts(enthalpy)
+
+        assert enthalpy.get_state_counter() > counter
+
+        v_warm = max(run.solve().norm_all(norm))
+
+        # warmer ice is softer, so the SSA solution has to change
+        assert v_warm > 1.1 * v_cold
+    finally:
+        config.set_string("ssa_method", ssa_method)
+
 def po_constant_test():
     """Test that the basal melt rate computed by ocean::Constant is the
     same regardless of whether it is set using
@@ -0,0 +1,26 @@
+#!/bin/bash
+# Compares the multiple-right-hand-side versions of apply_linearization()
+# and apply_linearization_transpose() to single solves.
+# Requires PISM's Python bindings.
+PYTHONEXEC=$5
+PISM_BUILD_DIR=$1
+
+# make sure that Python imports the right modules
+export PYTHONPATH=${PISM_BUILD_DIR}/site-packages:$PYTHONPATH
+
+set -x
+set -e
+
+# Create input files
+$PYTHONEXEC build_tiny.py -Mx 9 -My 9
+
+$PYTHONEXEC make_synth_ssa.py -i tiny.nc -o inv_data.nc \
+              -pseudo_plastic -pseudo_plastic_q 0.25 -regional \
+              -ssa_dirichlet_bc -generate_ssa_observed -ssa_method fem \
+              -design_prior_const 70000 -inv_ssa tauc
+
+# Compare block and single solves (exits with a non-zero status on failure)
+$PYTHONEXEC test_invssaforward.py \
+              -i tiny.nc -inv_data inv_data.nc -inv_ssa tauc \
+              -pseudo_plastic -pseudo_plastic_q 0.25 -regional -ssa_dirichlet_bc \
+              -inv_test lin_block
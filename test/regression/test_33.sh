@@ -0,0 +1,33 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #33: subcycled mass continuity with all cells in the rate class 0 matches the explicit step."
+# The list of files to delete when done:
+files="foo-33.nc bar-33.nc baz-33.nc"
+
+rm -f $files
+
+set -e -x
+
+# Create an ice sheet to start from:
+$PISM_PATH/pisms -eisII A -Mx 31 -My 31 -Mz 31 -y 1000 -o foo-33.nc -o_size big
+
+# The time step is limited by -max_dt, so that it is the same in both runs
+# and all cells are in the rate class 0.
+OPTS="-i foo-33.nc -stress_balance ssa+sia -yield_stress constant -tauc 5e4 -y 2 -max_dt 0.1 -o_size small"
+
+$MPIEXEC -n 2 $PISM_PATH/pismr $OPTS -o bar-33.nc
+$MPIEXEC -n 2 $PISM_PATH/pismr $OPTS -mass_continuity_subcycling_levels 3 -o baz-33.nc
+
+set +e
+
+# Compare:
+$PISM_PATH/nccmp.py -t 1e-9 -v thk,usurf bar-33.nc baz-33.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
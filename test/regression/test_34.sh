@@ -0,0 +1,35 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #34: restarting from a binary checkpoint is equivalent to restarting from NetCDF."
+# The list of files to delete when done:
+files="foo-34.nc bar-34.nc baz-34.nc qux-34.nc bar-34_backup.manifest bar-34_backup-state.nc bar-34_backup-*.bin"
+
+rm -f $files
+
+set -e -x
+
+# Create an ice sheet to start from:
+$PISM_PATH/pisms -eisII A -Mx 31 -My 31 -Mz 31 -y 1000 -o foo-34.nc
+
+# Write a binary checkpoint after every step, so that the last one
+# corresponds to the final state saved in bar-34.nc:
+$MPIEXEC -n 2 $PISM_PATH/pismr -i foo-34.nc -y 10 -backup_format binary -backup_interval 0 -o bar-34.nc
+
+# Restart from the checkpoint and from the output file (using a
+# different domain decomposition):
+$MPIEXEC -n 3 $PISM_PATH/pismr -checkpoint bar-34_backup -y 10 -o baz-34.nc
+$MPIEXEC -n 3 $PISM_PATH/pismr -i bar-34.nc -y 10 -o qux-34.nc
+
+set +e
+
+# Compare:
+$PISM_PATH/nccmp.py -t 1e-9 -v thk,enthalpy,tillwat baz-34.nc qux-34.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
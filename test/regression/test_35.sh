@@ -0,0 +1,37 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #35: ensemble members sharing Lingle-Clark coefficients match a single run."
+# The list of files to delete when done:
+files="foo-35.nc bar-35.nc baz-35_member000.nc baz-35_member001.nc"
+
+rm -f $files
+
+set -e -x
+
+# Create an ice sheet to start from:
+$PISM_PATH/pisms -eisII A -Mx 21 -My 21 -Mz 11 -y 1000 -o foo-35.nc
+
+OPTS="-i foo-35.nc -bed_def lc -bed_def_lc_elastic_model -y 100"
+
+$PISM_PATH/pismr $OPTS -o bar-35.nc
+
+# Both members compute the elastic load response matrix together and
+# share one copy:
+$MPIEXEC -n 2 $PISM_PATH/pism_ensemble -ensemble_size 2 $OPTS -o baz-35.nc
+
+set +e
+
+# Compare:
+for member in baz-35_member000.nc baz-35_member001.nc;
+do
+    $PISM_PATH/nccmp.py -v thk,topg bar-35.nc $member
+    if [ $? != 0 ];
+    then
+        exit 1
+    fi
+done
+
+rm -f $files; exit 0
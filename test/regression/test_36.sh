@@ -0,0 +1,39 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #36: part-grid residual redistribution conserves mass across sub-domain boundaries."
+# The list of files to delete when done:
+files="foo-36.nc bar-36.nc baz-36.nc"
+
+rm -f $files
+
+set -e -x
+
+# Create an ice sheet to start from:
+$PISM_PATH/pisms -eisII A -Mx 61 -My 61 -Mz 11 -y 100 -o foo-36.nc -o_size big
+
+# Make all the ice float and prescribe a radial outward velocity, so
+# that the calving front advances through partially filled cells. With
+# prescribed velocities the results do not depend on the number of
+# processes, so any mass lost at sub-domain boundaries shows up as a
+# difference.
+ncap2 -O -s 'topg=topg*0.0-2000.0; ubar[$y,$x]=0.0; vbar[$y,$x]=0.0; ubar=ubar+1000.0*x/sqrt(x*x+y*y+1.0); vbar=vbar+1000.0*y/sqrt(x*x+y*y+1.0)' foo-36.nc foo-36.nc
+ncatted -O -a units,ubar,o,c,"m year-1" -a units,vbar,o,c,"m year-1" foo-36.nc
+
+OPTS="-i foo-36.nc -stress_balance prescribed_sliding -prescribed_sliding_file foo-36.nc -part_grid -part_redist -energy none -y 100 -o_size small"
+
+$MPIEXEC -n 1 $PISM_PATH/pismr $OPTS -o bar-36.nc
+$MPIEXEC -n 4 $PISM_PATH/pismr $OPTS -o baz-36.nc
+
+set +e
+
+# Compare:
+$PISM_PATH/nccmp.py -t 1e-9 -v thk,Href bar-36.nc baz-36.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #37: subcycled mass continuity with several rate classes conserves mass."
+# The list of files to delete when done:
+files="foo-37.nc bar-37.nc baz-37.nc ts_bar-37.nc ts_baz-37.nc baz-37.log"
+
+rm -f $files
+
+set -e -x
+
+# Create an ice sheet to start from:
+$PISM_PATH/pisms -eisII A -Mx 31 -My 31 -Mz 11 -y 1000 -o foo-37.nc -o_size big
+
+# The SSA is the only stress balance and the energy balance is off, so the
+# time step is limited by the 2D CFL condition and fast-flowing cells end
+# up in higher rate classes.
+OPTS="-i foo-37.nc -stress_balance ssa -yield_stress constant -tauc 2e4 -energy none -ys 0 -y 20 -o_size small -ts_times 0:1:20 -ts_vars ivol"
+
+$MPIEXEC -n 2 $PISM_PATH/pismr $OPTS -o bar-37.nc -ts_file ts_bar-37.nc
+$MPIEXEC -n 2 $PISM_PATH/pismr $OPTS -mass_continuity_subcycling_levels 3 -o baz-37.nc -ts_file ts_baz-37.nc > baz-37.log
+
+# Make sure that at least two rate classes were in use:
+grep "rate classes:.*2x:" baz-37.log
+
+set +e
+
+# Compare the ice volume (relative tolerance):
+$PISM_PATH/nccmp.py -r -t 1e-3 -v ivol ts_bar-37.nc ts_baz-37.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0
@@ -0,0 +1,30 @@
+#!/bin/bash
+
+PISM_PATH=$1
+MPIEXEC=$2
+
+echo "Test #38: the streaming SIA (-sia_streaming) matches the SIA that stores delta and I."
+# The list of files to delete when done:
+files="foo-38.nc bar-38.nc"
+
+rm -f $files
+
+set -e -x
+
+# Run the same short SIA case with and without streaming. Use two
+# processes, so that strips of columns cross sub-domain boundaries.
+OPTS="-eisII A -Mx 31 -My 31 -Mz 31 -y 100 -o_size big"
+
+$MPIEXEC -n 2 $PISM_PATH/pisms $OPTS -o foo-38.nc
+$MPIEXEC -n 2 $PISM_PATH/pisms $OPTS -sia_streaming -o bar-38.nc
+
+set +e
+
+# Compare:
+$PISM_PATH/nccmp.py -r -t 1e-12 -v uvel,vvel,diffusivity foo-38.nc bar-38.nc
+if [ $? != 0 ];
+then
+    exit 1
+fi
+
+rm -f $files; exit 0